@@ -0,0 +1,33 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 19 Oct 2026
+    Author:  Vincenzo
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+
+#include "../shared/game/game_benchmark.h"
+#include "layout_parser_benchmark.h"
+
+//==============================================================================
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::StringArray args;
+    for (int i = 1; i < argc; i++)
+        args.add(juce::String::fromUTF8(argv[i]));
+
+    // LumatoneSandboxBenchmark [--layouts] [output.json]
+    if (args[0] == LumatoneLayoutParserBenchmark::commandLineFlag)
+    {
+        args.remove(0);
+        return LumatoneLayoutParserBenchmark::runFromCommandLine(args);
+    }
+
+    return LumatoneSandboxGameBenchmark::runFromCommandLine(args);
+}
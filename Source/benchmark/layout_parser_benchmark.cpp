@@ -0,0 +1,270 @@
+/*
+  ==============================================================================
+
+    layout_parser_benchmark.cpp
+    Created: 19 Oct 2026
+    Author:  Vincenzo
+
+  ==============================================================================
+*/
+
+#include "layout_parser_benchmark.h"
+
+#include "../shared/lumatone_editor_library/data/lumatone_layout.h"
+#include "../shared/lumatone_editor_library/data/lumatone_layout_parser.h"
+
+#include <iostream>
+
+static double ticksToMs(juce::int64 ticks)
+{
+    return juce::Time::highResolutionTicksToSeconds(ticks) * 1000.0;
+}
+
+juce::var LumatoneLayoutParserBenchmark::Result::toVar() const
+{
+    juce::DynamicObject::Ptr object = new juce::DynamicObject();
+    object->setProperty("parser", parser);
+    object->setProperty("scenario", scenario);
+    object->setProperty("numLayouts", numLayouts);
+    object->setProperty("parseMs", parseMs.toVar());
+    object->setProperty("megabytesPerSecond", megabytesPerSecond);
+    object->setProperty("numErrors", numErrors < 0 ? juce::var() : juce::var(numErrors));
+    return juce::var(object.get());
+}
+
+//==============================================================================
+
+LumatoneLayoutParserBenchmark::LumatoneLayoutParserBenchmark(Options optionsIn)
+    : options(optionsIn)
+    , random(optionsIn.randomSeed)
+{
+}
+
+juce::Array<LumatoneLayoutParserBenchmark::Result> LumatoneLayoutParserBenchmark::runAll()
+{
+    generateCorpus();
+    checkParsersAgree();
+
+    juce::Array<Result> results;
+    results.add(runParser(false));
+    results.add(runStringArray(false));
+    results.add(runParser(true));
+    results.add(runStringArray(true));
+    return results;
+}
+
+void LumatoneLayoutParserBenchmark::generateCorpus()
+{
+    corpus.clearQuick();
+    corpus.ensureStorageAllocated(options.numLayouts);
+
+    for (int i = 0; i < options.numLayouts; i++)
+    {
+        Sample sample;
+        sample.malformed = random.nextDouble() < options.malformedLayoutFraction;
+
+        auto lines = juce::StringArray::fromLines(generateLayoutText());
+        if (sample.malformed)
+        {
+            for (auto& line : lines)
+            {
+                if (random.nextDouble() < options.malformedLineFraction)
+                    line = corruptLine(line);
+            }
+        }
+
+        sample.text = lines.joinIntoString("\n");
+        sample.lines = lines;
+        corpus.add(sample);
+    }
+}
+
+juce::String LumatoneLayoutParserBenchmark::generateLayoutText()
+{
+    LumatoneLayout layout;
+
+    for (int boardIndex = 0; boardIndex < layout.getNumBoards(); boardIndex++)
+    {
+        for (int keyIndex = 0; keyIndex < layout.getOctaveBoardSize(); keyIndex++)
+        {
+            auto key = layout.getKey(boardIndex, keyIndex);
+            key->keyType = (LumatoneKeyType)(random.nextInt(4) + 1);
+            key->channelNumber = random.nextInt(16) + 1;
+            key->noteNumber = random.nextInt(128);
+            key->colour = juce::Colour((juce::uint8)random.nextInt(256), (juce::uint8)random.nextInt(256), (juce::uint8)random.nextInt(256));
+            key->ccFaderDefault = random.nextBool();
+        }
+    }
+
+    return layout.toStringArray().joinIntoString("\n");
+}
+
+juce::String LumatoneLayoutParserBenchmark::corruptLine(const juce::String& line)
+{
+    switch (random.nextInt(5))
+    {
+    case 0:
+        // Missing separator
+        return line.replaceCharacter('=', ':');
+
+    case 1:
+        // Key index past the end of the board
+        if (line.containsChar('_') && line.containsChar('='))
+            return line.upToFirstOccurrenceOf("_", true, false) + "99" + line.fromFirstOccurrenceOf("=", true, false);
+        return line + "]";
+
+    case 2:
+        // Value that isn't a number
+        return line.upToFirstOccurrenceOf("=", true, false) + "zz";
+
+    case 3:
+        // Truncated
+        return line.substring(0, line.length() / 2);
+
+    default:
+        return "#%$" + line;
+    }
+}
+
+LumatoneLayoutParserBenchmark::Result LumatoneLayoutParserBenchmark::runParser(bool malformed)
+{
+    Result result;
+    result.parser = "LumatoneLayoutParser::parse";
+    result.scenario = malformed ? "malformed" : "valid";
+    result.numErrors = 0;
+
+    LumatoneLayout layout;
+    LumatoneLayoutParser parser(layout);
+
+    juce::Array<double> parseMs;
+    parseMs.ensureStorageAllocated(corpus.size());
+
+    juce::int64 numBytes = 0;
+    juce::int64 totalTicks = 0;
+
+    for (const auto& sample : corpus)
+    {
+        if (sample.malformed != malformed)
+            continue;
+
+        const char* text = sample.text.toRawUTF8();
+        const size_t textSize = sample.text.getNumBytesAsUTF8();
+
+        const auto start = juce::Time::getHighResolutionTicks();
+        parser.parse(text, textSize);
+        const auto end = juce::Time::getHighResolutionTicks();
+
+        parseMs.add(ticksToMs(end - start));
+        totalTicks += end - start;
+        numBytes += (juce::int64)textSize;
+        result.numErrors += parser.getNumErrors();
+    }
+
+    result.numLayouts = parseMs.size();
+    result.parseMs = Percentiles::fromSamples(parseMs);
+
+    const double seconds = juce::Time::highResolutionTicksToSeconds(totalTicks);
+    result.megabytesPerSecond = seconds > 0 ? numBytes / seconds / 1.0e6 : 0;
+
+    return result;
+}
+
+LumatoneLayoutParserBenchmark::Result LumatoneLayoutParserBenchmark::runStringArray(bool malformed)
+{
+    Result result;
+    result.parser = "LumatoneLayout::fromStringArray";
+    result.scenario = malformed ? "malformed" : "valid";
+
+    LumatoneLayout layout;
+
+    juce::Array<double> parseMs;
+    parseMs.ensureStorageAllocated(corpus.size());
+
+    juce::int64 numBytes = 0;
+    juce::int64 totalTicks = 0;
+
+    for (const auto& sample : corpus)
+    {
+        if (sample.malformed != malformed)
+            continue;
+
+        const auto start = juce::Time::getHighResolutionTicks();
+        layout.fromStringArray(sample.lines);
+        const auto end = juce::Time::getHighResolutionTicks();
+
+        parseMs.add(ticksToMs(end - start));
+        totalTicks += end - start;
+        numBytes += (juce::int64)sample.text.getNumBytesAsUTF8();
+    }
+
+    result.numLayouts = parseMs.size();
+    result.parseMs = Percentiles::fromSamples(parseMs);
+
+    const double seconds = juce::Time::highResolutionTicksToSeconds(totalTicks);
+    result.megabytesPerSecond = seconds > 0 ? numBytes / seconds / 1.0e6 : 0;
+
+    return result;
+}
+
+void LumatoneLayoutParserBenchmark::checkParsersAgree()
+{
+    numMismatches = 0;
+
+    for (const auto& sample : corpus)
+    {
+        LumatoneLayout parsed;
+        LumatoneLayoutParser parser(parsed);
+        const bool parsedCleanly = parser.parse(sample.text.toRawUTF8(), sample.text.getNumBytesAsUTF8());
+
+        LumatoneLayout fromLines;
+        fromLines.fromStringArray(sample.lines);
+
+        if ((!sample.malformed && !parsedCleanly) || parsed.toStringArray() != fromLines.toStringArray())
+            numMismatches++;
+    }
+}
+
+juce::String LumatoneLayoutParserBenchmark::toJson(const juce::Array<Result>& results, const Options& options)
+{
+    juce::Array<juce::var> resultVars;
+    for (const auto& result : results)
+        resultVars.add(result.toVar());
+
+    juce::DynamicObject::Ptr object = new juce::DynamicObject();
+    object->setProperty("date", juce::Time::getCurrentTime().toISO8601(true));
+   #if JUCE_DEBUG
+    object->setProperty("build", "Debug");
+   #else
+    object->setProperty("build", "Release");
+   #endif
+    object->setProperty("numLayouts", options.numLayouts);
+    object->setProperty("malformedLayoutFraction", options.malformedLayoutFraction);
+    object->setProperty("malformedLineFraction", options.malformedLineFraction);
+    object->setProperty("results", resultVars);
+
+    return juce::JSON::toString(juce::var(object.get()));
+}
+
+int LumatoneLayoutParserBenchmark::runFromCommandLine(const juce::StringArray& args)
+{
+    Options options;
+    juce::String json;
+    int exitCode = 0;
+    {
+        LumatoneLayoutParserBenchmark benchmark(options);
+        auto results = benchmark.runAll();
+
+        if (benchmark.getNumMismatches() > 0)
+        {
+            std::cerr << benchmark.getNumMismatches() << " layouts didn't parse the same way with both parsers" << std::endl;
+            exitCode = 1;
+        }
+
+        json = toJson(results, options);
+    }
+
+    if (!LumatoneSandboxGameBenchmark::writeResults(json, args[0]))
+        exitCode = 1;
+
+    return exitCode;
+}
@@ -0,0 +1,112 @@
+/*
+  ==============================================================================
+
+    layout_parser_benchmark.h
+    Created: 19 Oct 2026
+    Author:  Vincenzo
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../shared/game/game_benchmark.h"
+
+class LumatoneLayout;
+
+/*
+==============================================================================
+Measures .ltn parsing over a corpus of generated layouts.
+
+Each layout is parsed from its text by LumatoneLayoutParser::parse() and from
+its lines by LumatoneLayout::fromStringArray(). Splitting the text into lines
+isn't timed, as loaders that use fromStringArray() already have the lines.
+
+Some layouts have a share of their lines corrupted, so the error paths are
+timed too. Valid layouts must parse without errors and both parsers must give
+the same layout, otherwise the benchmark fails.
+
+Results use the same JSON shape as LumatoneSandboxGameBenchmark.
+==============================================================================
+*/
+class LumatoneLayoutParserBenchmark
+{
+public:
+
+    struct Options
+    {
+        Options() {}
+
+        int numLayouts = 2000;
+
+        // Share of layouts with corrupted lines, and of lines corrupted in them
+        double malformedLayoutFraction = 0.25;
+        double malformedLineFraction = 0.05;
+
+        juce::int64 randomSeed = 0x4c756d61;
+    };
+
+    using Percentiles = LumatoneSandboxGameBenchmark::Percentiles;
+
+    struct Result
+    {
+        juce::String parser;
+        juce::String scenario;
+        int numLayouts = 0;
+
+        Percentiles parseMs;
+        double megabytesPerSecond = 0;
+
+        // Errors reported by the parser, -1 where the parser doesn't report them
+        int numErrors = -1;
+
+        juce::var toVar() const;
+    };
+
+    static constexpr const char* commandLineFlag = "--layouts";
+
+public:
+
+    LumatoneLayoutParserBenchmark(Options options=Options());
+
+    // Both parsers on the valid and malformed layouts
+    juce::Array<Result> runAll();
+
+    // Layouts the two parsers disagreed on, and valid layouts that reported errors
+    int getNumMismatches() const { return numMismatches; }
+
+    static juce::String toJson(const juce::Array<Result>& results, const Options& options);
+
+    // Runs everything and writes the JSON to the path in the first argument, or to stdout.
+    // Returns 1 if a valid layout didn't parse cleanly or the results couldn't be written.
+    static int runFromCommandLine(const juce::StringArray& args);
+
+private:
+
+    struct Sample
+    {
+        juce::String text;
+        juce::StringArray lines;
+        bool malformed = false;
+    };
+
+    void generateCorpus();
+    juce::String generateLayoutText();
+    juce::String corruptLine(const juce::String& line);
+
+    Result runParser(bool malformed);
+    Result runStringArray(bool malformed);
+
+    // Compares the two parsers' layouts for the valid samples
+    void checkParsersAgree();
+
+private:
+
+    Options options;
+    juce::Random random;
+
+    juce::Array<Sample> corpus;
+    int numMismatches = 0;
+
+    JUCE_DECLARE_NON_COPYABLE(LumatoneLayoutParserBenchmark)
+};
@@ -10,6 +10,8 @@
 #include "../shared/MainComponent.h"
 
 #include "../shared/debug/LumatoneSandboxDebugWindow.h"
+#include "../shared/lumatone_editor_library/lumatone_midi_driver/lumatone_midi_driver.h"
+#include "../shared/lumatone_editor_library/device_hub.h"
 
 //==============================================================================
 LumatoneSandboxProcessorEditor::LumatoneSandboxProcessorEditor (LumatoneSandboxProcessor& p)
@@ -22,7 +24,7 @@ LumatoneSandboxProcessorEditor::LumatoneSandboxProcessorEditor (LumatoneSandboxP
 {
     juce::ignoreUnused (processor);
 
-    debugWindow = std::make_unique<LumatoneSandboxDebugWindow>(processor.getLogData());
+    debugWindow = std::make_unique<LumatoneSandboxDebugWindow>(processor.getLogData(), &processor.getFirmwareDriver()->getConnectionMetrics());
     debugWindow->setSize(800, 500);
     debugWindow->addToDesktop();
     debugWindow->setVisible(true);
@@ -52,10 +54,16 @@ LumatoneSandboxProcessorEditor::LumatoneSandboxProcessorEditor (LumatoneSandboxP
     setSize (1024, 768);
 
     setResizable(true, true);
+
+    // The instance being edited shows its layout on the device
+    processor.getDeviceSession()->requestDeviceOwnership();
+    addMouseListener(this, true);
 }
 
 LumatoneSandboxProcessorEditor::~LumatoneSandboxProcessorEditor()
 {
+    removeMouseListener(this);
+
     fileChooser = nullptr;
     constrainer = nullptr;
 
@@ -77,6 +85,11 @@ void LumatoneSandboxProcessorEditor::paint (juce::Graphics& g)
     g.drawFittedText ("Hello World!", getLocalBounds(), juce::Justification::centred, 1);
 }
 
+void LumatoneSandboxProcessorEditor::mouseDown(const juce::MouseEvent& e)
+{
+    processor.getDeviceSession()->requestDeviceOwnership();
+}
+
 void LumatoneSandboxProcessorEditor::resized()
 {
     int menuHeight = 24;
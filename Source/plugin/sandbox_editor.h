@@ -22,6 +22,9 @@ public:
 
     bool showMenu() const;
 
+    // Clicking anywhere in the editor gives this instance the device
+    void mouseDown(const juce::MouseEvent& e) override;
+
     //==============================================================================
 
     juce::ApplicationCommandTarget* getNextCommandTarget() override;
@@ -4,7 +4,9 @@
 #include "../shared/game/game_engine.h"
 #include "../shared/lumatone_editor_library/lumatone_midi_driver/lumatone_midi_driver.h"
 #include "../shared/lumatone_editor_library/palettes/palette_library.h"
+#include "../shared/lumatone_editor_library/data/layout_library.h"
 #include "../shared/lumatone_editor_library/DeviceActivityMonitor.h"
+#include "../shared/lumatone_editor_library/device_hub.h"
 #include "../shared/lumatone_editor_library/LumatoneController.h"
 #include "../shared/SandboxMenu.h"
 
@@ -24,25 +26,40 @@ LumatoneSandboxProcessor::LumatoneSandboxProcessor()
     treeState = juce::ValueTree(LumatoneStateProperty::StateTree);
     appState = std::make_unique<LumatoneApplicationState>("LumatoneSandboxProcessor", treeState);
 
+    logBackend = std::make_unique<LumatoneSandboxLogBackend>();
+    LumatoneSandboxLogBackend::setCurrentBackend(logBackend.get());
+
     logData = std::make_unique<LumatoneSandboxLogTableModel>();
+    logBackend->addSink(logData.get());
     juce::Logger::setCurrentLogger(logData.get());
 
+    logFile = std::make_unique<LumatoneSandboxFileLogSink>(juce::FileLogger::getSystemLogFileFolder()
+                                                            .getChildFile("Lumatone Editor").getChildFile("LumatoneSandbox.log"));
+    logBackend->addSink(logFile.get());
+
     undoManager = std::make_unique<juce::UndoManager>();
 
     paletteLibrary = std::make_unique<LumatonePaletteLibrary>();
 
+    // Falls back to the documents folder when there's no mappings folder, which shouldn't be scanned
+    auto mappingsDirectory = appState->getDefaultMappingsDirectory();
+    if (mappingsDirectory != juce::File::getSpecialLocation(juce::File::SpecialLocationType::userDocumentsDirectory))
+    {
+        // Ignored if another instance already added it
+        getLayoutLibrary()->addDirectory(mappingsDirectory);
+        getLayoutLibrary()->startWatching();
+    }
+
     isStandalone = (juce::PluginHostType::getPluginLoadedAs() == AudioProcessor::wrapperType_Standalone);
     // isStandalone = false;
 
-    midiDriver = std::make_unique<LumatoneFirmwareDriver>(isStandalone
-               ? LumatoneFirmwareDriver::HostMode::Driver
-               : LumatoneFirmwareDriver::HostMode::Plugin);
-
-    controller = std::make_unique<LumatoneController>(*appState, *midiDriver, undoManager.get());
+    // The driver and device monitor are shared by all instances in the process
+    deviceSession = std::make_unique<LumatoneDeviceSession>(isStandalone
+                  ? LumatoneFirmwareDriver::HostMode::Driver
+                  : LumatoneFirmwareDriver::HostMode::Plugin);
 
-    monitor = std::make_unique<DeviceActivityMonitor>(midiDriver.get(), (LumatoneApplicationState)*controller.get()); 
-    monitor->addStatusListener(controller.get());
-    monitor->startDeviceDetection();
+    controller = std::make_unique<LumatoneController>(*appState, *deviceSession->getFirmwareDriver(), undoManager.get());
+    deviceSession->setController(controller.get());
 
     commandManager = std::make_unique<juce::ApplicationCommandManager>();
     commandManager->registerAllCommandsForTarget(this);
@@ -53,20 +70,39 @@ LumatoneSandboxProcessor::LumatoneSandboxProcessor()
 LumatoneSandboxProcessor::~LumatoneSandboxProcessor()
 {
     gameEngine = nullptr;
-    monitor = nullptr;
-    
+
+    deviceSession->setController(nullptr);
     controller = nullptr;
-    midiDriver = nullptr;
+    deviceSession = nullptr;
 
     paletteLibrary = nullptr;
 
     commandManager = nullptr;
     undoManager = nullptr;
 
-    juce::Logger::setCurrentLogger(nullptr);
+    // Other instances may have registered their own since
+    if (juce::Logger::getCurrentLogger() == logData.get())
+        juce::Logger::setCurrentLogger(nullptr);
+
+    // Stops being the current backend if it still is, and hands the remaining records to the sinks
+    logBackend = nullptr;
+
+    logFile = nullptr;
     logData = nullptr;
 }
 
+LumatoneSandboxProcessor::SharedLayoutLibrary::SharedLayoutLibrary()
+{
+    auto cacheFile = juce::File::getSpecialLocation(juce::File::SpecialLocationType::userApplicationDataDirectory)
+                        .getChildFile("Lumatone Editor").getChildFile("LayoutLibrary.cache");
+    library = std::make_unique<LumatoneLayoutLibrary>(cacheFile);
+}
+
+LumatoneSandboxProcessor::SharedLayoutLibrary::~SharedLayoutLibrary()
+{
+    library = nullptr;
+}
+
 //==============================================================================
 const juce::String LumatoneSandboxProcessor::getName() const
 {
@@ -180,15 +216,18 @@ void LumatoneSandboxProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear (i, 0, buffer.getNumSamples());
 
-    if (!isStandalone)
-    {
-        for (auto msg : midiMessages)
-        {
-            midiDriver->handleIncomingMidiMessage(nullptr, msg.getMessage());
-        }
-    }
+    deviceSession->processBlock(midiMessages, buffer.getNumSamples(), getSampleRate());
+}
+
+//==============================================================================
+LumatoneFirmwareDriver* LumatoneSandboxProcessor::getFirmwareDriver()
+{
+    return deviceSession->getFirmwareDriver();
+}
 
-    midiDriver->readNextBuffer(midiMessages);
+DeviceActivityMonitor* LumatoneSandboxProcessor::getDeviceMonitor()
+{
+    return deviceSession->getDeviceMonitor();
 }
 
 //==============================================================================
@@ -5,11 +5,15 @@
 class LumatoneApplicationState;
 class LumatoneFirmwareDriver;
 class DeviceActivityMonitor;
+class LumatoneDeviceSession;
 class LumatoneController;
 class LumatonePaletteLibrary;
+class LumatoneLayoutLibrary;
 class LumatoneSandboxGameEngine;
 
+class LumatoneSandboxLogBackend;
 class LumatoneSandboxLogTableModel;
+class LumatoneSandboxFileLogSink;
 
 //==============================================================================
 class LumatoneSandboxProcessor  : public juce::AudioProcessor
@@ -60,9 +64,15 @@ public:
     juce::ApplicationCommandManager*    getCommandManager() { return commandManager.get(); }
 
     LumatonePaletteLibrary*         getPaletteLibrary() { return paletteLibrary.get(); }
+    // Shared with the other instances in this process
+    LumatoneLayoutLibrary*          getLayoutLibrary() { return layoutLibrary->library.get(); }
     
+    LumatoneFirmwareDriver*         getFirmwareDriver();
     LumatoneController*             getLumatoneController() { return controller.get(); }
-    DeviceActivityMonitor*          getDeviceMonitor() { return monitor.get(); }
+    DeviceActivityMonitor*          getDeviceMonitor();
+
+    // Shared with the other instances in this process
+    LumatoneDeviceSession*          getDeviceSession() { return deviceSession.get(); }
 
     LumatoneSandboxGameEngine*      getGameEngine() { return gameEngine.get(); }
 
@@ -83,7 +93,9 @@ private:
 
     bool isStandalone = false;
 
+    std::unique_ptr<LumatoneSandboxLogBackend> logBackend;
     std::unique_ptr<LumatoneSandboxLogTableModel> logData;
+    std::unique_ptr<LumatoneSandboxFileLogSink> logFile;
     
     std::unique_ptr<juce::UndoManager> undoManager;
     std::unique_ptr<juce::ApplicationCommandManager> commandManager;
@@ -93,9 +105,19 @@ private:
 
     std::unique_ptr<LumatonePaletteLibrary> paletteLibrary;
 
-    std::unique_ptr<LumatoneFirmwareDriver> midiDriver;
+    // One library per process, so instances don't race on its cache file
+    struct SharedLayoutLibrary
+    {
+        SharedLayoutLibrary();
+        ~SharedLayoutLibrary();
+
+        std::unique_ptr<LumatoneLayoutLibrary> library;
+    };
+
+    juce::SharedResourcePointer<SharedLayoutLibrary> layoutLibrary;
+
+    std::unique_ptr<LumatoneDeviceSession> deviceSession;
     std::unique_ptr<LumatoneController> controller;
-    std::unique_ptr<DeviceActivityMonitor> monitor;
 
     std::unique_ptr<LumatoneSandboxGameEngine> gameEngine;
 };
@@ -88,6 +88,7 @@ void MainComponent::getAllCommands(juce::Array <juce::CommandID>& commands)
 {
     commands.add(LumatoneSandbox::Menu::commandIDs::setRenderModeKeys);
     commands.add(LumatoneSandbox::Menu::commandIDs::setRenderModeMaxRes);
+    commands.add(LumatoneSandbox::Menu::commandIDs::setRenderBatched);
 }
 
 void MainComponent::getCommandInfo(juce::CommandID commandID, juce::ApplicationCommandInfo& result)
@@ -106,6 +107,11 @@ void MainComponent::getCommandInfo(juce::CommandID commandID, juce::ApplicationC
             result.setTicked(lumatoneComponent->getRenderMode() == LumatoneComponentRenderMode::MaxRes);
             break;
 
+        case LumatoneSandbox::Menu::commandIDs::setRenderBatched:
+            result.setInfo("Draw keys together", "Draw all keys in one pass instead of as individual components", "View", 0);
+            result.setTicked(lumatoneComponent->isBatchedRendering());
+            break;
+
         default:
             break;
         }
@@ -128,6 +134,11 @@ bool MainComponent::perform(const juce::ApplicationCommandTarget::InvocationInfo
         lumatoneComponent->setRenderMode(LumatoneComponentRenderMode::MaxRes);
         return true;
     }
+    case LumatoneSandbox::Menu::commandIDs::setRenderBatched:
+    {
+        lumatoneComponent->setBatchedRendering(!lumatoneComponent->isBatchedRendering());
+        return true;
+    }
     }
 }
 
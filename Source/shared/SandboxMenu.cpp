@@ -64,6 +64,8 @@ void LumatoneSandbox::Menu::Model::createViewMenu(juce::PopupMenu& menu)
     juce::PopupMenu renderMenu;
     renderMenu.addCommandItem(theManager, setRenderModeKeys);
     renderMenu.addCommandItem(theManager, setRenderModeMaxRes);
+    renderMenu.addSeparator();
+    renderMenu.addCommandItem(theManager, setRenderBatched);
     menu.addSubMenu("Render Mode", renderMenu, true);
 }
 
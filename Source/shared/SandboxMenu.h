@@ -32,6 +32,7 @@ namespace LumatoneSandbox {
 
 			setRenderModeKeys = 0x200120,
 			setRenderModeMaxRes = 0x200121,
+			setRenderBatched = 0x200122,
 
 			undo = 0x200200,
 			redo = 0x200201,
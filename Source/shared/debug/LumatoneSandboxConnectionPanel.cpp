@@ -0,0 +1,117 @@
+#include "LumatoneSandboxConnectionPanel.h"
+
+LumatoneSandboxConnectionPanel::LumatoneSandboxConnectionPanel(LumatoneConnectionMetrics* metricsIn)
+    : metrics(metricsIn)
+{
+    jassert(metrics != nullptr);
+    current = metrics->getSnapshot();
+    metrics->addListener(this);
+}
+
+LumatoneSandboxConnectionPanel::~LumatoneSandboxConnectionPanel()
+{
+    metrics->removeListener(this);
+}
+
+void LumatoneSandboxConnectionPanel::connectionMetricsUpdated(const LumatoneConnectionMetrics::Snapshot& snapshot)
+{
+    current = snapshot;
+
+    latencyP99History[historyWritePos] = snapshot.latencyP99Ms;
+    busyRateHistory[historyWritePos] = snapshot.busyRate;
+    historyWritePos = (historyWritePos + 1) % historySize;
+    historyLength = juce::jmin(historyLength + 1, historySize);
+
+    repaint();
+}
+
+void LumatoneSandboxConnectionPanel::paint(juce::Graphics& g)
+{
+    g.fillAll(juce::Colours::darkslategrey.darker());
+
+    auto area = getLocalBounds().reduced(8);
+
+    const int rowHeight = 18;
+    g.setFont(juce::Font(juce::Font::getDefaultMonospacedFontName(), 13.0f, juce::Font::plain));
+
+    auto drawRow = [&](const juce::String& name, const juce::String& value)
+    {
+        auto row = area.removeFromTop(rowHeight);
+        g.setColour(juce::Colours::lightgrey);
+        g.drawText(name, row.removeFromLeft(180), juce::Justification::centredLeft);
+        g.setColour(juce::Colours::white);
+        g.drawText(value, row, juce::Justification::centredLeft);
+    };
+
+    auto ms = [](float value) { return juce::String(value, 2) + " ms"; };
+
+    drawRow("Window",               juce::String(current.windowMs / 1000.0f, 1) + " s");
+    drawRow("Ack latency",          current.numLatencySamples == 0
+                                        ? juce::String("-")
+                                        : "min " + ms(current.latencyMinMs)
+                                          + "  p50 " + ms(current.latencyP50Ms)
+                                          + "  p99 " + ms(current.latencyP99Ms)
+                                          + "  max " + ms(current.latencyMaxMs));
+    drawRow("Answers",              juce::String(current.numAnswers));
+    drawRow("Busy",                 juce::String(current.numBusy) + " (" + juce::String(current.busyRate * 100.0f, 1) + "%)");
+    drawRow("Retries",              juce::String(current.numRetries));
+    drawRow("Timeouts",             juce::String(current.numTimeouts));
+    drawRow("Sent",                 juce::String(current.messagesSentPerSecond, 1) + " msg/s  "
+                                        + juce::String(current.bytesSentPerSecond, 0) + " B/s");
+    drawRow("Received",             juce::String(current.messagesReceivedPerSecond, 1) + " msg/s  "
+                                        + juce::String(current.bytesReceivedPerSecond, 0) + " B/s");
+    drawRow("Queue wait",           "mean " + ms(current.queueWaitMeanMs) + "  max " + ms(current.queueWaitMaxMs));
+    drawRow("Queue size",           juce::String(current.queueSize) + " (max " + juce::String(current.maxQueueSize) + ")");
+
+    area.removeFromTop(rowHeight / 2);
+    drawHistory(g, area);
+}
+
+void LumatoneSandboxConnectionPanel::drawHistory(juce::Graphics& g, juce::Rectangle<int> area) const
+{
+    if (area.getHeight() < 32)
+        return;
+
+    g.setColour(juce::Colours::black.withAlpha(0.3f));
+    g.fillRect(area);
+
+    if (historyLength < 2)
+        return;
+
+    float maxLatency = 1.0f;
+    for (int i = 0; i < historyLength; i++)
+        maxLatency = juce::jmax(maxLatency, latencyP99History[i]);
+
+    const auto bounds = area.toFloat().reduced(2.0f);
+    const float xStep = bounds.getWidth() / (historySize - 1);
+
+    auto makePath = [&](const float* history, float maxValue)
+    {
+        juce::Path path;
+        const int firstPos = (historyWritePos - historyLength + historySize) % historySize;
+
+        for (int i = 0; i < historyLength; i++)
+        {
+            const float value = history[(firstPos + i) % historySize] / maxValue;
+            const juce::Point<float> point(bounds.getX() + (historySize - historyLength + i) * xStep,
+                                           bounds.getBottom() - juce::jlimit(0.0f, 1.0f, value) * bounds.getHeight());
+            if (i == 0)
+                path.startNewSubPath(point);
+            else
+                path.lineTo(point);
+        }
+
+        return path;
+    };
+
+    g.setColour(juce::Colours::orange);
+    g.strokePath(makePath(busyRateHistory, 1.0f), juce::PathStrokeType(1.5f));
+
+    g.setColour(juce::Colours::lightskyblue);
+    g.strokePath(makePath(latencyP99History, maxLatency), juce::PathStrokeType(1.5f));
+
+    g.setFont(12.0f);
+    g.drawText("p99 latency, max " + juce::String(maxLatency, 1) + " ms", area.reduced(6, 4), juce::Justification::topLeft);
+    g.setColour(juce::Colours::orange);
+    g.drawText("busy rate", area.reduced(6, 4), juce::Justification::topRight);
+}
@@ -0,0 +1,38 @@
+#ifndef LUMATONE_SANDBOX_CONNECTION_PANEL_H
+#define LUMATONE_SANDBOX_CONNECTION_PANEL_H
+
+#include "../lumatone_editor_library/lumatone_midi_driver/connection_metrics.h"
+
+// Live view of LumatoneConnectionMetrics, with a short history of ack latency and busy rate
+class LumatoneSandboxConnectionPanel : public juce::Component, private LumatoneConnectionMetrics::Listener
+{
+public:
+
+    LumatoneSandboxConnectionPanel(LumatoneConnectionMetrics* metricsIn);
+    ~LumatoneSandboxConnectionPanel() override;
+
+    void paint(juce::Graphics& g) override;
+
+private:
+
+    void connectionMetricsUpdated(const LumatoneConnectionMetrics::Snapshot& snapshot) override;
+
+    void drawHistory(juce::Graphics& g, juce::Rectangle<int> area) const;
+
+private:
+
+    static constexpr int historySize = 120;
+
+    LumatoneConnectionMetrics* metrics;
+    LumatoneConnectionMetrics::Snapshot current;
+
+    // Ring of the last historySize updates
+    float latencyP99History[historySize] = {};
+    float busyRateHistory[historySize] = {};
+    int historyWritePos = 0;
+    int historyLength = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LumatoneSandboxConnectionPanel)
+};
+
+#endif // LUMATONE_SANDBOX_CONNECTION_PANEL_H
@@ -1,8 +1,9 @@
 #include "LumatoneSandboxDebugWindow.h"
 
 #include "LumatoneSandboxLogTableModel.h"
+#include "LumatoneSandboxConnectionPanel.h"
 
-LumatoneSandboxDebugWindow::LumatoneSandboxDebugWindow(LumatoneSandboxLogTableModel *logTableModelIn)
+LumatoneSandboxDebugWindow::LumatoneSandboxDebugWindow(LumatoneSandboxLogTableModel *logTableModelIn, LumatoneConnectionMetrics* connectionMetricsIn)
     : juce::DocumentWindow("LumatoneSandboxDebugWindow", 
                            juce::Colours::darkslategrey, 
                            juce::DocumentWindow::TitleBarButtons::minimiseButton,
@@ -11,7 +12,7 @@ LumatoneSandboxDebugWindow::LumatoneSandboxDebugWindow(LumatoneSandboxLogTableMo
 
     logModel = logTableModelIn;
 
-    auto logTable = new juce::TableListBox("LumatoneSandboxLogTable", static_cast<juce::TableListBoxModel*>(logModel));
+    logTable = new juce::TableListBox("LumatoneSandboxLogTable", static_cast<juce::TableListBoxModel*>(logModel));
     logTable->setHeader(std::make_unique<juce::TableHeaderComponent>());
     logTable->getHeader().addColumn("Date",     LumatoneSandboxLogTableColumn::Date,    160);
     logTable->getHeader().addColumn("Class",    LumatoneSandboxLogTableColumn::Class,   128);
@@ -21,14 +22,26 @@ LumatoneSandboxDebugWindow::LumatoneSandboxDebugWindow(LumatoneSandboxLogTableMo
 
     logModel->addChangeListener(this);
 
-    logTable->setSize(1024, 1024);
-    setContentOwned(logTable, true);
+    if (connectionMetricsIn == nullptr)
+    {
+        logTable->setSize(1024, 1024);
+        setContentOwned(logTable, true);
+        return;
+    }
+
+    auto tabs = new juce::TabbedComponent(juce::TabbedButtonBar::TabsAtTop);
+    tabs->addTab("Log", juce::Colours::darkslategrey, logTable, true);
+    tabs->addTab("Connection", juce::Colours::darkslategrey, new LumatoneSandboxConnectionPanel(connectionMetricsIn), true);
+
+    tabs->setSize(1024, 1024);
+    setContentOwned(tabs, true);
 }
 
 void LumatoneSandboxDebugWindow::changeListenerCallback(juce::ChangeBroadcaster* source)
 {
     if (source == logModel)
     {
-        getContentComponent()->resized();
+        logTable->updateContent();
+        logTable->repaint();
     }
 }
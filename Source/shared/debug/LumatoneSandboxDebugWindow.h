@@ -4,12 +4,13 @@
 #include <JuceHeader.h>
 
 class LumatoneSandboxLogTableModel;
+class LumatoneConnectionMetrics;
 
 class LumatoneSandboxDebugWindow : public juce::DocumentWindow, private juce::ChangeListener
 {
 public:
 
-    LumatoneSandboxDebugWindow(LumatoneSandboxLogTableModel* logTableModelIn);
+    LumatoneSandboxDebugWindow(LumatoneSandboxLogTableModel* logTableModelIn, LumatoneConnectionMetrics* connectionMetricsIn=nullptr);
     ~LumatoneSandboxDebugWindow() override {}
 
 private:
@@ -19,7 +20,7 @@ private:
 private:
 
     LumatoneSandboxLogTableModel* logModel;
-    // std::unique_ptr<juce::TableListBox> logTable;
+    juce::TableListBox* logTable = nullptr;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LumatoneSandboxDebugWindow)
 };
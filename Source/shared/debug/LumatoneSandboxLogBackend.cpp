@@ -0,0 +1,310 @@
+#include "LumatoneSandboxLogBackend.h"
+
+namespace
+{
+    struct NameTable
+    {
+        static constexpr int numLiteralSlots = 2048;
+
+        NameTable()
+        {
+            for (auto& key : literalKeys)
+                key.store(nullptr);
+        }
+
+        juce::CriticalSection lock;
+
+        // Only appended to, so names below numNames can be read without the lock. 0 is the empty name.
+        juce::String names[LumatoneSandboxLogNames::maxNames];
+        std::atomic<int> numNames { 1 };
+        juce::HashMap<juce::String, int> ids;
+
+        // Open addressing by pointer, keys are published after their id
+        std::atomic<const char*> literalKeys[numLiteralSlots];
+        juce::uint16 literalIds[numLiteralSlots] = {};
+    };
+
+    NameTable& getNameTable()
+    {
+        static NameTable table;
+        return table;
+    }
+
+    std::atomic<LumatoneSandboxLogBackend*> currentBackend { nullptr };
+
+    // Threads in pushToCurrentBackend, counted before the backend is loaded
+    std::atomic<int> numPushingToCurrentBackend { 0 };
+}
+
+//==============================================================================
+
+void LumatoneSandboxLogRecord::setMessage(const juce::String& text)
+{
+    const auto numBytes = text.copyToUTF8(message, (size_t)maxMessageBytes);
+    messageSize = (juce::uint16)(juce::jmax((size_t)1, numBytes) - 1);
+}
+
+juce::Time LumatoneSandboxLogRecord::getTime() const
+{
+    // Paired with the wall clock once, so recording only needs to read the tick counter
+    static const juce::int64 referenceTicks = juce::Time::getHighResolutionTicks();
+    static const juce::int64 referenceMs = juce::Time::currentTimeMillis();
+    static const double msPerTick = 1000.0 / (double)juce::Time::getHighResolutionTicksPerSecond();
+
+    return juce::Time(referenceMs + (juce::int64)((double)(ticks - referenceTicks) * msPerTick));
+}
+
+const juce::String& LumatoneSandboxLogRecord::getClassName() const
+{
+    return LumatoneSandboxLogNames::getName(classId);
+}
+
+const juce::String& LumatoneSandboxLogRecord::getMethod() const
+{
+    return LumatoneSandboxLogNames::getName(methodId);
+}
+
+LumatoneSandboxLog LumatoneSandboxLogRecord::toLog() const
+{
+    LumatoneSandboxLog log =
+    {
+        getTime(),
+        getClassName(),
+        getStatus(),
+        getMethod(),
+        getMessage()
+    };
+
+    return log;
+}
+
+//==============================================================================
+
+juce::uint16 LumatoneSandboxLogNames::intern(const juce::String& name)
+{
+    if (name.isEmpty())
+        return 0;
+
+    auto& table = getNameTable();
+    const juce::ScopedLock l(table.lock);
+
+    if (table.ids.contains(name))
+        return (juce::uint16)table.ids[name];
+
+    const int id = table.numNames.load(std::memory_order_relaxed);
+    if (id == maxNames)
+    {
+        jassertfalse;
+        return 0;
+    }
+
+    table.names[id] = name;
+    table.ids.set(name, id);
+    table.numNames.store(id + 1, std::memory_order_release);
+
+    return (juce::uint16)id;
+}
+
+juce::uint16 LumatoneSandboxLogNames::internLiteral(const char* name)
+{
+    if (name == nullptr)
+        return 0;
+
+    auto& table = getNameTable();
+    const size_t slotMask = NameTable::numLiteralSlots - 1;
+    const size_t firstSlot = (size_t)(((juce::pointer_sized_uint)name >> 3) * 2654435761u) & slotMask;
+
+    for (size_t i = 0; i < NameTable::numLiteralSlots; i++)
+    {
+        const size_t slot = (firstSlot + i) & slotMask;
+        const char* key = table.literalKeys[slot].load(std::memory_order_acquire);
+
+        if (key == name)
+            return table.literalIds[slot];
+
+        if (key == nullptr)
+        {
+            const juce::ScopedLock l(table.lock);
+
+            // Another thread may have taken the slot while we waited
+            key = table.literalKeys[slot].load(std::memory_order_relaxed);
+            if (key == name)
+                return table.literalIds[slot];
+
+            if (key == nullptr)
+            {
+                table.literalIds[slot] = intern(juce::String(juce::CharPointer_UTF8(name)));
+                table.literalKeys[slot].store(name, std::memory_order_release);
+                return table.literalIds[slot];
+            }
+        }
+    }
+
+    return intern(juce::String(juce::CharPointer_UTF8(name)));
+}
+
+const juce::String& LumatoneSandboxLogNames::getName(juce::uint16 id)
+{
+    auto& table = getNameTable();
+    if (id < table.numNames.load(std::memory_order_acquire))
+        return table.names[id];
+
+    return table.names[0];
+}
+
+//==============================================================================
+
+LumatoneSandboxLogQueue::LumatoneSandboxLogQueue(int capacity)
+{
+    const int size = juce::nextPowerOfTwo(juce::jmax(2, capacity));
+    cells = std::make_unique<Cell[]>((size_t)size);
+    mask = (size_t)size - 1;
+
+    for (int i = 0; i < size; i++)
+        cells[(size_t)i].sequence.store((size_t)i, std::memory_order_relaxed);
+}
+
+bool LumatoneSandboxLogQueue::pop(LumatoneSandboxLogRecord& record)
+{
+    auto& cell = cells[dequeuePos & mask];
+    if (cell.sequence.load(std::memory_order_acquire) != dequeuePos + 1)
+        return false;
+
+    record = cell.record;
+    cell.sequence.store(dequeuePos + mask + 1, std::memory_order_release);
+    dequeuePos++;
+
+    return true;
+}
+
+//==============================================================================
+
+LumatoneSandboxLogBackend::LumatoneSandboxLogBackend(int queueCapacity, int pollIntervalMsIn)
+    : juce::Thread("LumatoneSandboxLogBackend")
+    , queue(queueCapacity)
+    , pollIntervalMs(pollIntervalMsIn)
+{
+    startThread();
+}
+
+LumatoneSandboxLogBackend::~LumatoneSandboxLogBackend()
+{
+    LumatoneSandboxLogBackend* self = this;
+    currentBackend.compare_exchange_strong(self, nullptr);
+
+    // Also needed if another backend replaced this one, a push may have loaded it before then
+    while (numPushingToCurrentBackend.load() > 0)
+        juce::Thread::yield();
+
+    stopThread(1000);
+
+    while (drain() > 0) {}
+}
+
+bool LumatoneSandboxLogBackend::push(LumatoneSandboxLogStatus status, juce::uint16 classId, juce::uint16 methodId, const juce::String& message)
+{
+    return queue.push([&](LumatoneSandboxLogRecord& record)
+    {
+        record.ticks = juce::Time::getHighResolutionTicks();
+        record.classId = classId;
+        record.methodId = methodId;
+        record.status = (juce::int8)status;
+        record.setMessage(message);
+    });
+}
+
+void LumatoneSandboxLogBackend::addSink(LumatoneSandboxLogSink* sink)
+{
+    const juce::ScopedLock l(sinkLock);
+    sinks.addIfNotAlreadyThere(sink);
+}
+
+void LumatoneSandboxLogBackend::removeSink(LumatoneSandboxLogSink* sink)
+{
+    const juce::ScopedLock l(sinkLock);
+    sinks.removeFirstMatchingValue(sink);
+}
+
+void LumatoneSandboxLogBackend::setCurrentBackend(LumatoneSandboxLogBackend* backend)
+{
+    currentBackend.store(backend);
+}
+
+LumatoneSandboxLogBackend* LumatoneSandboxLogBackend::getCurrentBackend()
+{
+    return currentBackend.load();
+}
+
+bool LumatoneSandboxLogBackend::pushToCurrentBackend(LumatoneSandboxLogStatus status, juce::uint16 classId, juce::uint16 methodId, const juce::String& message)
+{
+    numPushingToCurrentBackend++;
+
+    bool pushed = false;
+    if (auto backend = currentBackend.load())
+    {
+        backend->push(status, classId, methodId, message);
+        pushed = true;
+    }
+
+    numPushingToCurrentBackend--;
+    return pushed;
+}
+
+void LumatoneSandboxLogBackend::run()
+{
+    while (!threadShouldExit())
+    {
+        // Keep going while there's a backlog, otherwise poll so producers never have to signal
+        if (drain() < batchSize)
+            wait(pollIntervalMs);
+    }
+}
+
+int LumatoneSandboxLogBackend::drain()
+{
+    int numRecords = 0;
+    while (numRecords < batchSize && queue.pop(batch[numRecords]))
+        numRecords++;
+
+    if (numRecords == 0)
+        return 0;
+
+    {
+        const juce::ScopedLock l(sinkLock);
+        for (auto sink : sinks)
+            sink->writeLogRecords(batch, numRecords);
+    }
+
+#if JUCE_DEBUG
+    for (int i = 0; i < numRecords; i++)
+        juce::Logger::outputDebugString(batch[i].toLog().toShortString());
+#endif
+
+    return numRecords;
+}
+
+//==============================================================================
+
+LumatoneSandboxFileLogSink::LumatoneSandboxFileLogSink(const juce::File& file, juce::int64 maxSizeBytes)
+{
+    if (file.getSize() > maxSizeBytes)
+        file.deleteFile();
+
+    file.getParentDirectory().createDirectory();
+
+    // Opens at the end of an existing file
+    stream = std::make_unique<juce::FileOutputStream>(file);
+    if (stream->failedToOpen())
+        stream = nullptr;
+}
+
+void LumatoneSandboxFileLogSink::writeLogRecords(const LumatoneSandboxLogRecord* records, int numRecords)
+{
+    if (stream == nullptr)
+        return;
+
+    for (int i = 0; i < numRecords; i++)
+        *stream << records[i].toLog().toFullString() << juce::newLine;
+
+    stream->flush();
+}
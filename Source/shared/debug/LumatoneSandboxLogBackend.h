@@ -0,0 +1,189 @@
+#ifndef LUMATONE_SANDBOX_LOG_BACKEND_H
+#define LUMATONE_SANDBOX_LOG_BACKEND_H
+
+#include "./LumatoneSandboxLogger.h"
+
+// Binary log entry, formatted only when it's displayed or written to a file
+struct LumatoneSandboxLogRecord
+{
+    static constexpr int maxMessageBytes = 240;
+
+    juce::int64 ticks = 0;          // juce::Time::getHighResolutionTicks()
+    juce::uint16 classId = 0;       // LumatoneSandboxLogNames ids
+    juce::uint16 methodId = 0;
+    juce::int8 status = (juce::int8)LumatoneSandboxLogStatus::INFO;
+    juce::uint8 reserved = 0;
+    juce::uint16 messageSize = 0;
+
+    // UTF-8, longer messages are truncated
+    char message[maxMessageBytes] = {};
+
+    void setMessage(const juce::String& text);
+
+    juce::Time getTime() const;
+    LumatoneSandboxLogStatus getStatus() const { return (LumatoneSandboxLogStatus)status; }
+    juce::String getMessage() const { return juce::String::fromUTF8(message, messageSize); }
+
+    const juce::String& getClassName() const;
+    const juce::String& getMethod() const;
+
+    LumatoneSandboxLog toLog() const;
+};
+
+// Process-wide table of class and method names used in log records
+struct LumatoneSandboxLogNames
+{
+    static constexpr int maxNames = 4096;
+
+    // Slow path, takes a lock
+    static juce::uint16 intern(const juce::String& name);
+
+    // Lock-free after the first call with a given pointer, for string literals
+    static juce::uint16 internLiteral(const char* name);
+
+    static const juce::String& getName(juce::uint16 id);
+};
+
+/*
+==============================================================================
+Bounded lock-free queue of log records, any number of producers and one
+consumer. Records are filled in place, so pushing never allocates. When the
+queue is full the record is dropped and counted rather than blocking.
+==============================================================================
+*/
+class LumatoneSandboxLogQueue
+{
+public:
+    // Capacity is rounded up to a power of two
+    LumatoneSandboxLogQueue(int capacity);
+
+    template <typename FillFunction>
+    bool push(FillFunction&& fill)
+    {
+        size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            auto& cell = cells[pos & mask];
+            const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto diff = (juce::pointer_sized_int)sequence - (juce::pointer_sized_int)pos;
+
+            if (diff == 0)
+            {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    fill(cell.record);
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                numDropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            else
+            {
+                pos = enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Consumer thread only
+    bool pop(LumatoneSandboxLogRecord& record);
+
+    int getNumDropped() const { return numDropped.load(std::memory_order_relaxed); }
+
+private:
+    struct Cell
+    {
+        std::atomic<size_t> sequence { 0 };
+        LumatoneSandboxLogRecord record;
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    size_t mask = 0;
+
+    std::atomic<size_t> enqueuePos { 0 };
+    size_t dequeuePos = 0;
+
+    std::atomic<int> numDropped { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE(LumatoneSandboxLogQueue)
+};
+
+// Receives batches of records from the LumatoneSandboxLogBackend thread
+class LumatoneSandboxLogSink
+{
+public:
+    virtual ~LumatoneSandboxLogSink() {}
+    virtual void writeLogRecords(const LumatoneSandboxLogRecord* records, int numRecords) = 0;
+};
+
+/*
+==============================================================================
+Collects log records from any thread and hands them to the sinks in batches
+from its own thread.
+
+Registered like juce::Logger, with setCurrentBackend. LumatoneSandboxLogger
+writes to the current backend, or straight to the debug output if there's
+none. A backend waits for pushes in progress on other threads before it's
+deleted.
+==============================================================================
+*/
+class LumatoneSandboxLogBackend : private juce::Thread
+{
+public:
+    LumatoneSandboxLogBackend(int queueCapacity=4096, int pollIntervalMsIn=20);
+    ~LumatoneSandboxLogBackend() override;
+
+    // From any thread
+    bool push(LumatoneSandboxLogStatus status, juce::uint16 classId, juce::uint16 methodId, const juce::String& message);
+
+    void addSink(LumatoneSandboxLogSink* sink);
+    void removeSink(LumatoneSandboxLogSink* sink);
+
+    int getNumDropped() const { return queue.getNumDropped(); }
+
+    static void setCurrentBackend(LumatoneSandboxLogBackend* backend);
+    static LumatoneSandboxLogBackend* getCurrentBackend();
+
+    // Pushes to the current backend, which can't be deleted until this returns.
+    // Returns false if there's no current backend.
+    static bool pushToCurrentBackend(LumatoneSandboxLogStatus status, juce::uint16 classId, juce::uint16 methodId, const juce::String& message);
+
+private:
+    void run() override;
+
+    // Returns the number of records dispatched
+    int drain();
+
+private:
+    static constexpr int batchSize = 64;
+
+    LumatoneSandboxLogQueue queue;
+    const int pollIntervalMs;
+
+    juce::CriticalSection sinkLock;
+    juce::Array<LumatoneSandboxLogSink*> sinks;
+
+    LumatoneSandboxLogRecord batch[batchSize];
+
+    JUCE_DECLARE_NON_COPYABLE(LumatoneSandboxLogBackend)
+};
+
+// Appends records to a text file in the LumatoneSandboxLog::toFullString format
+class LumatoneSandboxFileLogSink : public LumatoneSandboxLogSink
+{
+public:
+    // Starts a new file if the existing one is larger than maxSizeBytes
+    LumatoneSandboxFileLogSink(const juce::File& file, juce::int64 maxSizeBytes=1024 * 1024);
+
+    void writeLogRecords(const LumatoneSandboxLogRecord* records, int numRecords) override;
+
+private:
+    std::unique_ptr<juce::FileOutputStream> stream;
+
+    JUCE_DECLARE_NON_COPYABLE(LumatoneSandboxFileLogSink)
+};
+
+#endif // LUMATONE_SANDBOX_LOG_BACKEND_H
@@ -0,0 +1,130 @@
+#ifndef LUMATONE_SANDBOX_LOG_MACROS_H
+#define LUMATONE_SANDBOX_LOG_MACROS_H
+
+#include "./LumatoneSandboxLogger.h"
+
+/*
+==============================================================================
+Logging macros with compile-time levels per subsystem.
+
+    LUMATONE_LOG(GAME, INFO, *this, "startGame", "Running at " + juce::String(fps) + " fps");
+    LUMATONE_LOG_RATE_LIMITED(DRIVER, VERBOSE, driverLog, "sendCurrentMessage", 10, "SENT: " + frame.toMidiMessage().getDescription());
+
+A call below its subsystem's minimum level compiles to nothing. Otherwise the
+message expression is only evaluated when something is listening, and for
+rate limited calls only when the call site is under its limit. Suppressed
+messages are counted and reported with the next one that gets through.
+
+Minimum levels can be set per subsystem with LUMATONE_LOG_LEVEL_<SUBSYSTEM>.
+==============================================================================
+*/
+
+#define LUMATONE_LOG_LEVEL_VERBOSE  0
+#define LUMATONE_LOG_LEVEL_INFO     1
+#define LUMATONE_LOG_LEVEL_WARNING  2
+#define LUMATONE_LOG_LEVEL_ERROR    3
+#define LUMATONE_LOG_LEVEL_NONE     4
+
+#ifndef LUMATONE_LOG_LEVEL_GAME
+#if JUCE_DEBUG
+    #define LUMATONE_LOG_LEVEL_GAME LUMATONE_LOG_LEVEL_VERBOSE
+#else
+    #define LUMATONE_LOG_LEVEL_GAME LUMATONE_LOG_LEVEL_INFO
+#endif
+#endif
+
+#ifndef LUMATONE_LOG_LEVEL_AUTOMATA
+#if JUCE_DEBUG
+    #define LUMATONE_LOG_LEVEL_AUTOMATA LUMATONE_LOG_LEVEL_VERBOSE
+#else
+    #define LUMATONE_LOG_LEVEL_AUTOMATA LUMATONE_LOG_LEVEL_WARNING
+#endif
+#endif
+
+#ifndef LUMATONE_LOG_LEVEL_DRIVER
+#if JUCE_DEBUG
+    #define LUMATONE_LOG_LEVEL_DRIVER LUMATONE_LOG_LEVEL_VERBOSE
+#else
+    #define LUMATONE_LOG_LEVEL_DRIVER LUMATONE_LOG_LEVEL_WARNING
+#endif
+#endif
+
+namespace LumatoneSandboxLogLevel
+{
+    // Verbose logs are shown with the info status
+    constexpr LumatoneSandboxLogStatus toStatus(int level)
+    {
+        return level >= LUMATONE_LOG_LEVEL_ERROR   ? LumatoneSandboxLogStatus::ERROR
+             : level >= LUMATONE_LOG_LEVEL_WARNING ? LumatoneSandboxLogStatus::WARNING
+                                                   : LumatoneSandboxLogStatus::INFO;
+    }
+}
+
+// Lets through at most maxPerSecond calls in each one second window, counting the rest. Lock-free.
+class LumatoneSandboxLogRateLimiter
+{
+public:
+    LumatoneSandboxLogRateLimiter(int maxPerSecondIn)
+        : maxPerSecond(maxPerSecondIn)
+        , windowStartMs(juce::Time::getMillisecondCounter())
+    {}
+
+    // Returns true if the call may log, with the number suppressed since the last one that did
+    bool tryAcquire(int& numSuppressedOut)
+    {
+        const juce::uint32 nowMs = juce::Time::getMillisecondCounter();
+
+        juce::uint32 windowStart = windowStartMs.load(std::memory_order_relaxed);
+        if (nowMs - windowStart >= windowDurationMs
+            && windowStartMs.compare_exchange_strong(windowStart, nowMs, std::memory_order_relaxed))
+        {
+            numInWindow.store(0, std::memory_order_relaxed);
+        }
+
+        if (numInWindow.fetch_add(1, std::memory_order_relaxed) < maxPerSecond)
+        {
+            numSuppressedOut = numSuppressed.exchange(0, std::memory_order_relaxed);
+            return true;
+        }
+
+        numSuppressed.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+private:
+    static constexpr juce::uint32 windowDurationMs = 1000;
+
+    const int maxPerSecond;
+
+    std::atomic<juce::uint32> windowStartMs;
+    std::atomic<int> numInWindow { 0 };
+    std::atomic<int> numSuppressed { 0 };
+};
+
+#define LUMATONE_LOG(subsystem, level, logger, method, message)                                             \
+    do {                                                                                                    \
+        if constexpr (LUMATONE_LOG_LEVEL_##level >= LUMATONE_LOG_LEVEL_##subsystem)                         \
+        {                                                                                                   \
+            if (LumatoneSandboxLogger::isListening())                                                       \
+                (logger).log(LumatoneSandboxLogLevel::toStatus(LUMATONE_LOG_LEVEL_##level), method, message); \
+        }                                                                                                   \
+    } while (false)
+
+#define LUMATONE_LOG_RATE_LIMITED(subsystem, level, logger, method, maxPerSecond, message)                 \
+    do {                                                                                                    \
+        if constexpr (LUMATONE_LOG_LEVEL_##level >= LUMATONE_LOG_LEVEL_##subsystem)                         \
+        {                                                                                                   \
+            static LumatoneSandboxLogRateLimiter lumatoneLogRateLimiter (maxPerSecond);                     \
+            int lumatoneLogNumSuppressed = 0;                                                               \
+            if (LumatoneSandboxLogger::isListening() && lumatoneLogRateLimiter.tryAcquire(lumatoneLogNumSuppressed)) \
+            {                                                                                               \
+                if (lumatoneLogNumSuppressed > 0)                                                           \
+                    (logger).log(LumatoneSandboxLogLevel::toStatus(LUMATONE_LOG_LEVEL_##level), method,     \
+                                 juce::String(message) + " (" + juce::String(lumatoneLogNumSuppressed) + " suppressed)"); \
+                else                                                                                        \
+                    (logger).log(LumatoneSandboxLogLevel::toStatus(LUMATONE_LOG_LEVEL_##level), method, message); \
+            }                                                                                               \
+        }                                                                                                   \
+    } while (false)
+
+#endif // LUMATONE_SANDBOX_LOG_MACROS_H
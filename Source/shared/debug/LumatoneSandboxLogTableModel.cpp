@@ -1,40 +1,82 @@
-
 #include "./LumatoneSandboxLogTableModel.h"
 #include "LumatoneSandboxLogTableModel.h"
 
-LumatoneSandboxLogTableModel::~LumatoneSandboxLogTableModel()
+LumatoneSandboxLogTableModel::LumatoneSandboxLogTableModel()
+    : loggerClassId(LumatoneSandboxLogNames::intern("juce::Logger"))
 {
+    defaultLog.classId = LumatoneSandboxLogNames::intern("LumatoneSandboxLogTableModel");
+    defaultLog.methodId = LumatoneSandboxLogNames::internLiteral("initialized");
+    defaultLog.setMessage("No logs yet.");
+}
 
+LumatoneSandboxLogTableModel::~LumatoneSandboxLogTableModel()
+{
+    cancelPendingUpdate();
 }
 
 void LumatoneSandboxLogTableModel::logMessage(const juce::String& message)
 {
-    if (numLogs == maxLogs)
-        logs.remove(0);
-    else
-        numLogs++;
-    
-    LumatoneSandboxLog logInfo = LumatoneSandboxLog::FromString(message);
-    if (logInfo.time == errorTime)
+    LumatoneSandboxLogger::Log(LumatoneSandboxLogStatus::INFO, loggerClassId, 0, message);
+}
+
+void LumatoneSandboxLogTableModel::writeLogRecords(const LumatoneSandboxLogRecord* records, int numRecords)
+{
+    // Older ones would be pushed out of the ring anyway if the message thread falls behind
+    const int numToAdd = juce::jmin(numRecords, maxLogs);
+    records += numRecords - numToAdd;
+
     {
-        logInfo.className = "LumatoneSandboxLogTableModel";
-        logInfo.method = "logMessage";
-        logInfo.message = "Unable to parse message: " + message;
+        juce::SpinLock::ScopedLockType l(pendingLock);
+        for (int i = 0; i < numToAdd; i++)
+            pendingLogs.add(records[i]);
     }
 
-    logs.add(logInfo);
-    
-    juce::MessageManager::callAsync([=]() { sendChangeMessage(); });
+    triggerAsyncUpdate();
+}
+
+void LumatoneSandboxLogTableModel::handleAsyncUpdate()
+{
+    {
+        juce::SpinLock::ScopedLockType l(pendingLock);
+        receivedLogs.swapWith(pendingLogs);
+    }
+
+    for (int i = 0; i < receivedLogs.size; i++)
+        logs.add(receivedLogs[i]);
+
+    receivedLogs.clear();
+    sendSynchronousChangeMessage();
 }
 
-const LumatoneSandboxLog& LumatoneSandboxLogTableModel::getLog(int logNum) const
+const LumatoneSandboxLogRecord& LumatoneSandboxLogTableModel::getRecord(int logNum) const
 {
-    if (logNum < logs.size())
-        return logs.getReference(logNum);
+    if (logNum >= 0 && logNum < logs.size)
+        return logs[logNum];
     
     return defaultLog;
 }
 
+void LumatoneSandboxLogTableModel::Ring::add(const LumatoneSandboxLogRecord& record)
+{
+    if (size < maxLogs)
+    {
+        records[(first + size) % maxLogs] = record;
+        size++;
+    }
+    else
+    {
+        records[first] = record;
+        first = (first + 1) % maxLogs;
+    }
+}
+
+void LumatoneSandboxLogTableModel::Ring::swapWith(Ring& other) noexcept
+{
+    records.swapWith(other.records);
+    std::swap(first, other.first);
+    std::swap(size, other.size);
+}
+
 juce::Colour LumatoneSandboxLogTableModel::getRowColour(int rowNumber, LumatoneSandboxLogStatus status)
 {
     juce::Colour c = rowNumber % 2 == 0 ? juce::Colours::lightslategrey : juce::Colours::lightgrey;
@@ -48,8 +90,8 @@ juce::Colour LumatoneSandboxLogTableModel::getRowColour(int rowNumber, LumatoneS
 }
 void LumatoneSandboxLogTableModel::paintRowBackground(juce::Graphics &g, int rowNumber, int width, int height, bool rowIsSelected)
 {   
-    auto log = getLog(rowNumber);
-    auto c = getRowColour(rowNumber, log.status);
+    const auto& record = getRecord(rowNumber);
+    auto c = getRowColour(rowNumber, record.getStatus());
     g.fillAll(c);
 }
 
@@ -58,31 +100,31 @@ void LumatoneSandboxLogTableModel::paintCell(juce::Graphics& g, int rowNumber, i
     if (rowNumber < 0)
         return;
     
-    const LumatoneSandboxLog& log = getLog(rowNumber);
+    const auto& record = getRecord(rowNumber);
     juce::String value;
 
     switch (columnId)
     {
     case LumatoneSandboxLogTableColumn::Date:
-        value = log.time.toString(true, true, true, true);
+        value = record.getTime().toString(true, true, true, true);
         break;
     case LumatoneSandboxLogTableColumn::Class:
-        value = log.className;
+        value = record.getClassName();
         break;
     case LumatoneSandboxLogTableColumn::Status:
-        value = log.getStatusString();
+        value = LumatoneSandboxLog::StatusToString(record.getStatus());
         break;
     case LumatoneSandboxLogTableColumn::Method:
-        value = log.method;
+        value = record.getMethod();
         break;
     case LumatoneSandboxLogTableColumn::Message:
-        value = log.message;
+        value = record.getMessage();
         break;
     default:
         break;
     }
 
-    juce::Colour textColour = getRowColour(rowNumber, log.status).contrasting(0.95f);
+    juce::Colour textColour = getRowColour(rowNumber, record.getStatus()).contrasting(0.95f);
     g.setColour(textColour);
     g.drawText(value, 0, 0, width, height, juce::Justification::centredLeft);
 }
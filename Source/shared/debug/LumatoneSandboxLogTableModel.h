@@ -1,7 +1,7 @@
 #ifndef LUMATONE_SANDBOX_LOG_TABLE_MODEL_H
 #define LUMATONE_SANDBOX_LOG_TABLE_MODEL_H
 
-#include "./LumatoneSandboxLogger.h"
+#include "./LumatoneSandboxLogBackend.h"
 
 typedef enum
 {
@@ -13,49 +13,70 @@ typedef enum
     Info
 } LumatoneSandboxLogTableColumn;
 
+// Keeps the most recent log records in a ring and formats cells only when they are painted
 class LumatoneSandboxLogTableModel   : public juce::Logger
                                      , public juce::TableListBoxModel
                                      , public juce::ChangeBroadcaster
+                                     , public LumatoneSandboxLogSink
+                                     , private juce::AsyncUpdater
 {
 public:
 
-    LumatoneSandboxLogTableModel() {}
+    LumatoneSandboxLogTableModel();
     ~LumatoneSandboxLogTableModel() override;
 
+    // For messages written through juce::Logger by other code
     void logMessage(const juce::String& message) override;
 
+    // Called from the LumatoneSandboxLogBackend thread
+    void writeLogRecords(const LumatoneSandboxLogRecord* records, int numRecords) override;
 
-    int getNumRows() override { return numLogs; }
+    int getNumRows() override { return logs.size; }
     
     void paintRowBackground(juce::Graphics&, int rowNumber, int width, int height, bool rowIsSelected) override;
     
     void paintCell(juce::Graphics&, int rowNumber, int columnId, int width, int height, bool rowIsSelected) override;
 
-    const LumatoneSandboxLog& getLog(int logNum) const;
+    const LumatoneSandboxLogRecord& getRecord(int logNum) const;
 
 private:
 
+    void handleAsyncUpdate() override;
+
     static juce::Colour getRowColour(int rowNumber, LumatoneSandboxLogStatus status);
 
 private:
     
-    int maxLogs = 1000;
-    
-    int numLogs = 0;
-    
-    juce::Array<LumatoneSandboxLog> logs;
+    static constexpr int maxLogs = 1000;
 
-    juce::Time errorTime;
-
-    LumatoneSandboxLog defaultLog =
+    // Fixed capacity ring of the last maxLogs records added, oldest at first.
+    // Allocated once, so adding never allocates and swapping only exchanges pointers.
+    struct Ring
     {
-        juce::Time(),
-        "LumatoneSandboxLogTableModel",
-        LumatoneSandboxLogStatus::INFO,
-        "initialized",
-        "No logs yet."
+        Ring() { records.allocate(maxLogs, true); }
+
+        void add(const LumatoneSandboxLogRecord& record);
+        void clear() { first = 0; size = 0; }
+        void swapWith(Ring& other) noexcept;
+
+        const LumatoneSandboxLogRecord& operator[](int index) const { return records[(first + index) % maxLogs]; }
+
+        juce::HeapBlock<LumatoneSandboxLogRecord> records;
+        int first = 0;
+        int size = 0;
     };
 
+    Ring logs;
+
+    // Filled by the backend thread, swapped out and moved into logs on the message thread
+    juce::SpinLock pendingLock;
+    Ring pendingLogs;
+    Ring receivedLogs;
+
+    const juce::uint16 loggerClassId;
+
+    LumatoneSandboxLogRecord defaultLog;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (LumatoneSandboxLogTableModel)
 };
 
@@ -1,19 +1,39 @@
-
 #include "LumatoneSandboxLogger.h"
+#include "LumatoneSandboxLogBackend.h"
 
 LumatoneSandboxLogger::LumatoneSandboxLogger(juce::String classNameIn)
     : className(classNameIn)
+    , classId(LumatoneSandboxLogNames::intern(classNameIn))
 {
 
 }
 
 void LumatoneSandboxLogger::Log(LumatoneSandboxLog info)
 {
-    juce::String logMessage = info.toFullString();
-    juce::Logger::writeToLog(logMessage);
+    Log(info.status, LumatoneSandboxLogNames::intern(info.className), LumatoneSandboxLogNames::intern(info.method), info.message);
+}
 
-    juce::String simpleMsg = info.toShortString();
-    juce::Logger::outputDebugString(simpleMsg);
+void LumatoneSandboxLogger::Log(LumatoneSandboxLogStatus status, juce::uint16 classId, juce::uint16 methodId, const juce::String& message)
+{
+    if (LumatoneSandboxLogBackend::pushToCurrentBackend(status, classId, methodId, message))
+        return;
+
+    LumatoneSandboxLogRecord record;
+    record.ticks = juce::Time::getHighResolutionTicks();
+    record.classId = classId;
+    record.methodId = methodId;
+    record.status = (juce::int8)status;
+    record.setMessage(message);
+    juce::Logger::outputDebugString(record.toLog().toShortString());
+}
+
+bool LumatoneSandboxLogger::isListening()
+{
+#if JUCE_DEBUG
+    return true;
+#else
+    return LumatoneSandboxLogBackend::getCurrentBackend() != nullptr;
+#endif
 }
 
 void LumatoneSandboxLogger::logMessage(const juce::String &message)
@@ -21,23 +41,22 @@ void LumatoneSandboxLogger::logMessage(const juce::String &message)
     juce::Logger::writeToLog(message);
 }
 
-void LumatoneSandboxLogger::log(LumatoneSandboxLogStatus status, juce::String method, juce::String message) const
+void LumatoneSandboxLogger::log(LumatoneSandboxLogStatus status, const char* method, const juce::String& message) const
 {
-    LumatoneSandboxLog info = getLog(status, method, message);
-    LumatoneSandboxLogger::Log(info);
+    Log(status, classId, LumatoneSandboxLogNames::internLiteral(method), message);
 }
 
-void LumatoneSandboxLogger::logInfo(juce::String method, juce::String message) const
+void LumatoneSandboxLogger::logInfo(const char* method, const juce::String& message) const
 {
     log(LumatoneSandboxLogStatus::INFO, method, message);
 }
 
-void LumatoneSandboxLogger::logWarning(juce::String method, juce::String message) const
+void LumatoneSandboxLogger::logWarning(const char* method, const juce::String& message) const
 {
     log(LumatoneSandboxLogStatus::WARNING, method, message);
 }
 
-void LumatoneSandboxLogger::logError(juce::String method, juce::String message) const
+void LumatoneSandboxLogger::logError(const char* method, const juce::String& message) const
 {
     log(LumatoneSandboxLogStatus::ERROR, method, message);
 }
@@ -114,6 +133,11 @@ juce::String LumatoneSandboxLog::toShortString() const
 }
 
 juce::String LumatoneSandboxLog::getStatusString() const
+{
+    return StatusToString(status);
+}
+
+juce::String LumatoneSandboxLog::StatusToString(LumatoneSandboxLogStatus status)
 {
     switch (status)
     {
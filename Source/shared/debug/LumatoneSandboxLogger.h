@@ -26,6 +26,7 @@ struct LumatoneSandboxLog
 
     static LumatoneSandboxLog FromString(juce::String logString);
 
+    static juce::String StatusToString(LumatoneSandboxLogStatus status);
     static LumatoneSandboxLogStatus CodeToStatus(int statusCode);
     static LumatoneSandboxLogStatus LogStringToStatus(juce::StringRef statusString);
 };
@@ -37,21 +38,25 @@ public:
     LumatoneSandboxLogger(juce::String className);
     virtual ~LumatoneSandboxLogger() override { }
 
-    // Basic log message with status parameter
-    void log(LumatoneSandboxLogStatus status, juce::String method, juce::String message) const;
+    // Basic log message with status parameter, method should be a string literal
+    void log(LumatoneSandboxLogStatus status, const char* method, const juce::String& message) const;
 
     // Status-based helper methods
-    void logInfo(juce::String method, juce::String message) const;
-    void logWarning(juce::String method, juce::String message) const;
-    void logError(juce::String method, juce::String message) const;
+    void logInfo(const char* method, const juce::String& message) const;
+    void logWarning(const char* method, const juce::String& message) const;
+    void logError(const char* method, const juce::String& message) const;
 
     // Helper to build struct, mainly to add more info
     LumatoneSandboxLog getLog(LumatoneSandboxLogStatus status, juce::String method, juce::String message) const;
 
 public:
 
-    // Send logs to juce::Logger registered with applicatoin
+    // Send logs to the current LumatoneSandboxLogBackend, or the debug output if there is none
     static void Log(LumatoneSandboxLog logInfo);
+    static void Log(LumatoneSandboxLogStatus status, juce::uint16 classId, juce::uint16 methodId, const juce::String& message);
+
+    // True if logs go anywhere, either a LumatoneSandboxLogBackend or the debug output in debug builds
+    static bool isListening();
     
 private:
 
@@ -60,6 +65,7 @@ private:
 protected:
 
     juce::String className = "undefined";
+    juce::uint16 classId = 0;
 
     JUCE_DECLARE_NON_COPYABLE(LumatoneSandboxLogger)
 };
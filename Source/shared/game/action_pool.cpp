@@ -0,0 +1,75 @@
+/*
+  ==============================================================================
+
+    action_pool.cpp
+    Created: 19 Oct 2026
+    Author:  Vincenzo
+
+  ==============================================================================
+*/
+
+#include "action_pool.h"
+
+#include "../lumatone_editor_library/actions/edit_actions.h"
+
+class LumatoneSandboxActionPool::PooledMultiKeyAssignAction : public LumatoneEditAction::MultiKeyAssignAction
+{
+public:
+    PooledMultiKeyAssignAction(const LumatoneSandboxActionPool* poolIn, LumatoneController* controller, const juce::Array<MappedLumatoneKey>& updatedKeys,
+                               bool setConfig, bool setColour, bool bufferKeyUpdates)
+        : LumatoneEditAction::MultiKeyAssignAction(controller, updatedKeys, setConfig, setColour, bufferKeyUpdates)
+        , pool(poolIn)
+    {
+    }
+
+    const LumatoneSandboxActionPool* const pool;
+    bool isFree = false;
+};
+
+LumatoneSandboxActionPool::LumatoneSandboxActionPool(LumatoneController* controllerIn)
+    : controller(controllerIn)
+{
+}
+
+LumatoneSandboxActionPool::~LumatoneSandboxActionPool()
+{
+    // Actions still in use are owned by a game queue that outlived the pool
+    jassert(getNumInUse() == 0);
+}
+
+LumatoneAction* LumatoneSandboxActionPool::acquireMultiKeyAssign(const juce::Array<MappedLumatoneKey>& updatedKeys, bool setConfig, bool setColour, bool bufferKeyUpdates)
+{
+    if (freeMultiKeyAssignActions.size() > 0)
+    {
+        auto action = freeMultiKeyAssignActions.removeAndReturn(freeMultiKeyAssignActions.size() - 1);
+        action->isFree = false;
+        action->reassign(updatedKeys, setConfig, setColour, bufferKeyUpdates);
+        return action;
+    }
+
+    numAllocated++;
+    freeMultiKeyAssignActions.ensureStorageAllocated(numAllocated);
+    return multiKeyAssignActions.add(new PooledMultiKeyAssignAction(this, controller, updatedKeys, setConfig, setColour, bufferKeyUpdates));
+}
+
+void LumatoneSandboxActionPool::release(LumatoneAction* action)
+{
+    if (action == nullptr)
+        return;
+
+    auto pooled = dynamic_cast<PooledMultiKeyAssignAction*>(action);
+    if (pooled != nullptr)
+    {
+        // Released to the wrong pool, or released twice
+        jassert(pooled->pool == this && !pooled->isFree);
+        if (pooled->pool != this || pooled->isFree)
+            return;
+
+        pooled->isFree = true;
+        freeMultiKeyAssignActions.add(pooled);
+        return;
+    }
+
+    numDeleted++;
+    delete action;
+}
@@ -0,0 +1,63 @@
+/*
+  ==============================================================================
+
+    action_pool.h
+    Created: 19 Oct 2026
+    Author:  Vincenzo
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../lumatone_editor_library/data/lumatone_layout.h"
+
+class LumatoneAction;
+class LumatoneController;
+
+namespace LumatoneEditAction
+{
+    class MultiKeyAssignAction;
+}
+
+/*
+==============================================================================
+Owns the actions games queue for the engine to perform without undo.
+
+Per-frame key assign actions are recycled, so a running game stops allocating
+once the pool has grown to its working size. Any other action released here
+is deleted. Not thread safe, only use from the game engine thread.
+==============================================================================
+*/
+class LumatoneSandboxActionPool
+{
+public:
+
+    LumatoneSandboxActionPool(LumatoneController* controllerIn);
+    ~LumatoneSandboxActionPool();
+
+    LumatoneAction* acquireMultiKeyAssign(const juce::Array<MappedLumatoneKey>& updatedKeys, bool setConfig=true, bool setColour=true, bool bufferKeyUpdates=false);
+
+    // Takes ownership of the action
+    void release(LumatoneAction* action);
+
+    // Debug counters
+    int getNumAllocated() const { return numAllocated; }
+    int getNumInUse() const { return numAllocated - freeMultiKeyAssignActions.size(); }
+    int getNumDeleted() const { return numDeleted; }
+
+private:
+
+    // A MultiKeyAssignAction that knows its pool and whether it's free, so release() is O(1)
+    class PooledMultiKeyAssignAction;
+
+    LumatoneController* controller;
+
+    juce::OwnedArray<PooledMultiKeyAssignAction> multiKeyAssignActions;
+    juce::Array<PooledMultiKeyAssignAction*> freeMultiKeyAssignActions;
+
+    int numAllocated = 0;
+    int numDeleted = 0;
+
+    JUCE_DECLARE_NON_COPYABLE(LumatoneSandboxActionPool)
+};
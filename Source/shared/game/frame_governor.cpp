@@ -0,0 +1,90 @@
+/*
+  ==============================================================================
+
+    frame_governor.cpp
+    Created: 19 Oct 2026
+    Author:  Vincenzo
+
+  ==============================================================================
+*/
+
+#include "frame_governor.h"
+
+void LumatoneSandboxFrameGovernor::reset()
+{
+    hasSample = false;
+    messageRate = 0;
+    keyUpdateRate = 0;
+    updateBudget = 0;
+    numFramesSkipped = 0;
+    numBackoffs = 0;
+}
+
+bool LumatoneSandboxFrameGovernor::update(const LumatoneFirmware::SendStatistics& stats, double fps, double timeMs)
+{
+    if (!hasSample || stats.messagesRetired < lastMessagesRetired)
+    {
+        // First tick, or the driver counters were reset
+        lastTimeMs = timeMs;
+        lastMessagesRetired = stats.messagesRetired;
+        lastKeyUpdatesAcknowledged = stats.keyUpdatesAcknowledged;
+        lastBusyAnswers = stats.busyAnswers;
+        lastTimeouts = stats.timeouts;
+        hasSample = true;
+        return true;
+    }
+
+    const double elapsedMs = timeMs - lastTimeMs;
+    if (elapsedMs > 0)
+    {
+        const double seconds = elapsedMs * 0.001;
+        const double alpha = 1.0 - std::exp(-elapsedMs / options.smoothingMs);
+
+        const double messagesPerSecond = (double)(stats.messagesRetired - lastMessagesRetired) / seconds;
+        const double keysPerSecond = (double)(stats.keyUpdatesAcknowledged - lastKeyUpdatesAcknowledged) / seconds;
+
+        if (stats.busyAnswers > lastBusyAnswers || stats.timeouts > lastTimeouts)
+        {
+            // The device is falling behind, whatever it retired meanwhile
+            messageRate *= options.backoffFactor;
+            numBackoffs++;
+        }
+        else
+        {
+            // An idle queue only shows what we sent, not what the device could take
+            double newRate = stats.queueSize > 0
+                           ? messageRate + alpha * (messagesPerSecond - messageRate)
+                           : juce::jmax(messageRate, messagesPerSecond);
+
+            // Follows the measurements until the first back-off, then climbs back gradually
+            if (numBackoffs > 0)
+                newRate = juce::jmin(newRate, messageRate + options.maxRateIncreasePerSecond * seconds);
+
+            messageRate = newRate;
+        }
+
+        keyUpdateRate += alpha * (keysPerSecond - keyUpdateRate);
+
+        lastTimeMs = timeMs;
+        lastMessagesRetired = stats.messagesRetired;
+        lastKeyUpdatesAcknowledged = stats.keyUpdatesAcknowledged;
+        lastBusyAnswers = stats.busyAnswers;
+        lastTimeouts = stats.timeouts;
+    }
+
+    if (messageRate > 0 && fps > 0)
+    {
+        // Refill what the device will retire before the next tick, and close half the gap to the target depth
+        const double capacity = messageRate / fps;
+        const double headroom = options.targetQueueDepth - stats.queueSize;
+        updateBudget = juce::jlimit(options.minUpdatesPerFrame, options.maxUpdatesPerFrame, juce::roundToInt(capacity + headroom * 0.5));
+    }
+
+    if (stats.queueSize > options.maxQueueDepth)
+    {
+        numFramesSkipped++;
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,95 @@
+/*
+  ==============================================================================
+
+    frame_governor.h
+    Created: 19 Oct 2026
+    Author:  Vincenzo
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../lumatone_editor_library/lumatone_midi_driver/firmware_types.h"
+
+/*
+==============================================================================
+Keeps game output within what the device can take.
+
+Each engine tick the governor looks at the firmware send queue depth and how
+fast the device has been answering messages, then sets the number of key
+updates the game may render in the next frame. If the queue is too far
+behind, the frame is skipped entirely so the device can catch up.
+
+The rate backs off AIMD style: it's cut by a factor whenever the device
+answers busy or times out, and from then on only climbs back by a fixed
+amount per second.
+==============================================================================
+*/
+class LumatoneSandboxFrameGovernor
+{
+public:
+
+    struct Options
+    {
+        // Queue depth to aim for, enough to keep the device busy between ticks
+        int targetQueueDepth = 24;
+
+        // Skip frames while the queue holds more than this
+        int maxQueueDepth = 120;
+
+        int minUpdatesPerFrame = 1;
+        int maxUpdatesPerFrame = 280;
+
+        // Time constant of the rate averages
+        double smoothingMs = 1000.0;
+
+        // Message rate is multiplied by this after busy answers or timeouts
+        double backoffFactor = 0.5;
+
+        // Most the message rate can rise per second after a back-off, in messages per second
+        double maxRateIncreasePerSecond = 20.0;
+    };
+
+public:
+
+    void setOptions(Options optionsIn) { options = optionsIn; }
+    const Options& getOptions() const { return options; }
+
+    void reset();
+
+    // Call once per engine tick, returns false if the next frame should be skipped
+    bool update(const LumatoneFirmware::SendStatistics& stats, double fps, double timeMs);
+
+    // Key updates allowed in the next frame, or 0 until the device rate has been measured
+    int getUpdateBudget() const { return updateBudget; }
+
+    // Messages per second the device retires while it has work queued
+    double getMessageRate() const { return messageRate; }
+
+    // Effective key updates per second acknowledged by the device
+    double getSustainedKeyUpdateRate() const { return keyUpdateRate; }
+
+    int getNumFramesSkipped() const { return numFramesSkipped; }
+
+    // Times the message rate was cut after busy answers or timeouts
+    int getNumBackoffs() const { return numBackoffs; }
+
+private:
+
+    Options options;
+
+    double lastTimeMs = 0;
+    juce::int64 lastMessagesRetired = 0;
+    juce::int64 lastKeyUpdatesAcknowledged = 0;
+    juce::int64 lastBusyAnswers = 0;
+    juce::int64 lastTimeouts = 0;
+    bool hasSample = false;
+
+    double messageRate = 0;
+    double keyUpdateRate = 0;
+
+    int updateBudget = 0;
+    int numFramesSkipped = 0;
+    int numBackoffs = 0;
+};
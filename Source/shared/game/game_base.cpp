@@ -13,6 +13,8 @@
 #include "../lumatone_editor_library/LumatoneController.h"
 #include "../lumatone_editor_library/actions/edit_actions.h"
 
+#include "action_pool.h"
+
 LumatoneSandboxGameBase::LumatoneSandboxGameBase(LumatoneController* controllerIn, juce::String actionName)
     : controller(controllerIn)
     // , controller(midiMgrIn)
@@ -35,8 +37,8 @@ void LumatoneSandboxGameBase::clearQueue()
     for (int i = 0; i < queueSize; i++)
     {
         int ptr = (queuePtr + i) % MAX_QUEUE_SIZE;
-        if (queuedActions[ptr] != nullptr)
-            delete queuedActions[ptr];
+        releaseAction(queuedActions[ptr]);
+        queuedActions[ptr] = nullptr;
     }
 
     queueSize = 0;
@@ -69,6 +71,14 @@ void LumatoneSandboxGameBase::end()
     queueLayout(layoutBeforeStart);
 }
 
+double LumatoneSandboxGameBase::getInputTime() const
+{
+    if (frameTimeMs <= 0)
+        return 0;
+
+    return juce::jmax(juce::Time::getMillisecondCounterHiRes() + midiScheduleLatencyMs, frameTimeMs);
+}
+
 LumatoneKeyContext LumatoneSandboxGameBase::getKeyAt(int boardIndex, int keyIndex) const
 {
     return controller->getKeyContext(boardIndex, keyIndex);
@@ -85,17 +95,38 @@ void LumatoneSandboxGameBase::addToQueue(LumatoneAction* action)
     else if (queueSize < MAX_QUEUE_SIZE)
         queueSize += 1;
     else
-        delete queuedActions[getQueuePtr()];
+        releaseAction(queuedActions[getQueuePtr()]);
 
     queuedActions[getQueuePtr()] = action;
 }
 
+juce::Array<MappedLumatoneKey>& LumatoneSandboxGameBase::getFrameKeyBuffer() const
+{
+    frameKeyBuffer.clearQuick();
+    return frameKeyBuffer;
+}
+
+LumatoneAction* LumatoneSandboxGameBase::createMultiKeyAssignAction(const juce::Array<MappedLumatoneKey>& updatedKeys, bool setConfig, bool setColour, bool bufferKeyUpdates) const
+{
+    if (actionPool != nullptr)
+        return actionPool->acquireMultiKeyAssign(updatedKeys, setConfig, setColour, bufferKeyUpdates);
+
+    return new LumatoneEditAction::MultiKeyAssignAction(controller, updatedKeys, setConfig, setColour, bufferKeyUpdates);
+}
+
+void LumatoneSandboxGameBase::releaseAction(LumatoneAction* action)
+{
+    if (actionPool != nullptr)
+        actionPool->release(action);
+    else
+        delete action;
+}
+
 void LumatoneSandboxGameBase::queueLayout(const LumatoneLayout& layout)
 {
     for (int i = 0; i < controller->getNumBoards(); i++)
     {
-        const LumatoneBoard* newBoard = layout.readBoard(i);
-        addToQueue(new LumatoneEditAction::SectionEditAction(controller, i, *newBoard));
+        addToQueue(new LumatoneEditAction::SectionEditAction(controller, i, layout.shareBoard(i)));
     }
 }
 
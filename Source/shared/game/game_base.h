@@ -19,6 +19,7 @@
 
 class LumatoneAction;
 class LumatoneController;
+class LumatoneSandboxActionPool;
 
 class KeyColorConstrainer
 {
@@ -64,6 +65,24 @@ public:
 
     virtual double getLockedFps() const { return 0; }
 
+    // Key updates the engine allows in the next frame, 0 means no limit
+    void setKeyUpdateBudget(int numKeyUpdates) { keyUpdateBudget = numKeyUpdates; }
+
+    // Time the current frame's MIDI is meant to be heard, on the juce::Time::getMillisecondCounterHiRes() clock.
+    // Set by the engine before each tick, 0 means send immediately.
+    void setFrameTime(double timeMs) { frameTimeMs = timeMs; }
+    double getFrameTime() const { return frameTimeMs; }
+
+    // Latency the engine adds to frame times
+    void setMidiScheduleLatency(double latencyMs) { midiScheduleLatencyMs = latencyMs; }
+
+    // Time MIDI triggered by player input is meant to be heard, now plus the latency, but never before
+    // the current frame so it isn't cut off by that frame's notes. 0 if frames are sent immediately.
+    double getInputTime() const;
+
+    // Pool that owns queued actions once the engine performs them, queued actions are heap allocated without one
+    void setActionPool(LumatoneSandboxActionPool* pool) { actionPool = pool; }
+
     juce::String getName() const { return name; }
 
     const LumatoneLayout& getLayoutBeforeStart() const { return layoutBeforeStart; }
@@ -72,6 +91,15 @@ protected:
 
     LumatoneKeyContext getKeyAt(int boardIndex, int keyIndex) const;
 
+    // Caps a game's own per-frame limit to the engine budget
+    int getKeyUpdateLimit(int gameLimit) const { return keyUpdateBudget > 0 ? juce::jmin(gameLimit, keyUpdateBudget) : gameLimit; }
+
+    // Cleared key list to render a frame into, reused between frames
+    juce::Array<MappedLumatoneKey>& getFrameKeyBuffer() const;
+
+    LumatoneAction* createMultiKeyAssignAction(const juce::Array<MappedLumatoneKey>& updatedKeys, bool setConfig=true, bool setColour=true, bool bufferKeyUpdates=false) const;
+    void releaseAction(LumatoneAction* action);
+
 private:
 
     int getQueuePtr() const { return (queuePtr + queueSize - 1) % MAX_QUEUE_SIZE; }
@@ -93,4 +121,11 @@ protected:
 
 private:
     juce::String name;
+
+    int keyUpdateBudget = 0;
+    double frameTimeMs = 0;
+    double midiScheduleLatencyMs = 0;
+
+    LumatoneSandboxActionPool* actionPool = nullptr;
+    mutable juce::Array<MappedLumatoneKey> frameKeyBuffer;
 };
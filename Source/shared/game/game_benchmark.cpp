@@ -0,0 +1,472 @@
+/*
+  ==============================================================================
+
+    game_benchmark.cpp
+    Created: 19 Oct 2026
+    Author:  Vincenzo
+
+  ==============================================================================
+*/
+
+#include "game_benchmark.h"
+#include "action_pool.h"
+
+#include "random_colors/random_colors.h"
+#include "hex_rings/hex_rings.h"
+#include "hexagon_automata/hexagon_automata.h"
+
+#include "../lumatone_editor_library/LumatoneController.h"
+#include "../lumatone_editor_library/lumatone_midi_driver/lumatone_midi_driver.h"
+
+#include <iostream>
+
+#if LUMATONE_SANDBOX_BENCHMARK_COUNT_ALLOCATIONS
+
+// Linked with -Wl,--wrap=malloc,--wrap=calloc,--wrap=realloc, so juce::HeapBlock growth
+// is counted along with operator new, which is replaced below to go through malloc
+static thread_local juce::int64 numAllocationsOnThread = 0;
+
+extern "C"
+{
+    void* __real_malloc(std::size_t size);
+    void* __real_calloc(std::size_t num, std::size_t size);
+    void* __real_realloc(void* ptr, std::size_t size);
+
+    void* __wrap_malloc(std::size_t size)
+    {
+        numAllocationsOnThread++;
+        return __real_malloc(size);
+    }
+
+    void* __wrap_calloc(std::size_t num, std::size_t size)
+    {
+        numAllocationsOnThread++;
+        return __real_calloc(num, size);
+    }
+
+    void* __wrap_realloc(void* ptr, std::size_t size)
+    {
+        numAllocationsOnThread++;
+        return __real_realloc(ptr, size);
+    }
+}
+
+void* operator new(std::size_t size)
+{
+    if (auto ptr = std::malloc(size > 0 ? size : 1))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) { return operator new(size); }
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+static juce::int64 getNumAllocations() { return numAllocationsOnThread; }
+
+#else
+
+static juce::int64 getNumAllocations() { return 0; }
+
+#endif
+
+static void addSeedPattern(LumatoneSandboxGameBase& game, int tickNum)
+{
+    auto& automata = static_cast<HexagonAutomata::Game&>(game);
+    if (tickNum == 0)
+        automata.addSeeds(8);
+    else if (tickNum % 45 == 0)
+        automata.addSeeds(2);
+}
+
+static double ticksToMs(juce::int64 ticks)
+{
+    return juce::Time::highResolutionTicksToSeconds(ticks) * 1000.0;
+}
+
+// Nearest rank, samples must be sorted
+static double getPercentile(const juce::Array<double>& samples, double fraction)
+{
+    const int index = (int)std::ceil(fraction * samples.size()) - 1;
+    return samples[juce::jlimit(0, samples.size() - 1, index)];
+}
+
+LumatoneSandboxGameBenchmark::Percentiles LumatoneSandboxGameBenchmark::Percentiles::fromSamples(juce::Array<double>& samples)
+{
+    Percentiles percentiles;
+    if (samples.size() == 0)
+        return percentiles;
+
+    samples.sort();
+
+    double sum = 0;
+    for (auto sample : samples)
+        sum += sample;
+
+    percentiles.mean = sum / samples.size();
+    percentiles.p50 = getPercentile(samples, 0.5);
+    percentiles.p90 = getPercentile(samples, 0.9);
+    percentiles.p99 = getPercentile(samples, 0.99);
+    percentiles.max = samples.getLast();
+
+    return percentiles;
+}
+
+juce::var LumatoneSandboxGameBenchmark::Percentiles::toVar() const
+{
+    juce::DynamicObject::Ptr object = new juce::DynamicObject();
+    object->setProperty("mean", mean);
+    object->setProperty("p50", p50);
+    object->setProperty("p90", p90);
+    object->setProperty("p99", p99);
+    object->setProperty("max", max);
+    return juce::var(object.get());
+}
+
+juce::var LumatoneSandboxGameBenchmark::SoakResult::toVar() const
+{
+    juce::DynamicObject::Ptr object = new juce::DynamicObject();
+    object->setProperty("game", gameName);
+    object->setProperty("numCycles", numCycles);
+    object->setProperty("numAllocatedHalfway", numAllocatedHalfway);
+    object->setProperty("numAllocated", numAllocated);
+    object->setProperty("maxInUseAfterEnd", maxInUseAfterEnd);
+    object->setProperty("passed", passed());
+    return juce::var(object.get());
+}
+
+juce::var LumatoneSandboxGameBenchmark::Result::toVar() const
+{
+    juce::DynamicObject::Ptr object = new juce::DynamicObject();
+    object->setProperty("game", gameName);
+    object->setProperty("scenario", scenario);
+    object->setProperty("numTicks", numTicks);
+    object->setProperty("tickMs", tickMs.toVar());
+    object->setProperty("performMs", performMs.toVar());
+    object->setProperty("allocationsPerTick", allocationsPerTick < 0 ? juce::var() : juce::var(allocationsPerTick));
+    object->setProperty("numKeyUpdates", numKeyUpdates);
+    object->setProperty("keyUpdatesPerSecond", keyUpdatesPerSecond);
+    object->setProperty("numMidiMessages", numMidiMessages);
+    return juce::var(object.get());
+}
+
+//==============================================================================
+
+LumatoneSandboxGameBenchmark::LumatoneSandboxGameBenchmark(Options optionsIn)
+    : options(optionsIn)
+    , random(optionsIn.randomSeed)
+    , driver(std::make_unique<LumatoneFirmwareDriver>(LumatoneFirmwareDriver::HostMode::Plugin))
+{
+}
+
+LumatoneSandboxGameBenchmark::~LumatoneSandboxGameBenchmark()
+{
+    jassert(controller == nullptr);
+    driver = nullptr;
+}
+
+juce::Array<LumatoneSandboxGameBenchmark::Result> LumatoneSandboxGameBenchmark::runAll()
+{
+    juce::Array<Result> results;
+
+    RandomColors::Options everyTick;
+    everyTick.nextStepTicks = 1;
+
+    results.add(run([everyTick](LumatoneController* controllerIn) { return new RandomColors(controllerIn, everyTick); },
+                    "Key every tick", nullptr));
+
+    results.add(run([](LumatoneController* controllerIn) { return new HexRings(controllerIn); },
+                    "Note storm", [this](LumatoneSandboxGameBase& game, int) { playNoteStorm(game); }));
+
+    results.add(run([](LumatoneController* controllerIn) { return new HexagonAutomata::Game(controllerIn); },
+                    "Seed pattern, B2/S34", addSeedPattern));
+
+    results.add(run([](LumatoneController* controllerIn)
+    {
+        auto game = new HexagonAutomata::Game(controllerIn);
+        game->setBornSurviveRules(juce::Array<int>({ 2 }), juce::Array<int>({ 3, 4, 5 }));
+        return game;
+    }, "Seed pattern, B2/S345 without a compiled kernel", addSeedPattern));
+
+    results.add(run([](LumatoneController* controllerIn)
+    {
+        auto game = new HexagonAutomata::Game(controllerIn);
+        game->setVirtualField(256, 256);
+        return game;
+    }, "Seed pattern, 256x256 virtual field", addSeedPattern));
+
+    return results;
+}
+
+juce::Array<LumatoneSandboxGameBenchmark::SoakResult> LumatoneSandboxGameBenchmark::soakAll(int numCycles, int ticksPerCycle)
+{
+    juce::Array<SoakResult> results;
+
+    results.add(soak([](LumatoneController* controllerIn) { return new RandomColors(controllerIn); },
+                     nullptr, numCycles, ticksPerCycle));
+
+    results.add(soak([](LumatoneController* controllerIn) { return new HexRings(controllerIn); },
+                     [this](LumatoneSandboxGameBase& game, int) { playNoteStorm(game); }, numCycles, ticksPerCycle));
+
+    results.add(soak([](LumatoneController* controllerIn) { return new HexagonAutomata::Game(controllerIn); },
+                     addSeedPattern, numCycles, ticksPerCycle));
+
+    return results;
+}
+
+void LumatoneSandboxGameBenchmark::createController()
+{
+    controller = std::make_unique<LumatoneController>(LumatoneApplicationState("LumatoneSandboxGameBenchmark", juce::ValueTree(LumatoneStateProperty::StateTree)),
+                                                      *driver, nullptr);
+
+    controller->addEditorListener(this);
+
+    actionPool = std::make_unique<LumatoneSandboxActionPool>(controller.get());
+}
+
+void LumatoneSandboxGameBenchmark::deleteController()
+{
+    actionPool = nullptr;
+
+    controller->removeEditorListener(this);
+    controller = nullptr;
+
+    driver->clearMIDIMessageBuffer();
+}
+
+LumatoneSandboxGameBenchmark::SoakResult LumatoneSandboxGameBenchmark::soak(GameFactory createGame, InputScript script, int numCycles, int ticksPerCycle)
+{
+    createController();
+
+    SoakResult result;
+    result.numCycles = numCycles;
+
+    for (int cycle = 0; cycle < numCycles; cycle++)
+    {
+        if (cycle == numCycles / 2)
+            result.numAllocatedHalfway = actionPool->getNumAllocated();
+
+        std::unique_ptr<LumatoneSandboxGameBase> game(createGame(controller.get()));
+        game->setActionPool(actionPool.get());
+        game->reset(true);
+        performQueuedActions(*game);
+
+        for (int tickNum = 0; tickNum < ticksPerCycle; tickNum++)
+        {
+            if (script)
+                script(*game, tickNum);
+
+            game->nextTick();
+            performQueuedActions(*game);
+            readHostBuffer();
+        }
+
+        // Leave a frame queued when the game ends, as when the engine stops between ticks
+        game->nextTick();
+
+        result.gameName = game->getName();
+        game->end();
+        performQueuedActions(*game);
+        game = nullptr;
+
+        result.maxInUseAfterEnd = juce::jmax(result.maxInUseAfterEnd, actionPool->getNumInUse());
+    }
+
+    result.numAllocated = actionPool->getNumAllocated();
+
+    deleteController();
+
+    return result;
+}
+
+void LumatoneSandboxGameBenchmark::playNoteStorm(LumatoneSandboxGameBase& game)
+{
+    // A few players hitting keys as fast as they can
+    for (int i = 0; i < 8; i++)
+    {
+        game.handleAnyNoteOn(random.nextInt(controller->getNumBoards()) + 1,
+                             random.nextInt(controller->getOctaveBoardSize()),
+                             (juce::uint8)(random.nextInt(127) + 1));
+    }
+}
+
+LumatoneSandboxGameBenchmark::Result LumatoneSandboxGameBenchmark::run(GameFactory createGame, juce::String scenario, InputScript script)
+{
+    createController();
+
+    std::unique_ptr<LumatoneSandboxGameBase> game(createGame(controller.get()));
+    game->setActionPool(actionPool.get());
+    game->reset(true);
+    performQueuedActions(*game);
+
+    juce::Array<double> tickMs;
+    juce::Array<double> performMs;
+    tickMs.ensureStorageAllocated(options.numTicks);
+    performMs.ensureStorageAllocated(options.numTicks);
+
+    juce::int64 numAllocations = 0;
+    int numMidiMessages = 0;
+
+    const int numTotalTicks = options.numWarmupTicks + options.numTicks;
+    for (int tickNum = 0; tickNum < numTotalTicks; tickNum++)
+    {
+        if (tickNum == options.numWarmupTicks)
+        {
+            numKeyUpdates = 0;
+            numMidiMessages = 0;
+        }
+
+        // Input arrives between ticks, so it isn't timed
+        if (script)
+            script(*game, tickNum);
+
+        const auto allocationsBefore = getNumAllocations();
+        const auto tickStart = juce::Time::getHighResolutionTicks();
+
+        game->nextTick();
+
+        const auto tickEnd = juce::Time::getHighResolutionTicks();
+
+        performQueuedActions(*game);
+
+        const auto performEnd = juce::Time::getHighResolutionTicks();
+        const auto allocationsAfter = getNumAllocations();
+
+        numMidiMessages += readHostBuffer();
+
+        if (tickNum < options.numWarmupTicks)
+            continue;
+
+        tickMs.add(ticksToMs(tickEnd - tickStart));
+        performMs.add(ticksToMs(performEnd - tickEnd));
+        numAllocations += allocationsAfter - allocationsBefore;
+    }
+
+    Result result;
+    result.gameName = game->getName();
+    result.scenario = scenario;
+    result.numTicks = options.numTicks;
+    result.tickMs = Percentiles::fromSamples(tickMs);
+    result.performMs = Percentiles::fromSamples(performMs);
+    result.numKeyUpdates = numKeyUpdates;
+    result.keyUpdatesPerSecond = options.numTicks > 0 ? numKeyUpdates * options.fps / options.numTicks : 0;
+    result.numMidiMessages = numMidiMessages;
+
+    if (LUMATONE_SANDBOX_BENCHMARK_COUNT_ALLOCATIONS && options.numTicks > 0)
+        result.allocationsPerTick = (double)numAllocations / options.numTicks;
+
+    // The game releases its queued actions to the pool
+    game = nullptr;
+    deleteController();
+
+    return result;
+}
+
+void LumatoneSandboxGameBenchmark::performQueuedActions(LumatoneSandboxGameBase& game)
+{
+    game.readQueue(actionQueue, numActions);
+
+    controller->beginKeyChangeBatch();
+
+    for (int i = 0; i < numActions; i++)
+    {
+        controller->performAction(actionQueue[i], false);
+        actionPool->release(actionQueue[i]);
+        actionQueue[i] = nullptr;
+    }
+
+    numActions = 0;
+
+    controller->endKeyChangeBatch();
+}
+
+int LumatoneSandboxGameBenchmark::readHostBuffer()
+{
+    driver->readNextBuffer(hostBuffer);
+
+    // No device acknowledges SysEx, so drop what's still waiting to be sent
+    driver->clearMIDIMessageBuffer();
+
+    return hostBuffer.getNumEvents();
+}
+
+void LumatoneSandboxGameBenchmark::keysChanged(const LumatoneKeyChangeSet& changedKeys)
+{
+    numKeyUpdates += changedKeys.getNumKeys();
+}
+
+juce::String LumatoneSandboxGameBenchmark::toJson(const juce::Array<Result>& results, const juce::Array<SoakResult>& soakResults, const Options& options)
+{
+    juce::Array<juce::var> resultVars;
+    for (const auto& result : results)
+        resultVars.add(result.toVar());
+
+    juce::Array<juce::var> soakVars;
+    for (const auto& result : soakResults)
+        soakVars.add(result.toVar());
+
+    juce::DynamicObject::Ptr object = new juce::DynamicObject();
+    object->setProperty("date", juce::Time::getCurrentTime().toISO8601(true));
+   #if JUCE_DEBUG
+    object->setProperty("build", "Debug");
+   #else
+    object->setProperty("build", "Release");
+   #endif
+    object->setProperty("numWarmupTicks", options.numWarmupTicks);
+    object->setProperty("numTicks", options.numTicks);
+    object->setProperty("fps", options.fps);
+    object->setProperty("results", resultVars);
+    object->setProperty("actionPoolSoak", soakVars);
+
+    return juce::JSON::toString(juce::var(object.get()));
+}
+
+int LumatoneSandboxGameBenchmark::runFromCommandLine(const juce::StringArray& args)
+{
+    Options options;
+    juce::String json;
+    int exitCode = 0;
+    {
+        LumatoneSandboxGameBenchmark benchmark(options);
+        auto results = benchmark.runAll();
+        auto soakResults = benchmark.soakAll();
+
+        for (const auto& result : soakResults)
+        {
+            if (!result.passed())
+            {
+                std::cerr << "Action pool soak failed for " << result.gameName << std::endl;
+                exitCode = 1;
+            }
+        }
+
+        json = toJson(results, soakResults, options);
+    }
+
+    if (!writeResults(json, args[0]))
+        exitCode = 1;
+
+    return exitCode;
+}
+
+bool LumatoneSandboxGameBenchmark::writeResults(const juce::String& json, const juce::String& outputPath)
+{
+    auto path = outputPath.unquoted();
+    if (path.isEmpty())
+    {
+        std::cout << json << std::endl;
+        return true;
+    }
+
+    if (!juce::File::getCurrentWorkingDirectory().getChildFile(path).replaceWithText(json))
+    {
+        std::cerr << "Couldn't write benchmark results to " << path << std::endl;
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,181 @@
+/*
+  ==============================================================================
+
+    game_benchmark.h
+    Created: 19 Oct 2026
+    Author:  Vincenzo
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "game_base.h"
+
+class LumatoneController;
+class LumatoneFirmwareDriver;
+class LumatoneSandboxActionPool;
+
+// Counts malloc, calloc, realloc and operator new calls per tick by wrapping malloc at link time
+// and replacing the global operator new and delete, so it's off unless defined for a benchmarking build
+#ifndef LUMATONE_SANDBOX_BENCHMARK_COUNT_ALLOCATIONS
+    #define LUMATONE_SANDBOX_BENCHMARK_COUNT_ALLOCATIONS 0
+#endif
+
+/*
+==============================================================================
+Measures the cost of game ticks without a device or an editor.
+
+Each game runs against its own controller on a plugin hosted firmware driver,
+so layout edits are encoded as they would be for a device. Outgoing MIDI is
+read from the driver every tick as a host would, then the driver's queues are
+cleared since no device acknowledges the SysEx. Ticks run back to back with scripted input, and the time spent
+in nextTick(), which renders the game's frames, is recorded separately from
+performing the queued actions.
+
+The action pool soak starts and ends each game many times on one pool, and
+fails if actions aren't all returned or the pool keeps growing.
+
+Allocations are malloc, calloc, realloc and operator new calls on the
+benchmark thread, so juce::Array, juce::String and other juce::HeapBlock
+growth is counted. They are reported as null unless
+LUMATONE_SANDBOX_BENCHMARK_COUNT_ALLOCATIONS is set, which the console app
+only does where the linker can wrap malloc.
+
+Built as the LumatoneSandboxBenchmark console app, which counts allocations.
+Run it with [output.json] to write the results there, or without arguments
+to write them to stdout. With --layouts first it runs the layout parser
+benchmark instead.
+==============================================================================
+*/
+class LumatoneSandboxGameBenchmark : private LumatoneEditor::EditorListener
+{
+public:
+
+    struct Options
+    {
+        Options() {}
+
+        int numWarmupTicks = 60;
+        int numTicks = 3000;
+
+        // Frame rate used to turn per tick counts into per second rates
+        double fps = 30;
+
+        juce::int64 randomSeed = 0x4c756d61;
+    };
+
+    struct Percentiles
+    {
+        double mean = 0;
+        double p50 = 0;
+        double p90 = 0;
+        double p99 = 0;
+        double max = 0;
+
+        static Percentiles fromSamples(juce::Array<double>& samples);
+        juce::var toVar() const;
+    };
+
+    struct Result
+    {
+        juce::String gameName;
+        juce::String scenario;
+        int numTicks = 0;
+
+        Percentiles tickMs;
+        Percentiles performMs;
+
+        // Negative if allocations weren't counted
+        double allocationsPerTick = -1;
+
+        int numKeyUpdates = 0;
+        double keyUpdatesPerSecond = 0;
+
+        int numMidiMessages = 0;
+
+        juce::var toVar() const;
+    };
+
+    // Games started and ended repeatedly on one action pool
+    struct SoakResult
+    {
+        juce::String gameName;
+        int numCycles = 0;
+
+        // Pool size halfway through and at the end, equal once the pool stops growing
+        int numAllocatedHalfway = 0;
+        int numAllocated = 0;
+
+        // Most actions not returned to the pool after a game ended
+        int maxInUseAfterEnd = 0;
+
+        bool passed() const { return maxInUseAfterEnd == 0 && numAllocated == numAllocatedHalfway; }
+        juce::var toVar() const;
+    };
+
+public:
+
+    LumatoneSandboxGameBenchmark(Options options=Options());
+    ~LumatoneSandboxGameBenchmark() override;
+
+    // Every game with its scripted input
+    juce::Array<Result> runAll();
+
+    // Checks every game gives all its actions back to the pool when it ends, and that
+    // the pool doesn't keep growing over numCycles starts and ends
+    juce::Array<SoakResult> soakAll(int numCycles=200, int ticksPerCycle=90);
+
+    static juce::String toJson(const juce::Array<Result>& results, const juce::Array<SoakResult>& soakResults, const Options& options);
+
+    // Runs everything and writes the JSON to the path in the first argument, or to stdout.
+    // Returns 1 if a soak failed or the results couldn't be written.
+    static int runFromCommandLine(const juce::StringArray& args);
+
+    // Writes the JSON to the path, or to stdout if it's empty. Returns false if the file couldn't be written.
+    static bool writeResults(const juce::String& json, const juce::String& outputPath);
+
+private:
+
+    // Creates the game to run on the benchmark's controller
+    using GameFactory = std::function<LumatoneSandboxGameBase*(LumatoneController* controller)>;
+
+    // Called before each tick with the tick number, including warmup ticks
+    using InputScript = std::function<void(LumatoneSandboxGameBase& game, int tickNum)>;
+
+    Result run(GameFactory createGame, juce::String scenario, InputScript script);
+    SoakResult soak(GameFactory createGame, InputScript script, int numCycles, int ticksPerCycle);
+
+    // Performs the queued actions as one batch like the engine does
+    void performQueuedActions(LumatoneSandboxGameBase& game);
+
+    // Controller and action pool for one run
+    void createController();
+    void deleteController();
+
+    // Random note ons from a few players every tick
+    void playNoteStorm(LumatoneSandboxGameBase& game);
+
+    // Reads the tick's MIDI as a host would and clears the driver's queues.
+    // Returns the number of messages read.
+    int readHostBuffer();
+
+    void keysChanged(const LumatoneKeyChangeSet& changedKeys) override;
+
+private:
+
+    Options options;
+    juce::Random random;
+
+    std::unique_ptr<LumatoneFirmwareDriver> driver;
+    std::unique_ptr<LumatoneController> controller;
+    std::unique_ptr<LumatoneSandboxActionPool> actionPool;
+
+    LumatoneAction* actionQueue[MAX_QUEUE_SIZE];
+    int numActions = 0;
+
+    juce::MidiBuffer hostBuffer;
+    int numKeyUpdates = 0;
+
+    JUCE_DECLARE_NON_COPYABLE(LumatoneSandboxGameBenchmark)
+};
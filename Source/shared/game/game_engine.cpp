@@ -10,20 +10,22 @@
 
 #include "game_engine.h"
 #include "../lumatone_editor_library/LumatoneController.h"
+#include "../debug/LumatoneSandboxLogMacros.h"
 
 LumatoneSandboxGameEngine::LumatoneSandboxGameEngine(LumatoneController* controllerIn, int fps)
     : controller(controllerIn)
+    , actionPool(controllerIn)
     , runGameFps(fps)
     , LumatoneSandboxLogger("GameEngine")
 {
     controller->addMidiListener(this);
-    logInfo("LumatoneSandboxGameEngine", "Game Engine initialized.");
+    LUMATONE_LOG(GAME, INFO, *this, "LumatoneSandboxGameEngine", "Game Engine initialized.");
 }
 
 LumatoneSandboxGameEngine::~LumatoneSandboxGameEngine()
 {
     for (int i = 0; i < numActions; i++)
-        delete actionQueue[i];
+        actionPool.release(actionQueue[i]);
 
     engineListeners.clear();
     game = nullptr;
@@ -35,7 +37,7 @@ const LumatoneSandboxGameBase* LumatoneSandboxGameEngine::getGameRunning() const
     if (gameIsRunning || gameIsPaused)
         return game.get();
 
-    logWarning("getGameRunning", "No game is running.");
+    LUMATONE_LOG(GAME, WARNING, *this, "getGameRunning", "No game is running.");
     return nullptr;
 }
 
@@ -53,8 +55,9 @@ void LumatoneSandboxGameEngine::setGame(LumatoneSandboxGameBase* newGameIn)
 {
     endGame();
     game.reset(newGameIn);
+    game->setActionPool(&actionPool);
 
-    logInfo("setGame", "New game loaded: " + game->getName());
+    LUMATONE_LOG(GAME, INFO, *this, "setGame", "New game loaded: " + game->getName());
 }
 
 bool LumatoneSandboxGameEngine::startGame()
@@ -77,9 +80,10 @@ bool LumatoneSandboxGameEngine::startGame()
         controller->addEditorListener(game.get());
 
         game->reset(true);
+        governor.reset();
         gameIsRunning = true;
 
-        logInfo("startGame", "Starting game " + game->getName());
+        LUMATONE_LOG(GAME, INFO, *this, "startGame", "Starting game " + game->getName());
 
         engineListeners.call(&LumatoneSandboxGameEngine::Listener::gameStarted);
     }
@@ -97,8 +101,9 @@ bool LumatoneSandboxGameEngine::startGame()
         runGameFps = fps;
     }
 
-    logInfo("startGame", "Running at " + juce::String(fps) + " fps / " + juce::String(getTimeIntervalMs()) + "ms.");
+    LUMATONE_LOG(GAME, INFO, *this, "startGame", "Running at " + juce::String(fps) + " fps / " + juce::String(getTimeIntervalMs()) + "ms.");
     
+    nextFrameTimeMs = 0;
     startTimer(getTimeIntervalMs());
     return true;
 }
@@ -120,7 +125,7 @@ void LumatoneSandboxGameEngine::pauseGame()
 
 bool LumatoneSandboxGameEngine::endGame()
 {
-    logInfo("endGame", "Stopping game.");
+    LUMATONE_LOG(GAME, INFO, *this, "endGame", "Stopping game.");
 
     stopTimer();
 
@@ -128,9 +133,16 @@ bool LumatoneSandboxGameEngine::endGame()
 
     if (game != nullptr)
     {
+        LUMATONE_LOG(GAME, INFO, *this, "endGame", "Sustained " + juce::String(governor.getSustainedKeyUpdateRate(), 1) + " key updates/sec, "
+                                                    + juce::String(governor.getNumFramesSkipped()) + " frames skipped, "
+                                                    + juce::String(governor.getNumBackoffs()) + " rate back-offs.");
+        LUMATONE_LOG(GAME, INFO, *this, "endGame", juce::String(actionPool.getNumAllocated()) + " pooled actions allocated, "
+                                                    + juce::String(actionPool.getNumInUse()) + " in use.");
+
         controller->removeMidiListener(game.get());
         controller->removeEditorListener(game.get());
         
+        game->setFrameTime(0);
         game->end();
         processGameActionQueue();
 
@@ -160,13 +172,13 @@ void LumatoneSandboxGameEngine::resetGame()
         game->reset(true);
 
         // DBG("LumatoneSandboxGameEngine: restarted " + game->getName());
-        logInfo("resetGame", "Restarted game.");
+        LUMATONE_LOG(GAME, INFO, *this, "resetGame", "Restarted game.");
 
         engineListeners.call(&LumatoneSandboxGameEngine::Listener::gameStarted);
     }
     else
     {
-        logWarning("resetGame", "Trying to reset with no game loaded.");
+        LUMATONE_LOG(GAME, WARNING, *this, "resetGame", "Trying to reset with no game loaded.");
     }
 }
 
@@ -182,6 +194,19 @@ void LumatoneSandboxGameEngine::advanceFrame()
     }
 }
 
+void LumatoneSandboxGameEngine::updateFrameTime()
+{
+    const double nowMs = juce::Time::getMillisecondCounterHiRes();
+
+    nextFrameTimeMs += getTimeIntervalMs();
+
+    if (std::abs(nextFrameTimeMs - nowMs) > midiScheduleLatencyMs)
+        nextFrameTimeMs = nowMs;
+
+    game->setMidiScheduleLatency(midiScheduleLatencyMs);
+    game->setFrameTime(nextFrameTimeMs + midiScheduleLatencyMs);
+}
+
 void LumatoneSandboxGameEngine::processGameActionQueue()
 {
     game->readQueue(actionQueue, numActions);
@@ -189,15 +214,23 @@ void LumatoneSandboxGameEngine::processGameActionQueue()
     if (numActions == 0)
         return;
 
-    auto title = "Game Action: " + game->getName();
+    // Game updates go in the bulk lane so edits and pings aren't stuck behind them
+    LumatoneController::ScopedKeyUpdatePriority bulkKeyUpdates(*controller, LumatoneFirmware::SendPriority::Bulk);
+
+    // Listeners get one notification for the whole frame
+    controller->beginKeyChangeBatch();
 
     int queueSize = numActions;
     for (int i = 0; i < queueSize; i++)
     {
+        // Not undoable, so ownership stays with the engine
         controller->performAction(actionQueue[i], false);
+        actionPool.release(actionQueue[i]);
         actionQueue[i] = nullptr;
         numActions--;
     }
+
+    controller->endKeyChangeBatch();
 }
 
 void LumatoneSandboxGameEngine::timerCallback()
@@ -208,6 +241,19 @@ void LumatoneSandboxGameEngine::timerCallback()
         return;
     }
 
+    // Skipped frames still take their place on the grid
+    updateFrameTime();
+
+    // Let the device catch up instead of piling more frames onto the queue
+    if (!governor.update(controller->getSendStatistics(), runGameFps, juce::Time::getMillisecondCounterHiRes()))
+    {
+        LUMATONE_LOG_RATE_LIMITED(GAME, VERBOSE, *this, "timerCallback", 1,
+                                  "Skipped frame, " + juce::String(controller->getSendStatistics().queueSize) + " messages queued.");
+        return;
+    }
+
+    game->setKeyUpdateBudget(governor.getUpdateBudget());
+
     advanceFrame();
     processGameActionQueue();
 }
@@ -13,6 +13,8 @@
 #include "../Lumatone_editor_library/listeners/midi_listener.h"
 
 #include "game_base.h"
+#include "frame_governor.h"
+#include "action_pool.h"
 
 #include "../debug/LumatoneSandboxLogger.h"
 
@@ -64,6 +66,19 @@ public:
 
     bool isGameRunning() const { return gameIsRunning; }
 
+    // Delay between a frame's tick and when its MIDI is sent. Frames are scheduled on a fixed
+    // grid, so timer jitter up to this amount doesn't reach the sequenced notes.
+    void setMidiScheduleLatency(double latencyMs) { midiScheduleLatencyMs = latencyMs; }
+    double getMidiScheduleLatency() const { return midiScheduleLatencyMs; }
+
+    // Throttles game frames to the device's measured throughput
+    const LumatoneSandboxFrameGovernor& getFrameGovernor() const { return governor; }
+    double getSustainedKeyUpdateRate() const { return governor.getSustainedKeyUpdateRate(); }
+
+    // Debug counters for game action lifetime, allocations should stop growing once a game is running
+    int getNumActionsAllocated() const { return actionPool.getNumAllocated(); }
+    int getNumActionsInUse() const { return actionPool.getNumInUse(); }
+
 private:
 
     juce::ListenerList<LumatoneSandboxGameEngine::Listener> engineListeners;
@@ -77,6 +92,9 @@ private:
 
     void advanceFrame();
 
+    // Moves the frame time to the next grid point, restarting the grid if the timer drifted too far
+    void updateFrameTime();
+
     void processGameActionQueue();
 
     void timerCallback() override;
@@ -86,14 +104,22 @@ private:
     juce::ApplicationCommandManager* commandManager;
     LumatoneController* controller;
 
+    // Declared before the game, which releases its queued actions here when destroyed
+    LumatoneSandboxActionPool actionPool;
+
     std::unique_ptr<LumatoneSandboxGameBase> game;
 
+    LumatoneSandboxFrameGovernor governor;
+
     LumatoneAction* actionQueue[MAX_QUEUE_SIZE];
     int numActions = 0;
 
     double defaultFps = 30;
     double runGameFps = 30;
 
+    double midiScheduleLatencyMs = 40;
+    double nextFrameTimeMs = 0;
+
     bool gameIsRunning = false;
     bool gameIsPaused = false;
     bool sentFirstGameMessage = false;
@@ -17,6 +17,7 @@ HexRings::HexRings(LumatoneController* controller)
     : LumatoneSandboxGameBase(controller, "Hex Rings")
 {
     hexMap.reset(new LumatoneHexMap(controller->shareMappingData()));
+    currentFrame.ensureStorageAllocated(maxUpdatesPerFrame);
     reset(true);
 }
 
@@ -25,21 +26,70 @@ void HexRings::reset(bool clearQueue)
     LumatoneSandboxGameBase::reset(clearQueue);
     auto layout = getIdentityLayout(true);
     queueLayout(layout);
+
+    buildKeyDiscs();
+}
+
+void HexRings::buildKeyDiscs()
+{
+    auto layout = controller->getMappingData();
+    int numBoards = layout->getNumBoards();
+    discOctaveBoardSize = layout->getOctaveBoardSize();
+
+    int numKeys = numBoards * discOctaveBoardSize;
+    keyDiscs.resize(numKeys);
+
+    juce::Array<Hex::Point> points;
+    points.ensureStorageAllocated(numKeys);
+    for (int keyNum = 0; keyNum < numKeys; keyNum++)
+        points.add(hexMap->keyCoordsToHex(keyNum / discOctaveBoardSize, keyNum % discOctaveBoardSize));
+
+    for (int keyNum = 0; keyNum < numKeys; keyNum++)
+    {
+        auto& disc = keyDiscs.getReference(keyNum);
+        int size = 0;
+
+        // Same order as Hex::Point::neighbors, nearest ring first and without the origin
+        for (int radius = 1; radius <= KeyDisc::maxRadius; radius++)
+        {
+            for (int otherNum = 0; otherNum < numKeys; otherNum++)
+            {
+                if (points.getReference(keyNum).distanceTo(points.getReference(otherNum)) == radius)
+                    disc.keys[size++] = LumatoneKeyCoord(otherNum / discOctaveBoardSize, otherNum % discOctaveBoardSize);
+            }
+
+            disc.numKeysWithin[radius] = size;
+        }
+    }
+}
+
+void HexRings::pushFrame(const Frame& frame)
+{
+    int index = (frameQueueStart + frameQueueSize) % frameQueueCapacity;
+    frameQueue[index] = frame;
+
+    if (frameQueueSize < frameQueueCapacity)
+        frameQueueSize++;
+    else
+        frameQueueStart = (frameQueueStart + 1) % frameQueueCapacity;
 }
 
 void HexRings::nextTick()
 {
-    int limit = juce::jmin(frameQueue.size(), maxQueueFramesPerTick);
-    for (int i = 0; i < limit; i++)
+    int budget = getKeyUpdateLimit(maxQueueFramesPerTick * maxUpdatesPerFrame);
+
+    int limit = juce::jmin(frameQueueSize, maxQueueFramesPerTick);
+    for (int i = 0; i < limit && budget > 0; i++)
     {
-        advanceFrameQueue();
+        advanceFrameQueue(juce::jmin(budget, maxUpdatesPerFrame));
+        budget -= currentFrame.size();
         addToQueue(renderFrame());
     }
 }
 
 LumatoneAction* HexRings::renderFrame() const
 {
-    juce::Array<MappedLumatoneKey> keyUpdates;
+    auto& keyUpdates = getFrameKeyBuffer();
 
     int limit = juce::jmin(currentFrame.size(), maxUpdatesPerFrame);
     for (int i = 0; i < limit; i++)
@@ -60,20 +110,23 @@ LumatoneAction* HexRings::renderFrame() const
     }
 
     if (keyUpdates.size() > 0)
-        return new LumatoneEditAction::MultiKeyAssignAction(controller,  keyUpdates, false, true, false);
+        return createMultiKeyAssignAction(keyUpdates, false, true, false);
 
     return nullptr;
 }
 
-void HexRings::advanceFrameQueue()
+void HexRings::advanceFrameQueue(int maxUpdates)
 {
-    currentFrame.clear();
+    currentFrame.clearQuick();
 
-    int limit = juce::jmin(frameQueue.size(), maxUpdatesPerFrame);
+    int limit = juce::jmin(frameQueueSize, maxUpdates);
     for (int i = 0; i < limit; i++)
     {
-        currentFrame.add(frameQueue.removeAndReturn(0));
+        currentFrame.add(frameQueue[frameQueueStart]);
+        frameQueueStart = (frameQueueStart + 1) % frameQueueCapacity;
     }
+
+    frameQueueSize -= limit;
 }
 
 juce::Colour HexRings::getRandomColourVelocity(juce::uint8 velocity)
@@ -96,15 +149,17 @@ void HexRings::handleAnyNoteOn(int midiChannel, int midiNote, juce::uint8 veloci
     auto colour = getRandomColourVelocity(velocity);
     auto ringSize = getRingSizeVelocity(velocity);
 
-    auto hexOrigin = hexMap->keyCoordsToHex(midiChannel - 1, midiNote);
+    int boardIndex = midiChannel - 1;
+    if (boardIndex < 0 || midiNote < 0 || midiNote >= discOctaveBoardSize)
+        return;
 
-    auto neighbors = hexOrigin.neighbors(ringSize);
-    for (auto point : neighbors)
-    {
-        auto coord = hexMap->hexToKeyCoords(point);
-        if (!controller->getMappingData()->isKeyCoordValid(coord))
-            continue;
+    int keyNum = boardIndex * discOctaveBoardSize + midiNote;
+    if (keyNum >= keyDiscs.size())
+        return;
 
-        frameQueue.add({ coord, true, false, false, velocity, colour });
-    }
+    const auto& disc = keyDiscs.getReference(keyNum);
+    int numKeys = disc.numKeysWithin[juce::jlimit(0, (int)KeyDisc::maxRadius, ringSize)];
+
+    for (int i = 0; i < numKeys; i++)
+        pushFrame({ disc.keys[i], true, false, false, velocity, colour });
 }
\ No newline at end of file
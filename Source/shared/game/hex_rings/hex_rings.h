@@ -27,6 +27,16 @@ public:
         juce::Colour colour;
     };
 
+    // Keys around one key, sorted by distance so any smaller radius is a prefix
+    struct KeyDisc
+    {
+        static constexpr int maxRadius = 4;
+        static constexpr int maxSize = 3 * maxRadius * (maxRadius + 1);
+
+        LumatoneKeyCoord keys[maxSize];
+        int numKeysWithin[maxRadius + 1] = { 0 };
+    };
+
 public:
 
     HexRings(LumatoneController* controllerIn);
@@ -40,7 +50,12 @@ protected:
 
 private:
 
-    void advanceFrameQueue();
+    void advanceFrameQueue(int maxUpdates);
+
+    void buildKeyDiscs();
+
+    // Overwrites the oldest frame when full
+    void pushFrame(const Frame& frame);
 
 public:
     juce::Colour getRandomColourVelocity(juce::uint8 velocity);
@@ -53,11 +68,19 @@ private:
 
     juce::Random random;
 
-    juce::Array<HexRings::Frame> frameQueue;
+    static constexpr int frameQueueCapacity = 1024;
+    Frame frameQueue[frameQueueCapacity];
+    int frameQueueStart = 0;
+    int frameQueueSize = 0;
+
     juce::Array<HexRings::Frame> currentFrame;
     int maxQueueFramesPerTick = 5;
     int maxUpdatesPerFrame = 10;
 
     std::unique_ptr<LumatoneHexMap> hexMap;
 
+    // Indexed by board * octaveBoardSize + key
+    juce::Array<KeyDisc> keyDiscs;
+    int discOctaveBoardSize = 0;
+
 };
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include "../../lumatone_editor_library/actions/edit_actions.h"
 
 #include "../../lumatone_editor_library/color/adjust_layout_colour.h"
+#include "../../debug/LumatoneSandboxLogMacros.h"
 #include "hexagon_automata.h"
 
 HexagonAutomata::Game::Game(LumatoneController* controller)
@@ -41,6 +42,8 @@ void HexagonAutomata::Game::initialize()
 
     if (render.get() == nullptr)
         render.reset(new Renderer);
+
+    updateKernel();
 }
 
 void HexagonAutomata::Game::redoCensus()
@@ -110,7 +113,13 @@ void HexagonAutomata::Game::resetState()
     populatedCells.clear();
     newCells.clear();
 
+    if (virtualField != nullptr)
+        virtualField->clear();
+
     HexagonAutomata::GameState::resetState();    
+
+    // The number of cells may have changed with the layout
+    updateKernel();
 }
 
 void HexagonAutomata::Game::nextTick()
@@ -125,8 +134,11 @@ void HexagonAutomata::Game::nextTick()
     if (ticksToNextCellUpdate >= ticksPerCellUpdate)
     {       
         ticksToNextCellUpdate = 0;
-        // DBG("Update cell states on tick: " + juce::String(ticks));
         updateCellStates();
+
+        LUMATONE_LOG_RATE_LIMITED(AUTOMATA, VERBOSE, logger, "nextTick", 1,
+                                  "Tick " + juce::String(ticks) + ": " + juce::String(populatedCells.size()) + " populated, "
+                                  + juce::String(currentFrameCells.size()) + " to render.");
     }
     else
     {
@@ -136,7 +148,7 @@ void HexagonAutomata::Game::nextTick()
     if (currentFrameCells.size() > 0)
     {
         addToQueue(renderFrame());
-        currentFrameCells.removeRange(0, maxUpdatesPerFrame);
+        currentFrameCells.removeRange(0, getKeyUpdateLimit(maxUpdatesPerFrame));
     }
 
     ticks++;
@@ -183,7 +195,7 @@ bool HexagonAutomata::Game::applyUpdatedCell(const HexagonAutomata::MappedHexSta
     return false;
 }
 
-bool HexagonAutomata::Game::triggerCellMidi(const MappedHexState& cell)
+bool HexagonAutomata::Game::triggerCellMidi(const MappedHexState& cell, double timeMs)
 {
     auto configKey = layoutBeforeStart.readKey(cell.boardIndex, cell.keyIndex);
     if ((configKey->keyType & 0x3) == LumatoneKeyType::disabledDefault)
@@ -191,11 +203,11 @@ bool HexagonAutomata::Game::triggerCellMidi(const MappedHexState& cell)
 
     if (cell.isAlive())
     {
-        controller->sendKeyNoteOn(cell.boardIndex, cell.keyIndex, 0x70);
+        controller->scheduleKeyNoteOn(cell.boardIndex, cell.keyIndex, 0x70, timeMs);
     }
     else
     {
-        controller->sendKeyNoteOff(cell.boardIndex, cell.keyIndex, 0x0);
+        controller->scheduleKeyNoteOff(cell.boardIndex, cell.keyIndex, timeMs);
     }
 
     return true;
@@ -208,8 +220,8 @@ LumatoneAction* HexagonAutomata::Game::renderFrame() const
     if (!l.isLocked())
         return nullptr;
 
-    juce::Array<MappedLumatoneKey> keyUpdates;
-    int limit = juce::jmin(maxUpdatesPerFrame, currentFrameCells.size());
+    auto& keyUpdates = getFrameKeyBuffer();
+    int limit = juce::jmin(getKeyUpdateLimit(maxUpdatesPerFrame), currentFrameCells.size());
 
     for (int i = 0; i < limit; i++)
     {
@@ -231,7 +243,7 @@ LumatoneAction* HexagonAutomata::Game::renderFrame() const
     }
 
     if (keyUpdates.size())
-        return new LumatoneEditAction::MultiKeyAssignAction(controller, keyUpdates, false);
+        return createMultiKeyAssignAction(keyUpdates, false);
 
     return nullptr;
 }
@@ -252,7 +264,7 @@ void HexagonAutomata::Game::addSeed(Hex::Point point, bool triggerMidi)
 
     if (triggerMidi && mode == GameMode::Sequencer)
     {
-        triggerCellMidi(newCell);
+        triggerCellMidi(newCell, getInputTime());
     }
 
     newCells.add(newCell);
@@ -309,7 +321,13 @@ void HexagonAutomata::Game::clearCell(MappedHexState &cell, bool triggerMidi)
 {
     cell.setDead();
     applyUpdatedCell(cell);
-    triggerCellMidi(cell);
+    triggerCellMidi(cell, getInputTime());
+
+    if (virtualField != nullptr)
+    {
+        juce::ScopedLock l(lock);
+        virtualField->setCell(static_cast<Hex::Point>(cell) + viewportOrigin, cell);
+    }
 
     for (int i = 0; i < populatedCells.size(); i++)
     {
@@ -333,7 +351,7 @@ void HexagonAutomata::Game::clearAllCells(bool triggerMidi)
         applyUpdatedCell(cell);
         
         if (triggerMidi)
-            triggerCellMidi(cell);
+            triggerCellMidi(cell, getInputTime());
         
         currentFrameCells.add(cell);
     }
@@ -361,16 +379,23 @@ juce::Colour HexagonAutomata::Game::getDeadColour() const
 
 void HexagonAutomata::Game::setBornSurviveRules(juce::Array<int> bornNums, juce::Array<int> surviveNums)
 {
-    juce::ScopedLock l(lock);
-
-    rules.reset(new BornSurviveRule(bornNums, surviveNums));
+    setRules(new BornSurviveRule(bornNums, surviveNums));
 }
 
 void HexagonAutomata::Game::setBornSurviveRules(juce::String bornInput, juce::String surviveInput)
 {
+    setRules(new BornSurviveRule(bornInput, surviveInput));
+}
+
+void HexagonAutomata::Game::setRules(NeighborFunction* newRules)
+{
+    jassert(newRules != nullptr);
+
     juce::ScopedLock l(lock);
 
-    rules.reset(new BornSurviveRule(bornInput, surviveInput));
+    rules.reset(newRules);
+    updateKernel();
+    updateVirtualFieldRule();
 }
 
 void HexagonAutomata::Game::setNeighborDistance(int distance)
@@ -379,6 +404,152 @@ void HexagonAutomata::Game::setNeighborDistance(int distance)
 
     auto vector = rules->getNeighborsVector(distance);
     neighborsVector.swapWith(vector);
+    neighborDistance = distance;
+
+    updateKernel();
+    updateVirtualFieldRule();
+}
+
+void HexagonAutomata::Game::setGenerationMode(GenerationMode newMode)
+{
+    juce::ScopedLock l(lock);
+
+    generationMode = newMode;
+    ticksToNextSyncCellUpdate = 0;
+
+    updateKernel();
+}
+
+void HexagonAutomata::Game::updateKernel()
+{
+    BornSurviveMasks masks;
+
+    kernel = rules->getBornSurviveMasks(masks)
+           ? findKernel(masks, neighborDistance, generationMode)
+           : nullptr;
+
+    neighborTable.clearQuick();
+
+    if (kernel == nullptr)
+    {
+        LUMATONE_LOG(AUTOMATA, INFO, logger, "updateKernel", "No compiled kernel for rules, using NeighborFunction.");
+        return;
+    }
+
+    neighborTable.ensureStorageAllocated(numCells * neighborsVector.size());
+
+    for (int cellNum = 0; cellNum < numCells; cellNum++)
+    {
+        auto hex = hexMap.keyNumToHex(cellNum);
+        for (auto offset : neighborsVector)
+            neighborTable.add(hexMap.hexToKeyNum(hex + offset));
+    }
+}
+
+bool HexagonAutomata::Game::setVirtualField(int width, int height, int numWorkerThreads)
+{
+    juce::ScopedLock l(lock);
+
+    FieldRule fieldRule;
+    if (!getFieldRule(fieldRule))
+    {
+        LUMATONE_LOG(AUTOMATA, WARNING, logger, "setVirtualField", "The large field only runs born/survive rules up to neighbour distance " + juce::String(FieldRule::maxNeighborDistance) + ", keeping the keyboard field.");
+        return false;
+    }
+
+    // A smaller field would wrap the keyboard onto itself
+    auto keyboardBounds = getKeyboardBounds();
+    width = juce::jmax(width, keyboardBounds.getWidth());
+    height = juce::jmax(height, keyboardBounds.getHeight());
+
+    virtualField = std::make_unique<VirtualField>(width, height, numWorkerThreads);
+    virtualField->setRule(fieldRule);
+
+    viewportOrigin = virtualField->wrap(viewportOrigin);
+
+    // Start from what the keyboard shows
+    for (int cellNum = 0; cellNum < numCells; cellNum++)
+        virtualField->setCell(hexMap.keyNumToHex(cellNum) + viewportOrigin, cells[cellNum]);
+
+    // Pending seeds are added on the next update
+    populatedCells.clear();
+
+    LUMATONE_LOG(AUTOMATA, INFO, logger, "setVirtualField", juce::String(virtualField->getWidth()) + "x" + juce::String(virtualField->getHeight())
+                                                             + " field, " + juce::String(virtualField->getNumTiles()) + " tiles, "
+                                                             + juce::String(virtualField->getNumWorkerThreads()) + " worker threads.");
+    return true;
+}
+
+juce::Rectangle<int> HexagonAutomata::Game::getKeyboardBounds() const
+{
+    juce::Rectangle<int> bounds;
+
+    for (int cellNum = 0; cellNum < numCells; cellNum++)
+    {
+        auto hex = hexMap.keyNumToHex(cellNum);
+        auto hexBounds = juce::Rectangle<int>((int)hex.q, (int)hex.r, 1, 1);
+        bounds = cellNum == 0 ? hexBounds : bounds.getUnion(hexBounds);
+    }
+
+    return bounds;
+}
+
+void HexagonAutomata::Game::clearVirtualField()
+{
+    juce::ScopedLock l(lock);
+
+    virtualField = nullptr;
+    viewportOrigin = Hex::Point();
+    viewportMoved = false;
+
+    // The keyboard cells carry on as the whole game
+    redoCensus();
+}
+
+void HexagonAutomata::Game::setViewportOrigin(Hex::Point origin)
+{
+    juce::ScopedLock l(lock);
+
+    viewportOrigin = virtualField != nullptr ? virtualField->wrap(origin) : origin;
+    viewportMoved = true;
+}
+
+void HexagonAutomata::Game::scrollViewport(int deltaQ, int deltaR)
+{
+    setViewportOrigin(viewportOrigin + Hex::Point(deltaQ, deltaR));
+}
+
+bool HexagonAutomata::Game::getFieldRule(FieldRule& rule) const
+{
+    // The field only evaluates masks, and a wider neighbourhood would be a different game
+    if (neighborDistance < 1 || neighborDistance > FieldRule::maxNeighborDistance)
+        return false;
+
+    rule.neighborDistance = neighborDistance;
+    return rules->getBornSurviveMasks(rule.masks);
+}
+
+bool HexagonAutomata::Game::canUseVirtualField() const
+{
+    FieldRule rule;
+    return getFieldRule(rule);
+}
+
+void HexagonAutomata::Game::updateVirtualFieldRule()
+{
+    if (virtualField == nullptr)
+        return;
+
+    FieldRule fieldRule;
+    if (getFieldRule(fieldRule))
+    {
+        virtualField->setRule(fieldRule);
+        return;
+    }
+
+    // Running something other than the chosen rules would be a different game
+    LUMATONE_LOG(AUTOMATA, WARNING, logger, "updateVirtualFieldRule", "The large field can't run these rules, returning to the keyboard field.");
+    clearVirtualField();
 }
 
 void HexagonAutomata::Game::updateNewCells()
@@ -394,8 +565,20 @@ void HexagonAutomata::Game::updateNewCells()
 
 void HexagonAutomata::Game::updateCellStates()
 {
+    if (virtualField != nullptr)
+    {
+        updateVirtualFieldStates();
+        return;
+    }
+
     updateNewCells();
 
+    if (kernel != nullptr)
+    {
+        updateKernelCellStates();
+        return;
+    }
+
     juce::Array<MappedHexState> cellsToUpdate;
 
     // First, make references to populated cells and empty cells
@@ -522,7 +705,73 @@ void HexagonAutomata::Game::updateCellStates()
         }
     }
 
+    applyCellUpdates(cellsToUpdate);
+}
+
+void HexagonAutomata::Game::updateKernelCellStates()
+{
+    // The kernel reads the cells array, so the population cache is only walked for aging
+    for (auto& cell : populatedCells)
+    {
+        const int cellNum = layout->keyCoordToKeyNum(cell.getKeyCoord());
+        if (cellNum < 0)
+            continue;
+
+        // Seeds reach the array when they first age, after that it holds their health
+        HexState& state = cells.getReference(cellNum);
+        if (cell.age == 0)
+            state = cell;
+
+        state.age++;
+        static_cast<HexState&>(cell) = state;
+    }
+
+    if (generationMode == GenerationMode::Synchronous)
+    {
+        if (ticksToNextSyncCellUpdate >= ticksPerSyncGeneration)
+        {
+            ticksToNextSyncCellUpdate = 0;
+        }
+        else
+        {
+            ticksToNextSyncCellUpdate++;
+            return;
+        }
+    }
+
+    KernelInput input;
+    input.cells = cells.getRawDataPointer();
+    input.numCells = numCells;
+    input.neighborTable = neighborTable.getRawDataPointer();
+    input.numNeighbors = neighborsVector.size();
+    input.ticksPerAsyncGeneration = ticksPerAsyncGeneration;
+
+    kernelOutput.clear(numCells);
+    kernel(input, kernelOutput);
+
+    juce::Array<MappedHexState> cellsToUpdate;
+
+    for (auto cellNum : kernelOutput.diedCells)
+    {
+        auto cell = getMappedCell(cellNum);
+        cell.setDead();
+        cellsToUpdate.add(cell);
+    }
+
+    // Parents are only gathered for births, which are few compared to the cells checked
+    for (auto cellNum : kernelOutput.bornCells)
+    {
+        auto cell = getMappedCell(cellNum);
+        cell.setBorn();
+        cell.HexState::colour = render->renderNewbornColour(getAliveNeighbors(cell, neighborsVector));
+        cellsToUpdate.add(cell);
+    }
+
+    applyCellUpdates(cellsToUpdate);
+}
 
+void HexagonAutomata::Game::applyCellUpdates(const juce::Array<MappedHexState>& cellsToUpdate)
+{
     for (auto cell : cellsToUpdate)
     {
         applyUpdatedCell(cell);
@@ -547,7 +796,8 @@ void HexagonAutomata::Game::updateCellStates()
 
         if (mode == GameMode::Sequencer)
         {
-            triggerCellMidi(cell);
+            // Timed to the frame rather than to when the tick ran
+            triggerCellMidi(cell, getFrameTime());
         }
     }
 
@@ -555,6 +805,62 @@ void HexagonAutomata::Game::updateCellStates()
     currentFrameCells.addArray(cellsToUpdate);
 }
 
+void HexagonAutomata::Game::updateVirtualFieldStates()
+{
+    // Seeds from the keyboard are already shown and triggered
+    for (const auto& cell : newCells)
+    {
+        virtualField->setCell(static_cast<Hex::Point>(cell) + viewportOrigin, cell);
+        applyUpdatedCell(cell);
+        currentFrameCells.add(cell);
+    }
+    newCells.clear();
+
+    bool fieldChanged = false;
+    if (ticksToNextSyncCellUpdate >= ticksPerSyncGeneration)
+    {
+        ticksToNextSyncCellUpdate = 0;
+        virtualField->step();
+        fieldChanged = true;
+    }
+    else
+    {
+        ticksToNextSyncCellUpdate++;
+    }
+
+    if (fieldChanged || viewportMoved)
+    {
+        viewportMoved = false;
+        projectViewport(mode == GameMode::Sequencer);
+    }
+}
+
+void HexagonAutomata::Game::projectViewport(bool triggerMidi)
+{
+    for (int cellNum = 0; cellNum < numCells; cellNum++)
+    {
+        auto fieldState = virtualField->getCell(hexMap.keyNumToHex(cellNum) + viewportOrigin);
+        HexState& shownState = cells.getReference(cellNum);
+
+        const bool wasAlive = shownState.isAlive();
+        const bool changed = fieldState.isAlive() != wasAlive
+                          || fieldState.isDead() != shownState.isDead()
+                          || fieldState.colour != shownState.colour;
+
+        shownState = fieldState;
+
+        // Aging alone isn't rendered
+        if (!changed)
+            continue;
+
+        auto cell = getMappedCell(cellNum);
+        currentFrameCells.add(cell);
+
+        if (triggerMidi && cell.isAlive() != wasAlive)
+            triggerCellMidi(cell, getFrameTime());
+    }
+}
+
 void HexagonAutomata::Game::handleAnyNoteOn(int midiChannel, int midiNote, juce::uint8 velocity)
 {
     auto hexCoord = hexMap.keyCoordsToHex(midiChannel - 1, midiNote);
@@ -568,7 +874,7 @@ void HexagonAutomata::Game::handleAnyNoteOn(int midiChannel, int midiNote, juce:
         addSeed(hexCoord, true);
 }
 
-void HexagonAutomata::Game::completeMappingLoaded(LumatoneLayout layout)
+void HexagonAutomata::Game::completeMappingLoaded(const LumatoneLayout& layout)
 {
     // this is fine because we update via section update actions
     // so this should only be triggered by loading a new layout
@@ -1,9 +1,13 @@
 #pragma once
 
 #include "./hexagon_automata_game_state.h"
+#include "./hexagon_automata_kernels.h"
+#include "./hexagon_automata_virtual_field.h"
 
 #include "../game_base.h"
 
+#include "../../debug/LumatoneSandboxLogger.h"
+
 namespace HexagonAutomata
 {
 class Renderer;
@@ -15,12 +19,6 @@ enum class GameMode
     Sequencer
 };
 
-enum class GenerationMode
-{
-    Synchronous,
-    Asynchronous
-};
-
 class Game : public LumatoneSandboxGameBase
             , private HexagonAutomata::GameState
 {
@@ -43,8 +41,14 @@ public:
     void setBornSurviveRules(juce::Array<int> bornNums, juce::Array<int> surviveNums);
     void setBornSurviveRules(juce::String bornInput, juce::String surviveInput);
     
+    // Takes ownership. Rules without born/survive masks, or ones that weren't compiled, run through the NeighborFunction.
+    void setRules(NeighborFunction* newRules);
+
     void setNeighborDistance(int distance);
 
+    void setGenerationMode(GenerationMode newMode);
+    GenerationMode getGenerationMode() const { return generationMode; }
+
     void updateNewCells();
 
     void setTicksPerSyncGeneration(int ticks);
@@ -54,6 +58,14 @@ public:
 
     double getLockedFps() const { return 0; }
 
+    // Whether the current rules run on a compiled kernel rather than the NeighborFunction
+    bool hasCompiledKernel() const { return kernel != nullptr; }
+
+    // Keyboard cells in key number order
+    int getNumCells() const { return numCells; }
+    const HexState& getCellState(int cellNum) const { return cells.getReference(cellNum); }
+    Hex::Point getCellPoint(int cellNum) const { return hexMap.keyNumToHex(cellNum); }
+
 public:
     void addSeed(Hex::Point coord, bool triggerMidi=true);
     void addSeeds(juce::Array<Hex::Point> seedCoords, bool triggerMidi=true);
@@ -62,15 +74,57 @@ public:
     void clearCell(Hex::Point coord, bool triggerMidi=true);
     void clearCell(MappedHexState& cell, bool triggerMidi=true);
     void clearAllCells(bool triggerMidi=true);
-        
+
+public:
+    // Runs the automata synchronously on a wrapping field of at least width x height cells, with the keyboard
+    // showing the part under the viewport. The field is never smaller than getKeyboardBounds().
+    // numWorkerThreads -1 uses one per core, less one.
+    // Returns false without a field if the rules can't run on it, see canUseVirtualField().
+    bool setVirtualField(int width, int height, int numWorkerThreads=-1);
+    void clearVirtualField();
+    bool hasVirtualField() const { return virtualField != nullptr; }
+
+    // Only born/survive rules within FieldRule::maxNeighborDistance run on the virtual field.
+    // Changing to other rules clears the field.
+    bool canUseVirtualField() const;
+
+    // Field point shown at the keyboard's origin hex
+    void setViewportOrigin(Hex::Point origin);
+    void scrollViewport(int deltaQ, int deltaR);
+    Hex::Point getViewportOrigin() const { return viewportOrigin; }
+
+    // Axial bounding box of the keyboard's hexes, q along x and r along y
+    juce::Rectangle<int> getKeyboardBounds() const;
+
 private:
     void updateCellStates();
 
+    // Runs the compiled kernel for the current rules on the keyboard cells
+    void updateKernelCellStates();
+
+    // Stores cell births and deaths, updates the population cache and triggers midi
+    void applyCellUpdates(const juce::Array<MappedHexState>& cellsToUpdate);
+
+    // Looks up the kernel for the current rules, distance and generation mode and rebuilds the neighbour table
+    void updateKernel();
+
+    // Steps the virtual field once per generation and renders what the viewport shows
+    void updateVirtualFieldStates();
+
+    // Queues the keyboard cells that differ from the field under the viewport
+    void projectViewport(bool triggerMidi);
+
+    // Returns false if the current rules or neighbour distance can't run on the virtual field
+    bool getFieldRule(HexagonAutomata::FieldRule& rule) const;
+
+    // Passes rule changes to the virtual field, or clears it if the new rules can't run on it
+    void updateVirtualFieldRule();
+
 private:
 
     void handleAnyNoteOn(int midiChannel, int midiNote, juce::uint8 velocity) override;
 
-    void completeMappingLoaded(LumatoneLayout layout);
+    void completeMappingLoaded(const LumatoneLayout& layout) override;
 
 private:
 
@@ -78,9 +132,9 @@ private:
     // Returns whether or not cell is still populated
     bool applyUpdatedCell(const MappedHexState& cellUpdate);
 
-    // Produce midi note from cell and send immediately
+    // Produce midi note from cell and send it at timeMs, or immediately if 0
     // Returns whether or not cell can be triggered
-    bool triggerCellMidi(const MappedHexState& cell);
+    bool triggerCellMidi(const MappedHexState& cell, double timeMs=0);
 
 private:
 
@@ -100,6 +154,15 @@ private:
     std::unique_ptr<HexagonAutomata::Renderer> render;
 
     juce::Array<Hex::Point> neighborsVector;
+    int neighborDistance = 1;
+
+    HexagonAutomata::KernelFunction kernel = nullptr;
+    juce::Array<int> neighborTable;
+    HexagonAutomata::KernelOutput kernelOutput;
+
+    std::unique_ptr<HexagonAutomata::VirtualField> virtualField;
+    Hex::Point viewportOrigin;
+    bool viewportMoved = false;
 
     GameMode mode;
     GenerationMode generationMode = GenerationMode::Asynchronous;
@@ -116,7 +179,7 @@ private:
 
     int maxUpdatesPerFrame = 10;
 
-    int verbose = 0;
+    LumatoneSandboxLogger logger { "HexagonAutomata" };
 
     juce::Array<MappedHexState> populatedCells;
 
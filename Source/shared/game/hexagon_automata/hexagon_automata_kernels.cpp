@@ -0,0 +1,80 @@
+/*
+  ==============================================================================
+
+    hexagon_automata_kernels.cpp
+    Created: 19 Oct 2026
+    Author:  Vincenzo
+
+  ==============================================================================
+*/
+
+#include "./hexagon_automata_kernels.h"
+
+namespace
+{
+using HexagonAutomata::GenerationMode;
+
+struct KernelEntry
+{
+    HexagonAutomata::BornSurviveMasks masks;
+    int neighborDistance;
+    GenerationMode mode;
+    HexagonAutomata::KernelFunction step;
+};
+
+template <typename Rule, GenerationMode Mode>
+constexpr KernelEntry makeEntry()
+{
+    return { Rule::masks, Rule::neighborDistance, Mode, &HexagonAutomata::Kernel<Rule, Mode>::step };
+}
+
+template <typename... Rules>
+struct KernelTable
+{
+    static constexpr KernelEntry entries[] =
+    {
+        makeEntry<Rules, GenerationMode::Synchronous>()...,
+        makeEntry<Rules, GenerationMode::Asynchronous>()...
+    };
+};
+
+template <juce::uint64 BornMask, juce::uint64 SurviveMask>
+using Distance1 = HexagonAutomata::BornSurvivePolicy<BornMask, SurviveMask, 1>;
+
+template <juce::uint64 BornMask, juce::uint64 SurviveMask>
+using Distance2 = HexagonAutomata::BornSurvivePolicy<BornMask, SurviveMask, 2>;
+
+using HexagonAutomata::countMask;
+
+// The launcher's default B2/S34 and a few common hexagonal rules, anything else goes through NeighborFunction
+using CompiledKernels = KernelTable<
+    Distance1<countMask({ 2 }), countMask({ 3, 4 })>,
+    Distance1<countMask({ 3 }), countMask({ 2, 3 })>,
+    Distance1<countMask({ 2 }), countMask({ 2 })>,
+    Distance1<countMask({ 2, 4 }), countMask({ 3, 5 })>,
+    Distance2<countMask({ 2 }), countMask({ 3, 4 })>,
+    Distance2<countMask({ 3 }), countMask({ 2, 3 })>,
+    Distance2<countMask({ 4, 5 }), countMask({ 3, 4, 5, 6 })>
+>;
+}
+
+void HexagonAutomata::KernelOutput::clear(int numCells)
+{
+    bornCells.clearQuick();
+    diedCells.clearQuick();
+
+    checkedCells.resize(numCells);
+    checkedCells.fill(false);
+}
+
+HexagonAutomata::KernelFunction HexagonAutomata::findKernel(const BornSurviveMasks& masks, int neighborDistance, GenerationMode mode)
+{
+    for (const auto& entry : CompiledKernels::entries)
+    {
+        if (entry.masks.born == masks.born && entry.masks.survive == masks.survive
+         && entry.neighborDistance == neighborDistance && entry.mode == mode)
+            return entry.step;
+    }
+
+    return nullptr;
+}
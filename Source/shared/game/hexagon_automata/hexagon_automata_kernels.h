@@ -0,0 +1,169 @@
+/*
+  ==============================================================================
+
+    hexagon_automata_kernels.h
+    Created: 19 Oct 2026
+    Author:  Vincenzo
+
+  ==============================================================================
+*/
+
+#ifndef LUMATONE_HEXAGON_AUTOMATA_KERNELS_H
+#define LUMATONE_HEXAGON_AUTOMATA_KERNELS_H
+
+#include "./hexagon_automata_cell_state.h"
+#include "./hexagon_automata_rules.h"
+
+namespace HexagonAutomata
+{
+
+enum class GenerationMode
+{
+    Synchronous,
+    Asynchronous
+};
+
+// Bit n is set for each neighbour count n in the list
+constexpr juce::uint64 countMask(std::initializer_list<int> nums)
+{
+    juce::uint64 mask = 0;
+    for (auto num : nums)
+        mask |= (juce::uint64)1 << num;
+    return mask;
+}
+
+// A born/survive rule as a type, so kernels are compiled for it
+template <juce::uint64 BornMask, juce::uint64 SurviveMask, int NeighborDistance>
+struct BornSurvivePolicy
+{
+    static constexpr BornSurviveMasks masks { BornMask, SurviveMask };
+    static constexpr int neighborDistance = NeighborDistance;
+    static constexpr int numNeighbors = 3 * NeighborDistance * (NeighborDistance + 1);
+};
+
+struct KernelInput
+{
+    const HexState* cells = nullptr;
+    int numCells = 0;
+
+    // numCells rows of cell numbers in Hex::Point::neighbors order, so ring 1 comes first.
+    // -1 where the neighbour is off the keyboard.
+    const int* neighborTable = nullptr;
+    int numNeighbors = 0;
+
+    int ticksPerAsyncGeneration = 1;
+};
+
+// Cell numbers that changed in one step. Kept by the caller so the arrays aren't reallocated each step.
+struct KernelOutput
+{
+    juce::Array<int> bornCells;
+    juce::Array<int> diedCells;
+
+    // Cells already checked for birth this step
+    juce::Array<bool> checkedCells;
+
+    void clear(int numCells);
+};
+
+using KernelFunction = void (*)(const KernelInput& input, KernelOutput& output);
+
+/*
+==============================================================================
+Step functions compiled for a rule type, specialised per generation mode.
+
+Both read only the input cells, so every cell sees the state from before
+the step, and leave applying births and deaths to the caller. The game
+ages populated cells before stepping, as in the NeighborFunction path.
+
+Synchronous checks every cell. Asynchronous only checks living cells whose
+age is a whole number of generations, and births next to them.
+==============================================================================
+*/
+template <typename Rule>
+struct KernelOps
+{
+    static int countAliveNeighbors(const KernelInput& input, int cellNum)
+    {
+        const int* neighbors = input.neighborTable + cellNum * Rule::numNeighbors;
+
+        int numAlive = 0;
+        for (int n = 0; n < Rule::numNeighbors; n++)
+        {
+            if (neighbors[n] >= 0 && input.cells[neighbors[n]].isAlive())
+                numAlive++;
+        }
+
+        return numAlive;
+    }
+
+    static void checkSurvival(const KernelInput& input, KernelOutput& output, int cellNum)
+    {
+        if (!Rule::masks.survives(countAliveNeighbors(input, cellNum)))
+            output.diedCells.add(cellNum);
+    }
+
+    static void checkBirth(const KernelInput& input, KernelOutput& output, int cellNum)
+    {
+        if (Rule::masks.isBorn(countAliveNeighbors(input, cellNum)))
+            output.bornCells.add(cellNum);
+    }
+};
+
+template <typename Rule, GenerationMode Mode>
+struct Kernel;
+
+template <typename Rule>
+struct Kernel<Rule, GenerationMode::Synchronous> : private KernelOps<Rule>
+{
+    static void step(const KernelInput& input, KernelOutput& output)
+    {
+        jassert(input.numNeighbors == Rule::numNeighbors);
+
+        for (int cellNum = 0; cellNum < input.numCells; cellNum++)
+        {
+            if (input.cells[cellNum].isAlive())
+                KernelOps<Rule>::checkSurvival(input, output, cellNum);
+            else
+                KernelOps<Rule>::checkBirth(input, output, cellNum);
+        }
+    }
+};
+
+template <typename Rule>
+struct Kernel<Rule, GenerationMode::Asynchronous> : private KernelOps<Rule>
+{
+    static void step(const KernelInput& input, KernelOutput& output)
+    {
+        jassert(input.numNeighbors == Rule::numNeighbors);
+
+        const int ticksPerGeneration = input.ticksPerAsyncGeneration;
+
+        for (int cellNum = 0; cellNum < input.numCells; cellNum++)
+        {
+            const HexState& cell = input.cells[cellNum];
+            if (!cell.isAlive() || cell.age < ticksPerGeneration || cell.age % ticksPerGeneration != 0)
+                continue;
+
+            KernelOps<Rule>::checkSurvival(input, output, cellNum);
+
+            const int* adjacent = input.neighborTable + cellNum * Rule::numNeighbors;
+            for (int n = 0; n < 6; n++)
+            {
+                const int adjacentNum = adjacent[n];
+                if (adjacentNum < 0 || output.checkedCells.getUnchecked(adjacentNum) || input.cells[adjacentNum].isAlive())
+                    continue;
+
+                output.checkedCells.setUnchecked(adjacentNum, true);
+                KernelOps<Rule>::checkBirth(input, output, adjacentNum);
+            }
+        }
+    }
+};
+
+// Returns the compiled kernel for the rule, or nullptr if it wasn't compiled
+KernelFunction findKernel(const BornSurviveMasks& masks, int neighborDistance, GenerationMode mode);
+
+}
+
+#endif // LUMATONE_HEXAGON_AUTOMATA_KERNELS_H
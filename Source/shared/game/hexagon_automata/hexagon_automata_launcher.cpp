@@ -83,6 +83,7 @@ HexagonAutomataComponent::HexagonAutomataComponent(LumatoneSandboxGameEngine* ga
     distanceSlider->onValueChange = [&]
     {
         game->setNeighborDistance(distanceSlider->getValue());
+        updateVirtualFieldControls();
     };
     addAndMakeVisible(*distanceSlider);
 
@@ -91,6 +92,34 @@ HexagonAutomataComponent::HexagonAutomataComponent(LumatoneSandboxGameEngine* ga
     distanceLabel->attachToComponent(distanceSlider.get(), true);
     addAndMakeVisible(*distanceLabel);
 
+    virtualFieldToggle = std::make_unique<juce::ToggleButton>("Large Field");
+    virtualFieldToggle->setTooltip("Run on a " + juce::String(virtualFieldSize) + "x" + juce::String(virtualFieldSize)
+                                   + " wrapping field, with the keyboard showing part of it");
+    virtualFieldToggle->onClick = [&]
+    {
+        onVirtualFieldToggled();
+    };
+    addAndMakeVisible(*virtualFieldToggle);
+
+    auto addScrollButton = [&](juce::String text, int deltaQ, int deltaR)
+    {
+        auto button = std::make_unique<juce::TextButton>(text, "Scroll the field under the keyboard");
+        button->onClick = [this, deltaQ, deltaR]
+        {
+            game->scrollViewport(deltaQ, deltaR);
+        };
+        button->setEnabled(false);
+        addAndMakeVisible(*button);
+        return button;
+    };
+
+    scrollLeftButton = addScrollButton("-Q", -1, 0);
+    scrollRightButton = addScrollButton("+Q", 1, 0);
+    scrollUpButton = addScrollButton("-R", 0, -1);
+    scrollDownButton = addScrollButton("+R", 0, 1);
+
+    updateVirtualFieldControls();
+
     aliveColourSelector = std::make_unique<CustomPickerPanel>();
     aliveColourSelector->setCurrentColour(game->getAliveColour());
     aliveColourSelector->addColourSelectionListener(this);
@@ -116,6 +145,12 @@ HexagonAutomataComponent::~HexagonAutomataComponent()
 { 
     game = nullptr;
 
+    scrollDownButton = nullptr;
+    scrollUpButton = nullptr;
+    scrollRightButton = nullptr;
+    scrollLeftButton = nullptr;
+    virtualFieldToggle = nullptr;
+
     genSpeedSlider = nullptr;
     addSeedButton = nullptr;
 }
@@ -131,6 +166,7 @@ void HexagonAutomataComponent::resized()
         HexagonAutomataComponent::Parameter::BornRule,
         HexagonAutomataComponent::Parameter::SurviveRule,
         HexagonAutomataComponent::Parameter::NeighborDistance,
+        HexagonAutomataComponent::Parameter::VirtualField,
         HexagonAutomataComponent::Parameter::AliveColour,
         HexagonAutomataComponent::Parameter::DeadColour
     };
@@ -247,6 +283,12 @@ void HexagonAutomataComponent::resized()
             gItem.associatedComponent = distanceSlider.get();
             gItem.width = textLength * 2;
             break;
+        case HexagonAutomataComponent::Parameter::VirtualField:
+            gItem.margin.left = 0;
+            gItem.height = buttonHeight;
+            gItem.width = addLength;
+            gItem.associatedComponent = virtualFieldToggle.get();
+            break;
         }
 
         controlsBox.items.add(item.withWidth(controlsWidth).withHeight(controlHeight));
@@ -290,6 +332,12 @@ void HexagonAutomataComponent::resized()
 
     distanceSlider->setTextBoxStyle(juce::Slider::TextEntryBoxPosition::TextBoxLeft, false, distanceSlider->getWidth() * 0.4f, distanceSlider->getHeight());
 
+    int scrollButtonWidth = buttonFont.getStringWidth("+Q_") * 1.5f;
+    scrollLeftButton->setBounds(virtualFieldToggle->getRight() + margin, virtualFieldToggle->getY(), scrollButtonWidth, buttonHeight);
+    scrollRightButton->setBounds(scrollLeftButton->getRight(), scrollLeftButton->getY(), scrollButtonWidth, buttonHeight);
+    scrollUpButton->setBounds(scrollRightButton->getRight() + margin, scrollLeftButton->getY(), scrollButtonWidth, buttonHeight);
+    scrollDownButton->setBounds(scrollUpButton->getRight(), scrollLeftButton->getY(), scrollButtonWidth, buttonHeight);
+
 
     juce::Grid coloursGrid;
     coloursGrid.items.add(juce::GridItem(aliveColourSelector.get()).withWidth(selectorWidth).withHeight(flexArea.getHeight()).withAlignSelf(juce::GridItem::AlignSelf::stretch));
@@ -335,4 +383,26 @@ void HexagonAutomataComponent::colourChangedCallback(ColourSelectionBroadcaster*
 void HexagonAutomataComponent::onRulesChange()
 {
     game->setBornSurviveRules(bornRuleInput->getText(), suviveRuleInput->getText());
+    updateVirtualFieldControls();
+}
+
+void HexagonAutomataComponent::onVirtualFieldToggled()
+{
+    if (virtualFieldToggle->getToggleState())
+        game->setVirtualField(virtualFieldSize, virtualFieldSize);
+    else
+        game->clearVirtualField();
+
+    updateVirtualFieldControls();
+}
+
+void HexagonAutomataComponent::updateVirtualFieldControls()
+{
+    // The game refuses or clears the field for rules it can't run
+    const bool useVirtualField = game->hasVirtualField();
+    virtualFieldToggle->setToggleState(useVirtualField, juce::dontSendNotification);
+    virtualFieldToggle->setEnabled(useVirtualField || game->canUseVirtualField());
+
+    for (auto button : { scrollLeftButton.get(), scrollRightButton.get(), scrollUpButton.get(), scrollDownButton.get() })
+        button->setEnabled(useVirtualField);
 }
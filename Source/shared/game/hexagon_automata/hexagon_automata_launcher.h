@@ -29,6 +29,7 @@ class HexagonAutomataComponent  : public LumatoneSandboxGameComponent
         BornRule,
         SurviveRule,
         NeighborDistance,
+        VirtualField,
         AliveColour,
         DeadColour
     };
@@ -52,6 +53,10 @@ public:
 private:
 
     void onRulesChange();
+    void onVirtualFieldToggled();
+
+    // Matches the large field toggle and scroll buttons to whether the game is running one
+    void updateVirtualFieldControls();
 
 private:
     
@@ -73,6 +78,12 @@ private:
     std::unique_ptr<juce::Slider> distanceSlider;
     std::unique_ptr<juce::Label> distanceLabel;
 
+    std::unique_ptr<juce::ToggleButton> virtualFieldToggle;
+    std::unique_ptr<juce::TextButton> scrollLeftButton;
+    std::unique_ptr<juce::TextButton> scrollRightButton;
+    std::unique_ptr<juce::TextButton> scrollUpButton;
+    std::unique_ptr<juce::TextButton> scrollDownButton;
+
     std::unique_ptr<CustomPickerPanel> aliveColourSelector;
     std::unique_ptr<juce::Label> aliveColourLabel;
 
@@ -81,6 +92,8 @@ private:
 
     float marginScalar = 0.1f;
 
+    static constexpr int virtualFieldSize = 256;
+
     juce::Rectangle<int> flexArea;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (HexagonAutomataComponent)
@@ -38,6 +38,27 @@ static juce::Array<int> ParseListArgument(juce::String numberList)
 }
 
 
+bool HexagonAutomata::BornSurviveMasks::fromCounts(const juce::Array<int>& bornNums, const juce::Array<int>& surviveNums, BornSurviveMasks& masks)
+{
+    masks = BornSurviveMasks();
+
+    for (auto num : bornNums)
+    {
+        if (!canRepresent(num))
+            return false;
+        masks.born |= (juce::uint64)1 << num;
+    }
+
+    for (auto num : surviveNums)
+    {
+        if (!canRepresent(num))
+            return false;
+        masks.survive |= (juce::uint64)1 << num;
+    }
+
+    return true;
+}
+
 juce::Array<Hex::Point> HexagonAutomata::NeighborFunction::getNeighborsVector(int distance) const 
 { 
     return Hex::Point().neighbors(distance); 
@@ -45,16 +66,18 @@ juce::Array<Hex::Point> HexagonAutomata::NeighborFunction::getNeighborsVector(in
 
 float HexagonAutomata::DefaultNeighborFunction::getLifeFactor(const HexagonAutomata::MappedHexState& origin, const HexagonAutomata::MappedHexState* neighbors, int numNeighbors) const
 {
-    if (numNeighbors < 2 || numNeighbors > 3)
-        return 0.0f;
-    return 1.0f;
+    return masks.survives(numNeighbors) ? 1.0f : 0.0f;
 }
 
 bool HexagonAutomata::DefaultNeighborFunction::generateNewLife(const HexagonAutomata::MappedHexState& origin, const HexagonAutomata::MappedHexState* neighbors, int numNeighbors) const
 {
-    if (numNeighbors == 3)
-        return true;
-    return false;
+    return masks.isBorn(numNeighbors);
+}
+
+bool HexagonAutomata::DefaultNeighborFunction::getBornSurviveMasks(BornSurviveMasks& masksOut) const
+{
+    masksOut = masks;
+    return true;
 }
 
 HexagonAutomata::BornSurviveRule::BornSurviveRule(int numBorn, int surviveLower, int surviveUpper)
@@ -62,31 +85,39 @@ HexagonAutomata::BornSurviveRule::BornSurviveRule(int numBorn, int surviveLower,
     numsBorn.add(numBorn);
     numsSurvive.add(surviveLower);
     numsSurvive.add(surviveUpper);
+
+    hasMasks = BornSurviveMasks::fromCounts(numsBorn, numsSurvive, masks);
 }
 
 HexagonAutomata::BornSurviveRule::BornSurviveRule(juce::Array<int> bornNums, juce::Array<int> surviveNums)
     : numsBorn(bornNums)
     , numsSurvive(surviveNums) 
 {
+    hasMasks = BornSurviveMasks::fromCounts(numsBorn, numsSurvive, masks);
 }
 
 HexagonAutomata::BornSurviveRule::BornSurviveRule(juce::String bornString, juce::String surviveString)
 {
     numsBorn = ParseListArgument(bornString);
     numsSurvive = ParseListArgument(surviveString);
+
+    hasMasks = BornSurviveMasks::fromCounts(numsBorn, numsSurvive, masks);
 }
 
 float HexagonAutomata::BornSurviveRule::getLifeFactor(const HexagonAutomata::MappedHexState& origin, const HexagonAutomata::MappedHexState* neighbors, int numNeighbors) const
 {
-    if (numsSurvive.contains(numNeighbors))
-        return 1.0f;
-    return 0.0f;
+    const bool survives = hasMasks ? masks.survives(numNeighbors) : numsSurvive.contains(numNeighbors);
+    return survives ? 1.0f : 0.0f;
 }
 
 bool HexagonAutomata::BornSurviveRule::generateNewLife(const HexagonAutomata::MappedHexState& origin, const HexagonAutomata::MappedHexState* neighbors, int numNeighbors) const
 {
-    if (numsBorn.contains(numNeighbors))
-        return true;
-    return false;
+    return hasMasks ? masks.isBorn(numNeighbors) : numsBorn.contains(numNeighbors);
 }
 
+bool HexagonAutomata::BornSurviveRule::getBornSurviveMasks(BornSurviveMasks& masksOut) const
+{
+    // Counts past 63 can't be represented, leave those to the virtual functions
+    masksOut = masks;
+    return hasMasks;
+}
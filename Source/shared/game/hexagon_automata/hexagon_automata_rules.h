@@ -20,18 +20,45 @@ namespace HexagonAutomata
 
 struct MappedHexState;
 
+// Born/survive counts as masks, bit n is set if n living neighbours qualify.
+// BornSurviveRule, the compiled kernels and the virtual field all evaluate rules through this.
+struct BornSurviveMasks
+{
+    juce::uint64 born = 0;
+    juce::uint64 survive = 0;
+
+    // Counts outside [0, 64) can't be represented
+    static constexpr bool canRepresent(int numAlive) { return numAlive >= 0 && numAlive < 64; }
+    static constexpr bool isCounted(juce::uint64 mask, int numAlive) { return canRepresent(numAlive) && (mask & ((juce::uint64)1 << numAlive)) != 0; }
+
+    constexpr bool isBorn(int numAlive) const { return isCounted(born, numAlive); }
+    constexpr bool survives(int numAlive) const { return isCounted(survive, numAlive); }
+
+    // Returns false if a count can't be represented
+    static bool fromCounts(const juce::Array<int>& bornNums, const juce::Array<int>& surviveNums, BornSurviveMasks& masks);
+};
+
 struct NeighborFunction 
 {
     virtual juce::Array<Hex::Point> getNeighborsVector(int distance=1) const;
 
     virtual float getLifeFactor(const MappedHexState& origin, const MappedHexState* neighbors, int numNeighbors) const = 0;
     virtual bool generateNewLife(const MappedHexState& origin, const MappedHexState* neighbors, int numNeighbors) const = 0;
+
+    // Rules that only depend on the number of living neighbours fill in their masks, so they
+    // can run on a compiled kernel or the virtual field. Other rules return false.
+    virtual bool getBornSurviveMasks(BornSurviveMasks& masks) const { return false; }
 };
 
 struct DefaultNeighborFunction : public NeighborFunction
 {
     virtual float getLifeFactor(const MappedHexState&, const MappedHexState*, int) const override;
     virtual bool generateNewLife(const MappedHexState&, const MappedHexState*, int) const override;
+
+    virtual bool getBornSurviveMasks(BornSurviveMasks& masks) const override;
+
+    // B3/S23
+    static constexpr BornSurviveMasks masks { (juce::uint64)1 << 3, ((juce::uint64)1 << 2) | ((juce::uint64)1 << 3) };
 };
 
 struct BornSurviveRule : public NeighborFunction
@@ -45,6 +72,13 @@ struct BornSurviveRule : public NeighborFunction
 
     virtual float getLifeFactor(const MappedHexState& origin, const MappedHexState* neighbors, int numNeighbors) const override;
     virtual bool generateNewLife(const MappedHexState& origin, const MappedHexState* neighbors, int numNeighbors) const override;
+
+    virtual bool getBornSurviveMasks(BornSurviveMasks& masks) const override;
+
+private:
+    // Set by the constructors, the lists are only evaluated directly if a count can't be a mask
+    BornSurviveMasks masks;
+    bool hasMasks = false;
 };
 
 }
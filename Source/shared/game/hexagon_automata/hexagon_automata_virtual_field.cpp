@@ -0,0 +1,239 @@
+/*
+  ==============================================================================
+
+    hexagon_automata_virtual_field.cpp
+    Created: 19 Oct 2026
+    Author:  Vincenzo
+
+  ==============================================================================
+*/
+
+#include "./hexagon_automata_virtual_field.h"
+
+static int getDefaultNumWorkerThreads()
+{
+    return juce::jmax(0, juce::SystemStats::getNumCpus() - 1);
+}
+
+HexagonAutomata::FieldRule HexagonAutomata::FieldRule::fromBornSurvive(const juce::Array<int>& bornNums, const juce::Array<int>& surviveNums, int neighborDistance)
+{
+    FieldRule rule;
+    rule.neighborDistance = juce::jlimit(1, maxNeighborDistance, neighborDistance);
+
+    const bool representable = BornSurviveMasks::fromCounts(bornNums, surviveNums, rule.masks);
+    jassert(representable);
+    juce::ignoreUnused(representable);
+
+    return rule;
+}
+
+HexagonAutomata::VirtualField::Cell HexagonAutomata::VirtualField::Cell::fromHexState(const HexState& state)
+{
+    Cell cell;
+    cell.health = state.health;
+    cell.age = (juce::uint32)juce::jmax(0, state.age);
+    cell.argb = state.colour.getARGB();
+    return cell;
+}
+
+//==============================================================================
+
+HexagonAutomata::VirtualField::VirtualField(int widthIn, int heightIn, int numWorkerThreadsIn)
+    : width(juce::jmax(1, (widthIn + tileSize - 1) / tileSize) * tileSize)
+    , height(juce::jmax(1, (heightIn + tileSize - 1) / tileSize) * tileSize)
+    , numTilesQ(width / tileSize)
+    , numTilesR(height / tileSize)
+    , numWorkerThreads(numWorkerThreadsIn < 0 ? getDefaultNumWorkerThreads() : numWorkerThreadsIn)
+    , workers(juce::jmax(1, numWorkerThreads))
+{
+    current.calloc((size_t)getNumCells());
+    next.calloc((size_t)getNumCells());
+
+    clear();
+    setRule(FieldRule::fromBornSurvive({ 2 }, { 3, 4 }));
+}
+
+HexagonAutomata::VirtualField::~VirtualField()
+{
+    workers.removeAllJobs(true, 10000);
+}
+
+void HexagonAutomata::VirtualField::setRule(const FieldRule& ruleIn)
+{
+    rule = ruleIn;
+    rule.neighborDistance = juce::jlimit(1, FieldRule::maxNeighborDistance, rule.neighborDistance);
+
+    neighborQ.clearQuick();
+    neighborR.clearQuick();
+
+    for (auto point : Hex::Point().neighbors(rule.neighborDistance))
+    {
+        neighborQ.add(juce::roundToInt(point.q));
+        neighborR.add(juce::roundToInt(point.r));
+    }
+}
+
+Hex::Point HexagonAutomata::VirtualField::wrap(Hex::Point point) const
+{
+    int q = juce::roundToInt(point.q) % width;
+    int r = juce::roundToInt(point.r) % height;
+    return Hex::Point(q < 0 ? q + width : q, r < 0 ? r + height : r);
+}
+
+HexagonAutomata::HexState HexagonAutomata::VirtualField::getCell(Hex::Point point) const
+{
+    auto wrapped = wrap(point);
+    return current[toIndex((int)wrapped.q, (int)wrapped.r)].toHexState();
+}
+
+void HexagonAutomata::VirtualField::setCell(Hex::Point point, const HexState& state)
+{
+    auto wrapped = wrap(point);
+    current[toIndex((int)wrapped.q, (int)wrapped.r)] = Cell::fromHexState(state);
+}
+
+void HexagonAutomata::VirtualField::clear()
+{
+    for (int i = 0; i < getNumCells(); i++)
+        current[i] = Cell();
+
+    generation = 0;
+    numAlive = 0;
+}
+
+void HexagonAutomata::VirtualField::addRandomSeeds(int numSeeds, float probability, juce::Colour colour, juce::Random& random)
+{
+    HexState seed(1.0f, 0, colour);
+
+    for (int i = 0; i < numSeeds; i++)
+    {
+        const int q = random.nextInt(width);
+        const int r = random.nextInt(height);
+
+        if (random.nextFloat() <= probability)
+            setCell(Hex::Point(q, r), seed);
+
+        for (int n = 0; n < neighborQ.size(); n++)
+        {
+            if (random.nextFloat() <= probability)
+                setCell(Hex::Point(q + neighborQ[n], r + neighborR[n]), seed);
+        }
+    }
+}
+
+void HexagonAutomata::VirtualField::step()
+{
+    nextTileToStep.store(0);
+    numAliveInStep.store(0);
+
+    // No point waking threads for tiles the caller would finish first
+    const int numJobs = juce::jmin(numWorkerThreads, getNumTiles() - 1);
+    numJobsRunning.store(numJobs);
+
+    for (int i = 0; i < numJobs; i++)
+    {
+        workers.addJob([this]()
+        {
+            stepTiles();
+
+            if (numJobsRunning.fetch_sub(1) == 1)
+                jobsFinished.signal();
+
+            return juce::ThreadPoolJob::jobHasFinished;
+        });
+    }
+
+    stepTiles();
+
+    if (numJobs > 0)
+        jobsFinished.wait();
+
+    current.swapWith(next);
+
+    generation++;
+    numAlive = numAliveInStep.load();
+}
+
+void HexagonAutomata::VirtualField::stepTiles()
+{
+    const int numTiles = getNumTiles();
+
+    int numAliveInTiles = 0;
+    for (int tileIndex = nextTileToStep.fetch_add(1); tileIndex < numTiles; tileIndex = nextTileToStep.fetch_add(1))
+        numAliveInTiles += stepTile(tileIndex);
+
+    numAliveInStep.fetch_add(numAliveInTiles);
+}
+
+int HexagonAutomata::VirtualField::stepTile(int tileIndex)
+{
+    const int tileQ = (tileIndex % numTilesQ) * tileSize;
+    const int tileR = (tileIndex / numTilesQ) * tileSize;
+
+    const int numNeighbors = neighborQ.size();
+    const int* offsetsQ = neighborQ.getRawDataPointer();
+    const int* offsetsR = neighborR.getRawDataPointer();
+
+    // Tiles are contiguous, so the tile's cells are written in order
+    Cell* nextCell = next + tileIndex * tileSize * tileSize;
+
+    int numAliveInTile = 0;
+    for (int r = tileR; r < tileR + tileSize; r++)
+    {
+        for (int q = tileQ; q < tileQ + tileSize; q++, nextCell++)
+        {
+            Cell cell = current[toIndex(q, r)];
+
+            int numAliveNeighbors = 0;
+            for (int n = 0; n < numNeighbors; n++)
+            {
+                if (current[toIndex(wrapQ(q + offsetsQ[n]), wrapR(r + offsetsR[n]))].isAlive())
+                    numAliveNeighbors++;
+            }
+
+            if (cell.isAlive())
+            {
+                cell.age++;
+
+                if (!rule.masks.survives(numAliveNeighbors))
+                    cell.health = 0.0f;
+            }
+            else if (rule.masks.isBorn(numAliveNeighbors))
+            {
+                cell.health = 1.0f;
+                cell.age = 0;
+                cell.argb = getNewbornColour(q, r);
+            }
+
+            if (cell.isAlive())
+                numAliveInTile++;
+
+            *nextCell = cell;
+        }
+    }
+
+    return numAliveInTile;
+}
+
+juce::uint32 HexagonAutomata::VirtualField::getNewbornColour(int q, int r) const
+{
+    juce::uint32 red = 0, green = 0, blue = 0, numParents = 0;
+
+    for (int n = 0; n < neighborQ.size(); n++)
+    {
+        const Cell& neighbor = current[toIndex(wrapQ(q + neighborQ[n]), wrapR(r + neighborR[n]))];
+        if (!neighbor.isAlive())
+            continue;
+
+        auto colour = juce::Colour(neighbor.argb);
+        red += colour.getRed();
+        green += colour.getGreen();
+        blue += colour.getBlue();
+        numParents++;
+    }
+
+    if (numParents == 0)
+        return 0xffffffff;
+
+    return juce::Colour((juce::uint8)(red / numParents), (juce::uint8)(green / numParents), (juce::uint8)(blue / numParents)).getARGB();
+}
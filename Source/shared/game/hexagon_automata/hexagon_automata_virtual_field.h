@@ -0,0 +1,139 @@
+/*
+  ==============================================================================
+
+    hexagon_automata_virtual_field.h
+    Created: 19 Oct 2026
+    Author:  Vincenzo
+
+  ==============================================================================
+*/
+
+#ifndef LUMATONE_HEXAGON_AUTOMATA_VIRTUAL_FIELD_H
+#define LUMATONE_HEXAGON_AUTOMATA_VIRTUAL_FIELD_H
+
+#include "./hexagon_automata_cell_state.h"
+#include "./hexagon_automata_rules.h"
+
+namespace HexagonAutomata
+{
+
+// Born/survive rule in the form the virtual field evaluates
+struct FieldRule
+{
+    static constexpr int maxNeighborDistance = 4;
+
+    BornSurviveMasks masks;
+    int neighborDistance = 1;
+
+    static FieldRule fromBornSurvive(const juce::Array<int>& bornNums, const juce::Array<int>& surviveNums, int neighborDistance=1);
+};
+
+/*
+==============================================================================
+Hexagon automata state for a field larger than the keyboard.
+
+The field is a parallelogram in axial coordinates that wraps around at the
+edges, stored in square tiles so each tile's cells are contiguous. Each step
+computes the whole next generation from the current one into a second
+buffer and then swaps them, so the result doesn't depend on the order cells
+are visited. Tiles are handed out to worker threads as they ask for them,
+with the calling thread working through tiles as well.
+
+Cells follow the HexState conventions: alive cells age each generation and
+keep their age when they die, born cells take the mean colour of their
+living neighbours.
+==============================================================================
+*/
+class VirtualField
+{
+public:
+    struct Cell
+    {
+        float health = 0.0f;
+        juce::uint32 age = 0;
+        juce::uint32 argb = 0xffffffff;
+
+        bool isAlive() const { return health > 0.0f; }
+
+        HexState toHexState() const { return HexState(health, (int)age, juce::Colour(argb)); }
+        static Cell fromHexState(const HexState& state);
+    };
+
+    // Cells per tile side
+    static constexpr int tileSize = 16;
+
+public:
+    // The size is rounded up to whole tiles. numWorkerThreads -1 uses one per core, less one for the calling thread.
+    VirtualField(int width, int height, int numWorkerThreads=-1);
+    ~VirtualField();
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    int getNumCells() const { return width * height; }
+    int getNumTiles() const { return numTilesQ * numTilesR; }
+    int getNumWorkerThreads() const { return numWorkerThreads; }
+
+    void setRule(const FieldRule& ruleIn);
+    const FieldRule& getRule() const { return rule; }
+
+    // Field points outside [0, width) x [0, height) wrap around
+    Hex::Point wrap(Hex::Point point) const;
+
+    HexState getCell(Hex::Point point) const;
+    void setCell(Hex::Point point, const HexState& state);
+
+    void clear();
+    void addRandomSeeds(int numSeeds, float probability, juce::Colour colour, juce::Random& random);
+
+    // Computes the next generation, not thread safe with the other methods
+    void step();
+
+    int getGeneration() const { return generation; }
+    int getNumAlive() const { return numAlive; }
+
+private:
+    int wrapQ(int q) const { return q < 0 ? q + width : (q >= width ? q - width : q); }
+    int wrapR(int r) const { return r < 0 ? r + height : (r >= height ? r - height : r); }
+
+    // q and r must already be wrapped
+    int toIndex(int q, int r) const
+    {
+        const int tileIndex = (r / tileSize) * numTilesQ + (q / tileSize);
+        return tileIndex * tileSize * tileSize + (r % tileSize) * tileSize + (q % tileSize);
+    }
+
+    // Steps tiles until none are left, from any thread
+    void stepTiles();
+    int stepTile(int tileIndex);
+
+    juce::uint32 getNewbornColour(int q, int r) const;
+
+private:
+    int width = 0;
+    int height = 0;
+    int numTilesQ = 0;
+    int numTilesR = 0;
+
+    juce::HeapBlock<Cell> current;
+    juce::HeapBlock<Cell> next;
+
+    FieldRule rule;
+    juce::Array<int> neighborQ;
+    juce::Array<int> neighborR;
+
+    const int numWorkerThreads;
+    juce::ThreadPool workers;
+    std::atomic<int> nextTileToStep { 0 };
+    std::atomic<int> numAliveInStep { 0 };
+    std::atomic<int> numJobsRunning { 0 };
+    juce::WaitableEvent jobsFinished;
+
+    int generation = 0;
+    int numAlive = 0;
+
+    JUCE_DECLARE_NON_COPYABLE(VirtualField)
+};
+
+}
+
+#endif // LUMATONE_HEXAGON_AUTOMATA_VIRTUAL_FIELD_H
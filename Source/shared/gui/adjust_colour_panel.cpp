@@ -61,18 +61,24 @@ AdjustColourPanel::AdjustColourPanel(LumatoneController* controllerIn,  Lumatone
     hueSlider = std::make_unique<juce::Slider>(juce::Slider::SliderStyle::LinearHorizontal, juce::Slider::TextEntryBoxPosition::TextBoxLeft);
     hueSlider->setRange(-1.0, 1.0, 0.001);
     hueSlider->onValueChange = [&]() { hueValueCallback(); };
+    hueSlider->onDragStart = [&]() { colourAdjuster.beginStreaming(); };
+    hueSlider->onDragEnd = [&]() { colourAdjuster.endStreaming(); };
     addAndMakeVisible(hueSlider.get());
 
     brightnessSlider = std::make_unique<juce::Slider>(juce::Slider::SliderStyle::LinearHorizontal, juce::Slider::TextEntryBoxPosition::TextBoxLeft);
     brightnessSlider->setRange(0.0, 2.0, 0.01);
     brightnessSlider->setValue(1.0);
     brightnessSlider->onValueChange = [&]() { brightnessValueCallback(); };
+    brightnessSlider->onDragStart = [&]() { colourAdjuster.beginStreaming(); };
+    brightnessSlider->onDragEnd = [&]() { colourAdjuster.endStreaming(); };
     addAndMakeVisible(brightnessSlider.get());
 
     satSlider = std::make_unique<juce::Slider>(juce::Slider::SliderStyle::LinearHorizontal, juce::Slider::TextEntryBoxPosition::TextBoxLeft);
     satSlider->setRange(0.0, 2.0, 0.01);
     satSlider->setValue(1.0);
     satSlider->onValueChange = [&]() { saturationValueCallback(); };
+    satSlider->onDragStart = [&]() { colourAdjuster.beginStreaming(); };
+    satSlider->onDragEnd = [&]() { colourAdjuster.endStreaming(); };
     addAndMakeVisible(satSlider.get());
 
     kelvinSlider = std::make_unique<juce::Slider>(juce::Slider::SliderStyle::LinearHorizontal, juce::Slider::TextEntryBoxPosition::TextBoxLeft);
@@ -80,6 +86,8 @@ AdjustColourPanel::AdjustColourPanel(LumatoneController* controllerIn,  Lumatone
     kelvinSlider->setSkewFactor(1.0f / 3.0f);
     kelvinSlider->setValue(6500);
     kelvinSlider->onValueChange = [&]() { adjustWhiteValueCallback(); };
+    kelvinSlider->onDragStart = [&]() { colourAdjuster.beginStreaming(); };
+    kelvinSlider->onDragEnd = [&]() { colourAdjuster.endStreaming(); };
     addAndMakeVisible(kelvinSlider.get());
 }
 
@@ -212,17 +220,17 @@ void AdjustColourPanel::reconfigureColours(bool doResize)
     }
 }
 
-void AdjustColourPanel::completeMappingLoaded(LumatoneLayout mappingData)
+void AdjustColourPanel::completeMappingLoaded(const LumatoneLayout& mappingData)
 {
     reconfigureColours();
 }
 
-void AdjustColourPanel::boardChanged(LumatoneBoard boardData)
+void AdjustColourPanel::boardChanged(const LumatoneBoard& boardData)
 {
     reconfigureColours();
 }
 
-void AdjustColourPanel::keyChanged(int boardIndex, int keyIndex, LumatoneKey lumatoneKey)
+void AdjustColourPanel::keyChanged(int boardIndex, int keyIndex, const LumatoneKey& lumatoneKey)
 {
     reconfigureColours();
 }
@@ -48,9 +48,9 @@ public:
     void mouseDown(const juce::MouseEvent& e) override;
 
 private:
-    void completeMappingLoaded(LumatoneLayout mappingData) override;
-    void boardChanged(LumatoneBoard boardData) override;
-    void keyChanged(int boardIndex, int keyIndex, LumatoneKey lumatoneKey) override;
+    void completeMappingLoaded(const LumatoneLayout& mappingData) override;
+    void boardChanged(const LumatoneBoard& boardData) override;
+    void keyChanged(int boardIndex, int keyIndex, const LumatoneKey& lumatoneKey) override;
 
 private:
     void colourChangedCallback(ColourSelectionBroadcaster* source, juce::Colour newColour) override;
@@ -59,30 +59,150 @@ void DeviceActivityMonitor::setCheckForInactivity(bool monitorActivity)
     }
 }
 
-void DeviceActivityMonitor::pingAllDevices()
+void DeviceActivityMonitor::discoverDevices()
 {
-    DBG("Ping all devices!");
+    DBG("Discover devices!");
 
     deviceDetectInProgress = true;
+    narrowingDown = false;
+    untaggedResponseInput = -1;
+    discoveryRound = (discoveryRound + 1) % numDiscoveryRounds;
+    if (discoveryRound == 0)
+        discoveryRound = 1;
+
+    midiDriver->refreshDeviceLists();
+    midiDriver->openAvailableDevicesForTesting();
 
     outputDevices = midiDriver->getMidiOutputList();
+    inputDevices = midiDriver->getMidiInputList();
 
-    outputPingIds.clear();
+    candidateOutputs.clearQuick();
+    untestedOutputs.clearQuick();
 
-    waitingForResponse = true;
+    if (outputDevices.size() == 0 || inputDevices.size() == 0)
+    {
+        DBG("No input and output MIDI device combination could be made.");
+        onDetectionTimeout();
+        return;
+    }
 
     int maxDevices = juce::jmin(outputDevices.size(), 128);
     if (midiDriver->getHostMode() == LumatoneFirmwareDriver::HostMode::Plugin)
         maxDevices = 1;
 
     for (int i = 0; i < maxDevices; i++)
+        candidateOutputs.add(i);
+
+    // Both go out before any answer is awaited, the ping is matched to its output by ID,
+    // the serial request covers firmware without ping support
+    for (auto outputIndex : candidateOutputs)
+        midiDriver->ping(getPingIdForOutput(outputIndex), outputIndex);
+
+    sendSerialRequests(candidateOutputs);
+
+    waitForResponses(responseTimeoutMs);
+}
+
+void DeviceActivityMonitor::sendSerialRequests(const juce::Array<int>& outputIndices)
+{
+    for (auto outputIndex : outputIndices)
+    {
+        if (sendCalibratePitchModOff)
+            midiDriver->sendCalibratePitchModWheel(false, outputIndex);
+        else
+            midiDriver->sendGetSerialIdentityRequest(outputIndex);
+    }
+}
+
+void DeviceActivityMonitor::narrowDownOutput(juce::Array<int> outputIndices)
+{
+    if (outputIndices.size() == 0)
+    {
+        // Device stopped answering
+        narrowingDown = false;
+        untaggedResponseInput = -1;
+        onDetectionTimeout();
+        return;
+    }
+
+    if (outputIndices.size() == 1)
+    {
+        narrowingDown = false;
+        establishConnection(untaggedResponseInput, outputIndices[0]);
+        return;
+    }
+
+    narrowingDown = true;
+
+    const int half = outputIndices.size() / 2;
+    candidateOutputs.clearQuick();
+    untestedOutputs.clearQuick();
+
+    for (int i = 0; i < outputIndices.size(); i++)
+    {
+        if (i < half)
+            candidateOutputs.add(outputIndices[i]);
+        else
+            untestedOutputs.add(outputIndices[i]);
+    }
+
+    DBG("Narrowing down output, testing " + juce::String(candidateOutputs.size()) + " of " + juce::String(outputIndices.size()));
+
+    sendSerialRequests(candidateOutputs);
+    waitForResponses(responseTimeoutMs);
+}
+
+int DeviceActivityMonitor::findOutputForInput(int inputIndex) const
+{
+    if (candidateOutputs.size() == 1)
+        return candidateOutputs[0];
+
+    if (inputIndex < 0 || inputIndex >= inputDevices.size())
+        return -1;
+
+    // Both ends of a USB MIDI device usually share a name, but some platforms decorate one of them
+    auto inputName = inputDevices[inputIndex].name;
+    int matchedOutput = -1;
+
+    for (auto outputIndex : candidateOutputs)
     {
-        unsigned int id = (unsigned int)(i + 1);
-        midiDriver->ping(id, i);
-        outputPingIds.add(id);
+        auto outputName = outputDevices[outputIndex].name;
+        if (outputName == inputName || outputName.contains(inputName) || inputName.contains(outputName))
+        {
+            if (matchedOutput >= 0)
+                return -1;
+
+            matchedOutput = outputIndex;
+        }
     }
 
-    startTimer(responseTimeoutMs);
+    return matchedOutput;
+}
+
+void DeviceActivityMonitor::waitForResponses(int timeoutMs)
+{
+    waitingForResponse = true;
+    responseDeadlineMs = juce::Time::getMillisecondCounter() + (juce::uint32)timeoutMs;
+    startTimer(timeoutMs);
+}
+
+void DeviceActivityMonitor::resumeWaitingForResponses()
+{
+    // Any incoming message stops the timer, restart it for what is left of the window
+    auto now = juce::Time::getMillisecondCounter();
+    int remainingMs = (responseDeadlineMs > now) ? (int)(responseDeadlineMs - now) : 1;
+    startTimer(remainingMs);
+}
+
+void DeviceActivityMonitor::onDetectionTimeout()
+{
+    DBG("Detect device timeout.");
+    deviceDetectInProgress = false;
+    waitingForResponse = false;
+    candidateOutputs.clearQuick();
+    startTimer(detectRoutineTimeoutMs);
+
+    statusListeners.call(&LumatoneEditor::StatusListener::connectionFailed);
 }
 
 // bool DeviceActivityMonitor::testLastConnectedDevice()
@@ -115,59 +235,6 @@ void DeviceActivityMonitor::pingAllDevices()
 //     return false;
 // }
 
-void DeviceActivityMonitor::startIndividualDetection()
-{
-    jassert(outputPingIds.size() == 0);
-    
-    testOutputIndex = -1;
-    outputDevices = midiDriver->getMidiOutputList();
-    inputDevices = midiDriver->getMidiInputList();
-
-    if (outputDevices.size() > 0 && inputDevices.size() > 0)
-    {
-        deviceDetectInProgress = true;
-        testNextOutput();
-    }
-    else
-    {
-        DBG("No input and output MIDI device combination could be made.");
-        deviceDetectInProgress = false;
-        startTimer(detectRoutineTimeoutMs);
-    }
-}
-
-void DeviceActivityMonitor::testNextOutput()
-{
-
-    if (midiDriver->getHostMode() == LumatoneFirmwareDriver::HostMode::Driver)
-    {
-        testOutputIndex++;
-        if (testOutputIndex < 0 || testOutputIndex >= outputDevices.size())
-        {
-            // Start over
-            startTimer(10);
-        }
-    }
-
-    #if JUCE_DEBUG
-        juce::String deviceName = midiDriver->getHostMode() == LumatoneFirmwareDriver::HostMode::Driver ? outputDevices[testOutputIndex].name : "Host";
-        juce::String command = sendCalibratePitchModOff ? "Calibrate" : "GetSerial";
-        DBG("Test via " + command + ": " + deviceName);
-    #endif
-
-    if (sendCalibratePitchModOff)
-    {
-        midiDriver->sendCalibratePitchModWheel(false, testOutputIndex);
-    }
-    else
-    {
-        midiDriver->sendGetSerialIdentityRequest(testOutputIndex);
-    }
-    
-    waitingForResponse = true;
-    startTimer(responseTimeoutMs);
-}
-
 void DeviceActivityMonitor::startDeviceDetection()
 {
     // if (midiDriver->getHostMode() != LumatoneFirmwareDriver::HostMode::Driver)
@@ -232,29 +299,35 @@ bool DeviceActivityMonitor::initializeConnectionTest()
     return isIdle;
 }
 
-int DeviceActivityMonitor::getPingIdFromResponse(const juce::MidiMessage &msg)
+unsigned int DeviceActivityMonitor::getPingIdForOutput(int outputIndex) const
+{
+    return (discoveryRound << pingIdOutputBits) | (unsigned int)(outputIndex + 1);
+}
+
+int DeviceActivityMonitor::getOutputIndexFromPingId(unsigned int pingId) const
+{
+    if ((pingId >> pingIdOutputBits) != discoveryRound)
+        return -1;
+
+    int outputIndex = (int)(pingId & 0xff) - 1;
+    return candidateOutputs.contains(outputIndex) ? outputIndex : -1;
+}
+
+bool DeviceActivityMonitor::getPingIdFromResponse(const juce::MidiMessage &msg, unsigned int& pingId)
 {
-    unsigned int pingId = 0;
-    
     auto errorCode = LumatoneSysEx::unpackPingResponse(msg, pingId);
 
     if (errorCode != FirmwareSupport::Error::noError)
     {
         if (errorCode == FirmwareSupport::Error::messageIsAnEcho)
-            return -1;
+            return true;
         
         DBG("WARNING: Ping response error in auto connection routine detected");
         jassertfalse;
+        return false;
     }
 
-    return (int)pingId - 1;
-}
-
-void DeviceActivityMonitor::removeFailedPingDevice(const juce::MidiMessage &msg)
-{
-    unsigned int pingId = 0;
-    LumatoneSysEx::unpackPingResponse(msg, pingId);
-    outputDevices.remove(outputPingIds.indexOf(pingId));
+    return true;
 }
 
 void DeviceActivityMonitor::checkDetectionStatus()
@@ -265,7 +338,10 @@ void DeviceActivityMonitor::checkDetectionStatus()
         deviceDetectInProgress = false;
         statusListeners.call(&LumatoneEditor::StatusListener::connectionStateChanged, ConnectionState::ONLINE);
 
-        outputPingIds.clear();
+        candidateOutputs.clearQuick();
+        untestedOutputs.clearQuick();
+        untaggedResponseInput = -1;
+        narrowingDown = false;
 
         if (checkConnectionOnInactivity)
             startActivityMonitoring();
@@ -279,27 +355,21 @@ void DeviceActivityMonitor::checkDetectionStatus()
     {
         if (deviceDetectInProgress)
         {
-            DBG("Detect device timeout.");
-            deviceDetectInProgress = false;
-            waitingForResponse = false;
-            startTimer(detectRoutineTimeoutMs);
-            
-            statusListeners.call(&LumatoneEditor::StatusListener::connectionFailed);
+            onDetectionTimeout();
         }
         else
         {
             deviceDetectInProgress = true;
             if (sendCalibratePitchModOff)
             {
-                midiDriver->sendCalibratePitchModWheel(false, testOutputIndex);
+                midiDriver->sendCalibratePitchModWheel(false);
             }
             else
             {
-                midiDriver->sendGetSerialIdentityRequest(testOutputIndex);
+                midiDriver->sendGetSerialIdentityRequest();
             }
 
-            waitingForResponse = true;
-            startTimer(responseTimeoutMs);
+            waitForResponses(responseTimeoutMs);
         }
     }
     else
@@ -313,46 +383,32 @@ void DeviceActivityMonitor::checkDetectionStatus()
                 waitingForResponse = false;
                 midiDriver->closeMidiInput();
                 midiDriver->closeMidiOutput();
-                pingAllDevices();
+                discoverDevices();
             }
 
-            // Failed ping routine
-            else if (outputPingIds.size() > 0)
+            // An output we sent to answered without a ping ID
+            else if (untaggedResponseInput >= 0)
             {
-                waitingForResponse = false;
-                outputPingIds.clear();
-                startIndividualDetection();
+                // While narrowing down, no answer means the device is in the other half
+                narrowDownOutput(narrowingDown ? untestedOutputs : candidateOutputs);
             }
 
-            // Ongoing GetSerial routine
-            else if (testOutputIndex >= 0 && testOutputIndex < outputDevices.size())
-            {
-                testNextOutput();
-            }
-            
             // Set timeout for next attempt
             else
             {
-                DBG("Detect device timeout.");
-                deviceDetectInProgress = false;
-                waitingForResponse = false;
-                startTimer(detectRoutineTimeoutMs);
-
-                statusListeners.call(&LumatoneEditor::StatusListener::connectionFailed);
+                onDetectionTimeout();
             }
         }
 
         // Start detection
         else
         {
-            midiDriver->refreshDeviceLists();
-            midiDriver->openAvailableDevicesForTesting();
             deviceConnectionMode = DetectConnectionMode::lookingForDevice;
 
             // If there's no last-connected-device, skip to pinging
             //if (!testLastConnectedDevice())
             //{
-                pingAllDevices();
+                discoverDevices();
             //}
         }
     }
@@ -417,10 +473,16 @@ void DeviceActivityMonitor::handleResponse(int inputDeviceIndex, const juce::Mid
     auto sysExData = msg.getSysExData();
     auto cmd = sysExData[CMD_ID];
 
+    const bool discovering = waitingForResponse
+                          && deviceConnectionMode == DetectConnectionMode::lookingForDevice
+                          && midiDriver->getHostMode() == LumatoneFirmwareDriver::HostMode::Driver;
+
     if (cmd == PERIPHERAL_CALBRATION_DATA && !isConnectionEstablished())
     {
         sendCalibratePitchModOff = true;
         // startTimer(100);
+        if (waitingForResponse)
+            resumeWaitingForResponses();
         return;
     }
 
@@ -430,19 +492,29 @@ void DeviceActivityMonitor::handleResponse(int inputDeviceIndex, const juce::Mid
         case TEST_ECHO:
         {
             DBG("DAM ignoring feedback from device " + juce::String(inputDeviceIndex) + " with message: " + msg.getDescription());
-            if (cmd == LUMA_PING)
-                removeFailedPingDevice(msg);
+
+            unsigned int pingId = 0;
+            if (cmd == LUMA_PING && getPingIdFromResponse(msg, pingId))
+            {
+                // A looped back port, not a device
+                int echoedOutput = getOutputIndexFromPingId(pingId);
+                if (echoedOutput >= 0 && !narrowingDown)
+                    candidateOutputs.removeFirstMatchingValue(echoedOutput);
+            }
+
+            resumeWaitingForResponses();
             return;
         }
 
         case LumatoneFirmware::ReturnCode::ACK:
         {
             int establishOutIndex = -1;
+            bool untaggedResponse = false;
 
             switch (cmd)
             {
             case GET_SERIAL_IDENTITY:
-                establishOutIndex = testOutputIndex;
+                untaggedResponse = true;
                 break;
 
             case CALIBRATE_PITCH_MOD_WHEEL:
@@ -453,22 +525,57 @@ void DeviceActivityMonitor::handleResponse(int inputDeviceIndex, const juce::Mid
                         sendCalibratePitchModOff = true;
                     }
                 }
+                untaggedResponse = true;
                 break;
 
             case GET_FIRMWARE_REVISION:
                 break;
 
             case LUMA_PING:
-                if (outputPingIds.size() == 0)
-                    break;
-
-                establishOutIndex = getPingIdFromResponse(msg);
+            {
+                unsigned int pingId = 0;
+                if (discovering && getPingIdFromResponse(msg, pingId))
+                    establishOutIndex = getOutputIndexFromPingId(pingId);
                 break;
+            }
 
             default:
                 break;
             }
 
+            if (midiDriver->getHostMode() == LumatoneFirmwareDriver::HostMode::Plugin)
+                establishOutIndex = 0;
+
+            else if (discovering && untaggedResponse)
+            {
+                establishOutIndex = findOutputForInput(inputDeviceIndex);
+
+                if (establishOutIndex < 0)
+                {
+                    untaggedResponseInput = inputDeviceIndex;
+
+                    if (narrowingDown)
+                    {
+                        // Device is in the half just tested
+                        narrowDownOutput(candidateOutputs);
+                    }
+                    else
+                    {
+                        // Newer firmware also answers the ping, give it a moment before narrowing down
+                        waitForResponses(threadDelayMs);
+                    }
+
+                    return;
+                }
+            }
+
+            else if (discovering && establishOutIndex < 0)
+            {
+                // Answer from an earlier round or an unknown output
+                resumeWaitingForResponses();
+                return;
+            }
+
             waitingForResponse = false;
 
             if (sendCalibratePitchModOff)
@@ -512,6 +619,13 @@ void DeviceActivityMonitor::handleResponse(int inputDeviceIndex, const juce::Mid
     {
         establishConnection(midiDriver->getMidiInputIndex(), midiDriver->getMidiOutputIndex());
     }
+
+    // Another answer to the discovery round that found the device, finish confirming the connection
+    else if (deviceConnectionMode == DetectConnectionMode::lookingForDevice)
+    {
+        startTimer(threadDelayMs);
+    }
+
     else if (checkConnectionOnInactivity)
     {
         startTimer(inactivityTimeoutMs);
@@ -539,16 +653,15 @@ void DeviceActivityMonitor::noAnswerToMessage(juce::MidiDeviceInfo expectedDevic
 
     if (waitingForResponse && deviceConnectionMode < DetectConnectionMode::noDeviceMonitoring)
     {
-        waitingForResponse = false;
-        auto sysExData = midiMessage.getSysExData();
-        if (sysExData[CMD_ID] == LUMA_PING && outputPingIds.size() > 0)
-        {
-            removeFailedPingDevice(midiMessage);
-        }
-        else
+        // Discovery requests go straight to the test outputs, so this was some other queued message
+        if (deviceDetectInProgress && midiDriver->getHostMode() == LumatoneFirmwareDriver::HostMode::Driver)
         {
-            startTimer(threadDelayMs);
+            resumeWaitingForResponses();
+            return;
         }
+
+        waitingForResponse = false;
+        startTimer(threadDelayMs);
     }
     
     else if (isConnectionEstablished())
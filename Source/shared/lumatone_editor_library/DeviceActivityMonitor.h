@@ -61,8 +61,8 @@ public:
     //=========================================================================
 
     // Start monitoring available MIDI devices and wait for an expected response
-    // First uses the "Ping" command to send to all available devices,
-    // then goes through a legacy-supported routine with individual output devices.
+    // Every output gets a tagged "Ping" and a legacy-supported request at once,
+    // so a device is usually found within one response time.
     void startDeviceDetection();
 
     // Begin polling selected device until it stops responding. Other messages
@@ -83,9 +83,10 @@ private:
     //=========================================================================
 
     /// <summary>
-    /// Sends a ping to all devices to see if we get a response
+    /// Opens all devices and sends every output a ping tagged with its index, along with a
+    /// Get Serial Identity (or calibration stop) request for firmware that doesn't answer pings
     /// </summary>
-    void pingAllDevices();
+    void discoverDevices();
 
     /// <summary>
     /// If a MIDI device identifier is defined in properties, send a GetSerialIdentity to it.
@@ -94,19 +95,29 @@ private:
     // bool testLastConnectedDevice();
 
     /// <summary>
-    /// Resets device list and starts routine for sending tests to each device individually
+    /// Checks detection routines, resolves untagged responses when there was no ping answer, and handles timeouts
     /// </summary>
-    void startIndividualDetection();
+    void checkDetectionStatus();
 
     /// <summary>
-    /// Checks detection routines, will move on from Ping routine if no answers, then will drive the legacy detection routine
+    /// Sends the legacy-supported request to each of the given outputs
     /// </summary>
-    void checkDetectionStatus();
+    void sendSerialRequests(const juce::Array<int>& outputIndices);
+
+    /// <summary>
+    /// An untagged response came from one of these outputs. Connects if there is only one,
+    /// otherwise sends to half of them to see which half the device is in.
+    /// </summary>
+    void narrowDownOutput(juce::Array<int> outputIndices);
 
     /// <summary>
-    /// Increments the output index and sends a Get Serial Identity message to this next output to listen for a response 
+    /// Returns the candidate output that the input device must be paired with, or -1 if it's ambiguous
     /// </summary>
-    void testNextOutput();
+    int findOutputForInput(int inputIndex) const;
+
+    void waitForResponses(int timeoutMs);
+    void resumeWaitingForResponses();
+    void onDetectionTimeout();
 
     // Turn off device detection and idle
     void stopDeviceDetection();
@@ -129,12 +140,14 @@ private:
     //=========================================================================
     // Callback functions
 
-    void removeFailedPingDevice(const juce::MidiMessage& msg);
-
     void establishConnection(int inputIndex, int outputIndex);
     void onDisconnection();
 
-    static int getPingIdFromResponse(const juce::MidiMessage& msg);
+    // Ping IDs hold the output index and the discovery round, so late answers to an earlier round are ignored
+    unsigned int getPingIdForOutput(int outputIndex) const;
+    int getOutputIndexFromPingId(unsigned int pingId) const;
+
+    static bool getPingIdFromResponse(const juce::MidiMessage& msg, unsigned int& pingId);
     
 protected:
 
@@ -162,10 +175,19 @@ private:
 
     int                     sentQueueSize = 0;
 
-    int                                 testOutputIndex = -1;
+    static constexpr int    pingIdBits = 21;                // Three 7-bit payload bytes
+    static constexpr int    pingIdOutputBits = 8;
+    static constexpr unsigned int numDiscoveryRounds = 1u << (pingIdBits - pingIdOutputBits);
+
     juce::Array<juce::MidiDeviceInfo>   outputDevices;
     juce::Array<juce::MidiDeviceInfo>   inputDevices;
-    juce::Array<unsigned int>           outputPingIds;
+
+    juce::Array<int>        candidateOutputs;               // Outputs that may be connected to a device
+    juce::Array<int>        untestedOutputs;                // Other half of the candidates while narrowing down
+    int                     untaggedResponseInput = -1;     // Input that answered a request without a ping ID
+    bool                    narrowingDown = false;
+    unsigned int            discoveryRound = 0;             // High bits of ping IDs, wraps to fit the 21 bits a ping echoes
+    juce::uint32            responseDeadlineMs = 0;
 
     int                     confirmedInputIndex = -1;
     int                     confirmedOutputIndex = -1;
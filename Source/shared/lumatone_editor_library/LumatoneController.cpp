@@ -116,6 +116,21 @@ void LumatoneController::setMidiOutput(int deviceIndex, bool test)
         testCurrentDeviceConnection();
 }
 
+void LumatoneController::setKeyUpdatePriority(LumatoneFirmware::SendPriority priority)
+{
+    firmwareDriver.setKeyUpdatePriority(priority);
+}
+
+LumatoneFirmware::SendPriority LumatoneController::getKeyUpdatePriority() const
+{
+    return firmwareDriver.getKeyUpdatePriority();
+}
+
+LumatoneFirmware::SendStatistics LumatoneController::getSendStatistics() const
+{
+    return firmwareDriver.getSendStatistics();
+}
+
 bool LumatoneController::performAction(LumatoneAction* action, bool undoable, bool newTransaction)
 {
     if (action == nullptr)
@@ -164,6 +179,12 @@ void LumatoneController::sendCompleteMapping(const LumatoneLayout& mappingData,
         editorListeners.call(&LumatoneEditor::EditorListener::completeMappingLoaded, mappingData);
 }
 
+void LumatoneController::sendCurrentMapping()
+{
+    for (int boardId = 1; boardId <= getNumBoards(); boardId++)
+        sendAllParamsOfBoard(boardId, getMappingData()->readBoard(boardId - 1), false, false);
+}
+
 void LumatoneController::sendGetMappingOfBoardRequest(int boardId)
 {
     getRedLEDConfig(boardId);
@@ -253,7 +274,7 @@ void LumatoneController::testCurrentDeviceConnection()
 }
 
 // Send parametrization of one key to the device
-void LumatoneController::sendKeyParam(int boardId, int keyIndex, LumatoneKey keyData, bool signalEditorListeners, bool bufferKeyUpdates)
+void LumatoneController::sendKeyParam(int boardId, int keyIndex, const LumatoneKey& keyData, bool signalEditorListeners, bool bufferKeyUpdates)
 {    
     // Default CC polarity = 1, Inverted CC polarity = 0
     sendKeyConfig(boardId, keyIndex, keyData, false, bufferKeyUpdates);
@@ -265,24 +286,65 @@ void LumatoneController::sendKeyParam(int boardId, int keyIndex, LumatoneKey key
 
 void LumatoneController::sendSelectionParam(const juce::Array<MappedLumatoneKey>& selection, bool signalEditorListeners, bool bufferKeyUpdates)
 {
-    for (auto mappedKey : selection)
+    LumatoneKeyChangeSet changedKeys;
+
+    for (const auto& mappedKey : selection)
     {
-        sendKeyConfig(mappedKey.boardIndex + 1, mappedKey.keyIndex, (LumatoneKey)mappedKey, false, bufferKeyUpdates);
+        sendKeyConfig(mappedKey.boardIndex + 1, mappedKey.keyIndex, mappedKey, false, bufferKeyUpdates);
+        changedKeys.addKey(mappedKey.boardIndex, mappedKey.keyIndex, LumatoneKeyChangeSet::config);
     }
 
     if (signalEditorListeners)
-        editorListeners.call(&LumatoneEditor::EditorListener::selectionChanged, selection);
+        notifyKeysChanged(changedKeys);
 }
 
 void LumatoneController::sendSelectionColours(const juce::Array<MappedLumatoneKey>& selection, bool signalEditorListeners, bool bufferKeyUpdates)
 {
-    for (auto mappedKey : selection)
+    LumatoneKeyChangeSet changedKeys;
+
+    for (const auto& mappedKey : selection)
     {
-        sendKeyColourConfig(mappedKey.boardIndex + 1, mappedKey.keyIndex, (LumatoneKey)mappedKey, false, bufferKeyUpdates);
+        sendKeyColourConfig(mappedKey.boardIndex + 1, mappedKey.keyIndex, mappedKey.colour, false, bufferKeyUpdates);
+        changedKeys.addKey(mappedKey.boardIndex, mappedKey.keyIndex, LumatoneKeyChangeSet::colour);
     }
 
     if (signalEditorListeners)
-        editorListeners.call(&LumatoneEditor::EditorListener::selectionChanged, selection);
+        notifyKeysChanged(changedKeys);
+}
+
+void LumatoneController::notifyKeysChanged(const LumatoneKeyChangeSet& changedKeys)
+{
+    if (changedKeys.isEmpty())
+        return;
+
+    if (keyChangeBatchDepth > 0)
+    {
+        pendingKeyChanges.addKeys(changedKeys);
+        return;
+    }
+
+    editorListeners.call(&LumatoneEditor::EditorListener::keysChanged, changedKeys);
+}
+
+void LumatoneController::beginKeyChangeBatch()
+{
+    keyChangeBatchDepth++;
+}
+
+void LumatoneController::endKeyChangeBatch()
+{
+    jassert(keyChangeBatchDepth > 0);
+    if (keyChangeBatchDepth == 0 || --keyChangeBatchDepth > 0)
+        return;
+
+    if (pendingKeyChanges.isEmpty())
+        return;
+
+    // Copy so listeners that edit keys start a new set
+    auto changedKeys = pendingKeyChanges;
+    pendingKeyChanges.clear();
+
+    editorListeners.call(&LumatoneEditor::EditorListener::keysChanged, changedKeys);
 }
 
 // Send configuration of a certain look up table
@@ -313,7 +375,11 @@ void LumatoneController::sendTableConfig(LumatoneConfigTable::TableType velocity
 // Send note, channel, cc, and fader polarity data
 void LumatoneController::sendKeyConfig(int boardId, int keyIndex, const LumatoneKey& keyData, bool signalEditorListeners, bool bufferKeyUpdates)
 {
-    if (bufferKeyUpdates)
+    if (!deviceOutputOwned)
+    {
+        // Layout is only kept until this controller owns the device again
+    }
+    else if (bufferKeyUpdates)
         updateBuffer.sendKeyConfig(boardId, keyIndex, keyData);
     else
         firmwareDriver.sendKeyFunctionParameters(boardId, keyIndex, keyData.noteNumber, keyData.channelNumber, keyData.keyType, keyData.ccFaderDefault);
@@ -326,7 +392,11 @@ void LumatoneController::sendKeyConfig(int boardId, int keyIndex, const Lumatone
 
 void LumatoneController::sendKeyColourConfig(int boardId, int keyIndex, juce::Colour colour, bool signalEditorListeners, bool bufferKeyUpdates)
 {
-    if (bufferKeyUpdates)
+    if (!deviceOutputOwned)
+    {
+        // Layout is only kept until this controller owns the device again
+    }
+    else if (bufferKeyUpdates)
         updateBuffer.sendKeyColourConfig(boardId, keyIndex, colour);
     else
     {
@@ -368,10 +438,13 @@ void LumatoneController::sendInvertFootController(bool value)
 void LumatoneController::sendMacroButtonActiveColour(juce::String colourAsString)
 {
     auto c = juce::Colour::fromString(colourAsString);
-    if (getLumatoneVersion() >= LumatoneFirmware::ReleaseVersion::VERSION_1_0_11)
-        firmwareDriver.sendMacroButtonActiveColour(c.getRed(), c.getGreen(), c.getBlue());
-    else
-        firmwareDriver.sendMacroButtonActiveColour_Version_1_0_0(c.getRed(), c.getGreen(), c.getBlue());
+    if (deviceOutputOwned)
+    {
+        if (getLumatoneVersion() >= LumatoneFirmware::ReleaseVersion::VERSION_1_0_11)
+            firmwareDriver.sendMacroButtonActiveColour(c.getRed(), c.getGreen(), c.getBlue());
+        else
+            firmwareDriver.sendMacroButtonActiveColour_Version_1_0_0(c.getRed(), c.getGreen(), c.getBlue());
+    }
     editorListeners.call(&LumatoneEditor::EditorListener::macroButtonActiveColourChagned, c);
 }
 
@@ -379,10 +452,13 @@ void LumatoneController::sendMacroButtonActiveColour(juce::String colourAsString
 void LumatoneController::sendMacroButtonInactiveColour(juce::String colourAsString)
 {
     auto c = juce::Colour::fromString(colourAsString);
-    if (getLumatoneVersion() >= LumatoneFirmware::ReleaseVersion::VERSION_1_0_11)
-        firmwareDriver.sendMacroButtonInactiveColour(c.getRed(), c.getGreen(), c.getBlue());
-    else
-        firmwareDriver.sendMacroButtonInactiveColour_Version_1_0_0(c.getRed(), c.getGreen(), c.getBlue());
+    if (deviceOutputOwned)
+    {
+        if (getLumatoneVersion() >= LumatoneFirmware::ReleaseVersion::VERSION_1_0_11)
+            firmwareDriver.sendMacroButtonInactiveColour(c.getRed(), c.getGreen(), c.getBlue());
+        else
+            firmwareDriver.sendMacroButtonInactiveColour_Version_1_0_0(c.getRed(), c.getGreen(), c.getBlue());
+    }
     editorListeners.call(&LumatoneEditor::EditorListener::macroButtonInactiveColourChanged, c);
 }
 
@@ -614,12 +690,13 @@ void LumatoneController::onConnectionConfirmed()
     currentDevicePairConfirmed = true;
     waitingForFirmwareVersion = true;
 
-    if (getSerialNumber().isEmpty())
+    // The owner of a shared device asks for its identity, the other controllers get the answers too
+    if (deviceOutputOwned && getSerialNumber().isEmpty())
     {
         sendGetSerialIdentityRequest(true);
         return; // a bit of a kludge
     }
-    else if (getSerialNumber() != SERIAL_55_KEYS)
+    else if (deviceOutputOwned && getSerialNumber() != SERIAL_55_KEYS)
     {
         sendGetFirmwareRevisionRequest();
     }
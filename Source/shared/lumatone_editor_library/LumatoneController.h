@@ -57,7 +57,37 @@ public:
     void setMidiInput(int deviceIndex, bool test = true);
     void setMidiOutput(int deviceIndex, bool test = true);
 
+    // Firmware send queue lane used for key updates, see LumatoneFirmwareDriver::setKeyUpdatePriority
+    void setKeyUpdatePriority(LumatoneFirmware::SendPriority priority);
+    LumatoneFirmware::SendPriority getKeyUpdatePriority() const;
+
+    // Sets the key update priority for the lifetime of this object
+    struct ScopedKeyUpdatePriority
+    {
+        ScopedKeyUpdatePriority(LumatoneController& controllerIn, LumatoneFirmware::SendPriority priority)
+            : controller(controllerIn)
+            , previousPriority(controllerIn.getKeyUpdatePriority())
+        {
+            controller.setKeyUpdatePriority(priority);
+        }
+
+        ~ScopedKeyUpdatePriority() { controller.setKeyUpdatePriority(previousPriority); }
+
+    private:
+        LumatoneController& controller;
+        LumatoneFirmware::SendPriority previousPriority;
+    };
+
+    // Firmware send queue size and answered message totals
+    LumatoneFirmware::SendStatistics getSendStatistics() const;
+
+    // When a LumatoneDeviceHub shares the device, only the owning controller sends key and LED updates.
+    // The others still update their own layout and notify their listeners.
+    void setOwnsDeviceOutput(bool ownsOutput) { deviceOutputOwned = ownsOutput; }
+    bool ownsDeviceOutput() const { return deviceOutputOwned; }
+
 public:
+    // Undoable actions are owned by the UndoManager, otherwise the caller keeps ownership
     bool performAction(LumatoneAction* action, bool undoable = true, bool newTransaction = true);
 
 private:
@@ -80,6 +110,9 @@ public:
     // Send and save a complete key mapping
     void sendCompleteMapping(const LumatoneLayout& mappingData, bool signalEditorListeners=true, bool bufferKeyUpdates=true);
 
+    // Send the current layout to the device without signalling listeners
+    void sendCurrentMapping();
+
     // Send request to receive the current mapping of one sub board on the controller
     void sendGetMappingOfBoardRequest(int boardId);
 
@@ -87,12 +120,19 @@ public:
     void sendGetCompleteMappingRequest();
 
     // Send parametrization of one key to the device
-    void sendKeyParam(int boardId, int keyIndex, LumatoneKey keyData, bool signalEditorListeners=true, bool bufferKeyUpdates=false);
+    void sendKeyParam(int boardId, int keyIndex, const LumatoneKey& keyData, bool signalEditorListeners=true, bool bufferKeyUpdates=false);
 
     void sendSelectionParam(const juce::Array<MappedLumatoneKey>& selection, bool signalEditorListeners=true, bool bufferKeyUpdates=false);
 
     void sendSelectionColours(const juce::Array<MappedLumatoneKey>& selection, bool signalEditorListeners=true, bool bufferKeyUpdates=false);
 
+    // Signal editor listeners once for keys that were sent without signalling
+    void notifyKeysChanged(const LumatoneKeyChangeSet& changedKeys);
+
+    // Key change notifications in between are merged and sent once when the outermost batch ends
+    void beginKeyChangeBatch();
+    void endKeyChangeBatch();
+
     // Send configuration of a certain look up table
     void sendTableConfig(LumatoneConfigTable::TableType velocityCurveType, const juce::uint8* table);
 
@@ -255,4 +295,9 @@ private:
     bool    waitingForTestResponse      = false;
     bool    currentDevicePairConfirmed  = false;
     bool    waitingForFirmwareVersion   = false;
+
+    bool    deviceOutputOwned           = true;
+
+    LumatoneKeyChangeSet pendingKeyChanges;
+    int     keyChangeBatchDepth         = 0;
 };
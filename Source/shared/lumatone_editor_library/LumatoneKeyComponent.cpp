@@ -29,7 +29,7 @@ void LumatoneKeyDisplay::setRenderMode(LumatoneComponentRenderMode modeIn)
     renderMode = modeIn;
 }
 
-void LumatoneKeyDisplay::paint(juce::Graphics& g)
+juce::Colour LumatoneKeyDisplay::getDrawColour(bool mouseOverKey) const
 {
     juce::Colour hexagonColour = colour;
     // juce::Colour hexagonColour = findColour(LumatoneKeyEdit::backgroundColourId).overlaidWith(getKeyColour());
@@ -55,13 +55,21 @@ void LumatoneKeyDisplay::paint(juce::Graphics& g)
         {
             drawColour = hexagonColour.contrasting(0.5f);
         }
-        else if (mouseIsOver)
+        else if (mouseOverKey)
         {
             drawColour = drawColour.contrasting(0.25f);
         }
         break;
     }
 
+    return drawColour;
+}
+
+void LumatoneKeyDisplay::paint(juce::Graphics& g)
+{
+    juce::Colour hexagonColour = colour;
+    juce::Colour drawColour = getDrawColour(mouseIsOver);
+
     // draw
     switch (renderMode)
     {
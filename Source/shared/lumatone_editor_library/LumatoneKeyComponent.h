@@ -57,6 +57,9 @@ public:
 
     void setDisplayColour(const juce::Colour& colour);
 
+    // Key colour with selection and note highlights applied for the current render mode
+    juce::Colour getDrawColour(bool mouseOverKey) const;
+
     // const LumatoneKey* getKeyData() const;
     // juce::Colour getKeyColour() const;
 
@@ -32,6 +32,7 @@ LumatoneKeyboardComponent::LumatoneKeyboardComponent(LumatoneController* control
 
 LumatoneKeyboardComponent::~LumatoneKeyboardComponent()
 {
+    cancelPendingUpdate();
     controller->removeMidiListener(this);
     controller->removeEditorListener(this);
     controller = nullptr;
@@ -51,6 +52,9 @@ void LumatoneKeyboardComponent::paint (juce::Graphics& g)
         break;
     }
 
+    if (batchedRendering)
+        paintKeysBatched(g);
+
     // Draw a line under the selected sub board
     // if (currentSetSelection >= 0 && currentSetSelection < state.getNumBoards())
     // {
@@ -119,19 +123,28 @@ void LumatoneKeyboardComponent::resized()
             juce::roundToInt(keyCentres[keyIndex].y * lumatoneBounds.getHeight() + lumatoneBounds.getY() - keyHeight * 0.5f)
         );
 
-        auto key = octaveBoards[octaveIndex]->keyMiniDisplay[keyOctaveIndex];
-        key->setKeyGraphics(keyShapeGraphic, keyShadowGraphic);
-        key->setBounds(keyPos.x, keyPos.y, keyWidth, keyHeight);
+        auto bounds = juce::Rectangle<int>(keyPos.x, keyPos.y, keyWidth, keyHeight);
+        keyBounds.set(keyIndex, bounds);
+
+        if (!batchedRendering)
+        {
+            auto key = octaveBoards[octaveIndex]->keyMiniDisplay[keyOctaveIndex];
+            key->setKeyGraphics(keyShapeGraphic, keyShadowGraphic);
+            key->setBounds(bounds);
+        }
 
         if (keyOctaveIndex + 1 == octaveBoardSize)
         {
-            octaveBoards[octaveIndex]->rightPos = key->getRight();
+            octaveBoards[octaveIndex]->rightPos = bounds.getRight();
             octaveIndex++;
 
             if (octaveIndex < getNumBoards())
-                octaveBoards[octaveIndex]->leftPos = key->getX();
+                octaveBoards[octaveIndex]->leftPos = bounds.getX();
         }
     }
+
+    if (batchedRendering)
+        updateKeyDrawColours();
 }
 
 void LumatoneKeyboardComponent::resetOctaveSize(bool resetState)
@@ -150,15 +163,23 @@ void LumatoneKeyboardComponent::resetOctaveSize(bool resetState)
                 auto keyData = getKey(subBoardIndex, keyIndex);
                 auto key = board->keyMiniDisplay.add(new LumatoneKeyDisplay(subBoardIndex, keyIndex, *keyData));
                 key->setRenderMode(renderMode);
-                addAndMakeVisible(key);
+
+                if (!batchedRendering)
+                    addAndMakeVisible(key);
             }
         }
 
         currentOctaveSize = octaveBoardSize;
+
+        numKeys = getNumBoards() * octaveBoardSize;
+        keyDrawColours.calloc((size_t)numKeys);
+        keyBounds.resize(numKeys);
+        mouseOverKeyNum = -1;
     }
 
     lumatoneRender.resetOctaveSize();
     keyCentres = lumatoneRender.getKeyCentres();
+    updateKeyNumLookup();
 
     if (resetState)
         resetLayoutState();
@@ -181,7 +202,38 @@ void LumatoneKeyboardComponent::setRenderMode(LumatoneComponentRenderMode modeIn
     mappingUpdateCallback();
 }
 
-void LumatoneKeyboardComponent::completeMappingLoaded(LumatoneLayout mappingData)
+void LumatoneKeyboardComponent::setBatchedRendering(bool drawKeysBatched)
+{
+    if (batchedRendering == drawKeysBatched)
+        return;
+
+    batchedRendering = drawKeysBatched;
+
+    for (auto board : octaveBoards)
+    {
+        for (auto key : board->keyMiniDisplay)
+        {
+            if (batchedRendering)
+                removeChildComponent(key);
+            else
+                addAndMakeVisible(key);
+        }
+    }
+
+    // This listens to itself to get the key components' mouse events,
+    // which would deliver its own events twice once there are no keys
+    if (batchedRendering)
+        removeMouseListener(this);
+    else
+        addMouseListener(this, true);
+
+    mouseOverKeyNum = -1;
+    dirtyKeyBounds.clear();
+
+    mappingUpdateCallback();
+}
+
+void LumatoneKeyboardComponent::completeMappingLoaded(const LumatoneLayout& mappingData)
 {
     for (int boardIndex = 0; boardIndex < octaveBoards.size(); boardIndex++)
     {
@@ -189,8 +241,7 @@ void LumatoneKeyboardComponent::completeMappingLoaded(LumatoneLayout mappingData
 
         for (int keyIndex = 0; keyIndex < board->keyMiniDisplay.size(); keyIndex++)
         {
-            auto keyData = *mappingData.readKey(boardIndex, keyIndex);
-            keyUpdateCallback(boardIndex, keyIndex, keyData, false);
+            keyUpdateCallback(boardIndex, keyIndex, *mappingData.readKey(boardIndex, keyIndex), false);
             
         }
     }
@@ -198,16 +249,11 @@ void LumatoneKeyboardComponent::completeMappingLoaded(LumatoneLayout mappingData
     resetLayoutState();
 }
 
-void LumatoneKeyboardComponent::boardChanged(LumatoneBoard boardData)
+void LumatoneKeyboardComponent::boardChanged(const LumatoneBoard& boardData)
 {
-    auto board = octaveBoards[boardData.board_idx];
-
     for (int keyIndex = 0; keyIndex < getOctaveBoardSize(); keyIndex++)
     {
-        auto key = board->keyMiniDisplay[keyIndex];
-
-        auto keyData = boardData.theKeys[keyIndex];
-        keyUpdateCallback(boardData.board_idx, keyIndex, keyData, false);
+        keyUpdateCallback(boardData.board_idx, keyIndex, boardData.theKeys[keyIndex], false);
     }
 
     resetLayoutState();
@@ -222,28 +268,29 @@ void LumatoneKeyboardComponent::contextChanged(LumatoneContext *newOrEmptyContex
     // completeMappingLoaded(layout);
 }
 
-void LumatoneKeyboardComponent::keyChanged(int boardIndex, int keyIndex, LumatoneKey lumatoneKey)
+void LumatoneKeyboardComponent::keyChanged(int boardIndex, int keyIndex, const LumatoneKey& lumatoneKey)
 {
     keyUpdateCallback(boardIndex, keyIndex, lumatoneKey);
 }
 
-void LumatoneKeyboardComponent::keyConfigChanged(int boardIndex, int keyIndex, LumatoneKey keyData)
+void LumatoneKeyboardComponent::keyConfigChanged(int boardIndex, int keyIndex, const LumatoneKey& keyData)
 {
     keyUpdateCallback(boardIndex, keyIndex, keyData);
 }
 
 void LumatoneKeyboardComponent::keyColourChanged(int boardIndex, int keyIndex, juce::Colour keyColour)
 {
-    keyUpdateCallback(boardIndex, keyIndex, *getKey(boardIndex, keyIndex));
+    keyUpdateCallback(boardIndex, keyIndex, *controller->getKey(boardIndex, keyIndex));
 }
 
-void LumatoneKeyboardComponent::selectionChanged(juce::Array<MappedLumatoneKey> selection)
+void LumatoneKeyboardComponent::keysChanged(const LumatoneKeyChangeSet& changedKeys)
 {
+    // This component's own layout isn't updated by edits, the controller's is
     auto paintKey = renderMode != LumatoneComponentRenderMode::MaxRes;
-    for (auto mappedKey : selection)
+    changedKeys.forEachKey([&](int boardIndex, int keyIndex)
     {
-        keyUpdateCallback(mappedKey.boardIndex, mappedKey.keyIndex, mappedKey, paintKey);
-    }
+        keyUpdateCallback(boardIndex, keyIndex, *controller->getKey(boardIndex, keyIndex), paintKey);
+    });
 
     if (renderMode == LumatoneComponentRenderMode::MaxRes)
         rerender();
@@ -272,11 +319,11 @@ void LumatoneKeyboardComponent::keyUpdateCallback(int boardIndex, int keyIndex,
             rerender();
         else
         {
-            key->repaint();
+            repaintKey(boardIndex, keyIndex);
         }
     }
     else
-        key->repaint(); //kludge
+        repaintKey(boardIndex, keyIndex); //kludge
 }
 
 void LumatoneKeyboardComponent::mappingUpdateCallback()
@@ -291,6 +338,14 @@ void LumatoneKeyboardComponent::mappingUpdateCallback()
     repaint(lumatoneBounds);
 }
 
+void LumatoneKeyboardComponent::repaintKey(int boardIndex, int keyIndex)
+{
+    if (batchedRendering)
+        invalidateKey(getKeyNum(boardIndex, keyIndex));
+    else
+        octaveBoards[boardIndex]->keyMiniDisplay[keyIndex]->repaint();
+}
+
 void LumatoneKeyboardComponent::rerender()
 {
     lumatoneRender.render();
@@ -319,6 +374,9 @@ void LumatoneKeyboardComponent::clearHeldNotes()
         if (key)
         {
             key->clearUiState();
+
+            if (batchedRendering)
+                invalidateKey(getKeyNum(key->getBoardIndex(), key->getKeyIndex()));
         }
     }
 
@@ -364,10 +422,13 @@ void LumatoneKeyboardComponent::updateKeyState(int boardIndex, int keyIndex, boo
             keyComponent->noteOn();
         else
             keyComponent->noteOff();
+
+        if (batchedRendering)
+            invalidateKey(getKeyNum(boardIndex, keyIndex));
     }
 }
 
-LumatoneKeyDisplay* LumatoneKeyboardComponent::getKeyFromMouseEvent(const juce::MouseEvent& e)
+LumatoneKeyCoord LumatoneKeyboardComponent::getKeyCoordFromMouseEvent(const juce::MouseEvent& e)
 {
     juce::Point<float> position = e.position;
 
@@ -376,113 +437,84 @@ LumatoneKeyDisplay* LumatoneKeyboardComponent::getKeyFromMouseEvent(const juce::
         position = e.getEventRelativeTo(this).position;
     }
 
-    auto child = getComponentAt(position);
-    LumatoneKeyDisplay* key = nullptr;
-    if (child && child->getParentComponent() == this)
-        key = (LumatoneKeyDisplay*)child;
+    const int keyNum = getKeyNumAt(position);
+    if (keyNum < 0)
+        return LumatoneKeyCoord();
 
-    return key;
+    return LumatoneKeyCoord(keyNum / currentOctaveSize, keyNum % currentOctaveSize);
 }
 
-void LumatoneKeyboardComponent::mouseMove(const juce::MouseEvent& e)
+void LumatoneKeyboardComponent::releaseKeyForMouse(int mouseIndex, bool sendNoteOff)
 {
-    const int mouseIndex = e.source.getIndex();
-    auto lastOver = keysOverPerMouse[mouseIndex];
+    if (!juce::isPositiveAndBelow(mouseIndex, keysDownPerMouse.size()))
+        return;
 
-    LumatoneKeyCoord keyCoord;
-    auto key = getKeyFromMouseEvent(e);
-    if (key)
-    {
-        keyCoord = key->getCoord();
-    }
+    auto keyCoord = keysDownPerMouse[mouseIndex];
+    keysDownPerMouse.set(mouseIndex, LumatoneKeyCoord());
 
-    // if (state.isKeyCoordValid(lastOver))
-    // {
-    //     auto lastOverForMouse = octaveBoards[lastOver.boardIndex]->keyMiniDisplay[lastOver.keyIndex];
-    // }
+    if (!sendNoteOff || !getMappingData()->isKeyCoordValid(keyCoord) || keysDownPerMouse.contains(keyCoord))
+        return;
 
+    keyUpInternal(keyCoord.boardIndex, keyCoord.keyIndex);
+}
 
-    keysOverPerMouse.set(mouseIndex, keyCoord);
+void LumatoneKeyboardComponent::mouseMove(const juce::MouseEvent& e)
+{
+    if (batchedRendering && e.source.isMouse())
+    {
+        auto keyCoord = getKeyCoordFromMouseEvent(e);
+        setMouseOverKey(keyCoord.isInitialized() ? getKeyNum(keyCoord.boardIndex, keyCoord.keyIndex) : -1);
+    }
+}
+
+void LumatoneKeyboardComponent::mouseExit(const juce::MouseEvent& e)
+{
+    if (batchedRendering && e.source.isMouse())
+        setMouseOverKey(-1);
 }
 
 void LumatoneKeyboardComponent::mouseDown(const juce::MouseEvent& e)
 {
-    auto key = getKeyFromMouseEvent(e);
-    if (key)
-    {
-        lumatoneKeyDown(key->getBoardIndex(), key->getKeyIndex());
-        lastMouseKeyDown = key;
+    const int mouseIndex = e.source.getIndex();
+    auto keyCoord = getKeyCoordFromMouseEvent(e);
 
-        keysDownPerMouse.set(e.source.getIndex(), key->getCoord());
-        keysOn.addIfNotAlreadyThere(key);
-    }
+    // Also filters out the same event arriving again through the mouse listener
+    if (keyCoord == keysDownPerMouse[mouseIndex] || !getMappingData()->isKeyCoordValid(keyCoord))
+        return;
+
+    releaseKeyForMouse(mouseIndex);
+
+    if (mouseIndex >= keysDownPerMouse.size())
+        keysDownPerMouse.resize(mouseIndex + 1);
+
+    keysDownPerMouse.set(mouseIndex, keyCoord);
+    lumatoneKeyDown(keyCoord.boardIndex, keyCoord.keyIndex);
 }
 
 void LumatoneKeyboardComponent::mouseUp(const juce::MouseEvent& e)
 {
-    if (e.mods.isShiftDown())
-    {
-        
-    }
-    else if (lastMouseKeyDown)
-    {
-        lumatoneKeyUp(lastMouseKeyDown->getBoardIndex(), lastMouseKeyDown->getKeyIndex());
-        keysOn.removeFirstMatchingValue(lastMouseKeyDown);
-    }
-
-    keysDownPerMouse.set(e.source.getIndex(), LumatoneKeyCoord());
+    // Notes are sustained while shift is held
+    releaseKeyForMouse(e.source.getIndex(), !e.mods.isShiftDown());
 }
 
 void LumatoneKeyboardComponent::mouseDrag(const juce::MouseEvent& e)
 {
     const int mouseIndex = e.source.getIndex();
     auto lastDownCoord = keysDownPerMouse[mouseIndex];
+    auto keyCoord = getKeyCoordFromMouseEvent(e);
 
-    LumatoneKeyDisplay* mouseKeyLastDown = nullptr;
-    if (getMappingData()->isKeyCoordValid(lastDownCoord))
-        mouseKeyLastDown = octaveBoards[lastDownCoord.boardIndex]->keyMiniDisplay[lastDownCoord.keyIndex];
-
+    if (keyCoord == lastDownCoord)
+        return;
 
-    bool onNewKey = false;
+    releaseKeyForMouse(mouseIndex, !e.mods.isShiftDown());
 
-    auto key = getKeyFromMouseEvent(e);
-    LumatoneKeyCoord keyCoord;
-    if (key)
+    if (getMappingData()->isKeyCoordValid(keyCoord))
     {
-        keyCoord = key->getCoord();
-    }
-
-    bool validKey = getMappingData()->isKeyCoordValid(keyCoord);
-    bool keyChanged = lastDownCoord != keyCoord;
-    onNewKey = validKey && (mouseKeyLastDown == nullptr || keyChanged);
-    
-    bool setLastNoteOff = !e.mods.isShiftDown() && (onNewKey || !validKey);
-    if (mouseKeyLastDown != nullptr && setLastNoteOff)
-    {            
-        keyUpInternal(mouseKeyLastDown->boardIndex, mouseKeyLastDown->keyIndex);
-    }
+        if (mouseIndex >= keysDownPerMouse.size())
+            keysDownPerMouse.resize(mouseIndex + 1);
 
-    if (onNewKey)
-    {
         keysDownPerMouse.set(mouseIndex, keyCoord);
-        keysOverPerMouse.set(mouseIndex, keyCoord);
-
         keyDownInternal(keyCoord.boardIndex, keyCoord.keyIndex);
-
-        lastMouseKeyOver = key;
-        lastMouseKeyDown = key;
-    }
-    else if (!e.mods.isShiftDown())
-    {
-        if (validKey)
-        {
-            
-        }
-        else
-        {
-            keysDownPerMouse.set(mouseIndex, LumatoneKeyCoord());
-            keysOverPerMouse.set(mouseIndex, LumatoneKeyCoord());
-        }
     }
 }
 
@@ -698,3 +730,151 @@ void LumatoneKeyboardComponent::handleDeviceNoteOff(int midiChannel, int midiNot
 {
     noteOffInternal(midiChannel, midiNote);
 }
+
+//==============================================================================
+// Batched rendering
+
+LumatoneKeyDisplay* LumatoneKeyboardComponent::getKeyDisplay(int keyNum) const
+{
+    return octaveBoards[keyNum / currentOctaveSize]->keyMiniDisplay[keyNum % currentOctaveSize];
+}
+
+int LumatoneKeyboardComponent::getKeyNumAt(juce::Point<float> position)
+{
+    if (lumatoneBounds.isEmpty())
+        return -1;
+
+    // Key centres are laid out relative to the graphic bounds
+    auto relativePosition = juce::Point<float>(
+        (position.x - lumatoneBounds.getX()) / (float)lumatoneBounds.getWidth(),
+        (position.y - lumatoneBounds.getY()) / (float)lumatoneBounds.getHeight()
+    );
+
+    auto coordinate = lumatoneRender.getLumatoneTiling().getSkewedHexagonAt(relativePosition);
+    if (!keyCoordinateBounds.contains(coordinate))
+        return -1;
+
+    const int lookupIndex = (coordinate.y - keyCoordinateBounds.getY()) * keyCoordinateBounds.getWidth()
+                          + (coordinate.x - keyCoordinateBounds.getX());
+
+    return keyNumByCoordinate[lookupIndex];
+}
+
+void LumatoneKeyboardComponent::updateKeyNumLookup()
+{
+    auto keyCoordinates = lumatoneRender.getKeyCoordinates();
+
+    keyNumByCoordinate.clearQuick();
+    if (keyCoordinates.size() == 0)
+    {
+        keyCoordinateBounds = juce::Rectangle<int>();
+        return;
+    }
+
+    int left = keyCoordinates[0].x, right = left;
+    int top = keyCoordinates[0].y, bottom = top;
+
+    for (auto coordinate : keyCoordinates)
+    {
+        left = juce::jmin(left, coordinate.x);
+        right = juce::jmax(right, coordinate.x);
+        top = juce::jmin(top, coordinate.y);
+        bottom = juce::jmax(bottom, coordinate.y);
+    }
+
+    keyCoordinateBounds = juce::Rectangle<int>(left, top, right - left + 1, bottom - top + 1);
+    keyNumByCoordinate.insertMultiple(0, -1, keyCoordinateBounds.getWidth() * keyCoordinateBounds.getHeight());
+
+    for (int keyNum = 0; keyNum < keyCoordinates.size(); keyNum++)
+    {
+        const int lookupIndex = (keyCoordinates[keyNum].y - top) * keyCoordinateBounds.getWidth() + (keyCoordinates[keyNum].x - left);
+
+        // Octave boards shouldn't overlap
+        jassert(keyNumByCoordinate[lookupIndex] < 0);
+        keyNumByCoordinate.set(lookupIndex, keyNum);
+    }
+}
+
+void LumatoneKeyboardComponent::paintKeysBatched(juce::Graphics& g)
+{
+    const auto clipBounds = g.getClipBounds();
+
+    for (int keyNum = 0; keyNum < numKeys; keyNum++)
+    {
+        const auto& bounds = keyBounds.getReference(keyNum);
+        if (!clipBounds.intersects(bounds))
+            continue;
+
+        const juce::Colour drawColour = juce::Colour(keyDrawColours[keyNum]);
+
+        if (renderMode == LumatoneComponentRenderMode::MaxRes)
+        {
+            // Key colours are already in the render, only highlights are drawn over it
+            if (drawColour != getKeyDisplay(keyNum)->colour && keyShadowGraphic.isValid())
+            {
+                g.setColour(drawColour.overlaidWith(juce::Colours::black.withAlpha(0.88f)));
+                g.drawImageAt(keyShadowGraphic, bounds.getX(), bounds.getY(), true);
+            }
+            continue;
+        }
+
+        g.setColour(drawColour);
+
+        if (keyShapeGraphic.isValid())
+            g.drawImageAt(keyShapeGraphic, bounds.getX(), bounds.getY(), true);
+
+        if (keyShadowGraphic.isValid())
+            g.drawImageAt(keyShadowGraphic, bounds.getX(), bounds.getY());
+    }
+}
+
+void LumatoneKeyboardComponent::invalidateKey(int keyNum)
+{
+    if (!juce::isPositiveAndBelow(keyNum, numKeys))
+        return;
+
+    const juce::uint32 argb = getKeyDisplay(keyNum)->getDrawColour(keyNum == mouseOverKeyNum).getARGB();
+    if (argb == keyDrawColours[keyNum])
+        return;
+
+    keyDrawColours[keyNum] = argb;
+
+    dirtyKeyBounds.add(keyBounds.getReference(keyNum));
+    triggerAsyncUpdate();
+}
+
+void LumatoneKeyboardComponent::updateKeyDrawColours()
+{
+    for (int keyNum = 0; keyNum < numKeys; keyNum++)
+        keyDrawColours[keyNum] = getKeyDisplay(keyNum)->getDrawColour(keyNum == mouseOverKeyNum).getARGB();
+}
+
+void LumatoneKeyboardComponent::setMouseOverKey(int keyNum)
+{
+    if (keyNum == mouseOverKeyNum)
+        return;
+
+    const int lastKeyNum = mouseOverKeyNum;
+    mouseOverKeyNum = keyNum;
+
+    invalidateKey(lastKeyNum);
+    invalidateKey(keyNum);
+}
+
+void LumatoneKeyboardComponent::handleAsyncUpdate()
+{
+    if (dirtyKeyBounds.isEmpty())
+        return;
+
+    dirtyKeyBounds.consolidate();
+
+    if (dirtyKeyBounds.getNumRectangles() > maxDirtyKeyRegions)
+        repaint(dirtyKeyBounds.getBounds());
+    else
+    {
+        for (auto& bounds : dirtyKeyBounds)
+            repaint(bounds);
+    }
+
+    dirtyKeyBounds.clear();
+}
@@ -34,7 +34,8 @@ class LumatoneKeyboardComponent : public juce::Component,
                                   public LumatoneApplicationState,
                                   public LumatoneMidiState,
                                   public LumatoneEditor::EditorListener,
-                                  public LumatoneEditor::MidiListener
+                                  public LumatoneEditor::MidiListener,
+                                  private juce::AsyncUpdater
 {
 public:
     LumatoneKeyboardComponent(LumatoneController* controllerIn);
@@ -48,15 +49,19 @@ public:
     LumatoneComponentRenderMode getRenderMode() const { return renderMode; }
     void setRenderMode(LumatoneComponentRenderMode modeIn);
 
+    // Draw all keys from this component rather than one child component per key
+    bool isBatchedRendering() const { return batchedRendering; }
+    void setBatchedRendering(bool drawKeysBatched);
+
 public:
     // LumatoneEditor::EditorListener Implementation
-    void completeMappingLoaded(LumatoneLayout mappingData) override;
-    void boardChanged(LumatoneBoard boardData) override;
+    void completeMappingLoaded(const LumatoneLayout& mappingData) override;
+    void boardChanged(const LumatoneBoard& boardData) override;
     void contextChanged(LumatoneContext* newOrEmptyContext) override; 
-    void keyChanged(int boardIndex, int keyIndex, LumatoneKey lumatoneKey) override;
-    void keyConfigChanged(int boardIndex, int keyIndex, LumatoneKey keyData) override;
+    void keyChanged(int boardIndex, int keyIndex, const LumatoneKey& lumatoneKey) override;
+    void keyConfigChanged(int boardIndex, int keyIndex, const LumatoneKey& keyData) override;
     void keyColourChanged(int octaveNumber, int keyNumber, juce::Colour keyColour) override;
-    void selectionChanged(juce::Array<MappedLumatoneKey> selection) override;
+    void keysChanged(const LumatoneKeyChangeSet& changedKeys) override;
 private:
 
     void updateKeyColour(int boardIndex, int keyIndex, const juce::Colour& colour);
@@ -65,6 +70,8 @@ private:
     void keyUpdateCallback(int boardIndex, int keyIndex, const LumatoneKey& keyData, bool doRepaint=true);
     void mappingUpdateCallback();
 
+    void repaintKey(int boardIndex, int keyIndex);
+
 public:
     // Playing mode methods
     
@@ -86,6 +93,7 @@ protected:
     void mouseDown(const juce::MouseEvent& e) override;
     void mouseUp(const juce::MouseEvent& e) override;
     void mouseDrag(const juce::MouseEvent& e) override;
+    void mouseExit(const juce::MouseEvent& e) override;
 
 private:
     bool keyStateChanged(bool isKeyDown) override;
@@ -121,10 +129,35 @@ private:
 
 
 private:
-    LumatoneKeyDisplay* getKeyFromMouseEvent(const juce::MouseEvent& e);
+    LumatoneKeyCoord getKeyCoordFromMouseEvent(const juce::MouseEvent& e);
+
+    // Forgets the key held by a mouse or touch, and sends its note off unless sustained or held by another one
+    void releaseKeyForMouse(int mouseIndex, bool sendNoteOff=true);
 
     void rerender();
 
+private:
+    // Batched rendering
+
+    int getKeyNum(int boardIndex, int keyIndex) const { return boardIndex * currentOctaveSize + keyIndex; }
+    LumatoneKeyDisplay* getKeyDisplay(int keyNum) const;
+
+    // Returns the key whose hexagon contains the position, or -1
+    int getKeyNumAt(juce::Point<float> position);
+
+    void updateKeyNumLookup();
+
+    void paintKeysBatched(juce::Graphics& g);
+
+    // Refreshes the packed draw colour of a key and marks it dirty if it changed
+    void invalidateKey(int keyNum);
+    void updateKeyDrawColours();
+
+    void setMouseOverKey(int keyNum);
+
+    // Repaints the keys invalidated since the last frame
+    void handleAsyncUpdate() override;
+
 private:
 
     LumatoneController* controller;
@@ -154,11 +187,8 @@ private:
 
     juce::MidiKeyboardState* realtimeKeyboardState = nullptr;
 
-    LumatoneKeyDisplay* lastMouseKeyDown = nullptr;
-    LumatoneKeyDisplay* lastMouseKeyOver = nullptr;
-
-    juce::Array<LumatoneKeyCoord> keysOverPerMouse;
-    juce::Array<LumatoneKeyCoord> keysDownPerMouse; // future compatibility with touchpad
+    // Indexed by juce::MouseInputSource index, so each touch holds its own key
+    juce::Array<LumatoneKeyCoord> keysDownPerMouse;
 
     juce::Array<LumatoneKeyDisplay*> keysOn;
 
@@ -191,6 +221,26 @@ private:
 
     juce::Image currentRender;
 
+    //==============================================================================
+    // Batched rendering
+
+    bool batchedRendering = false;
+
+    int numKeys = 0;
+    juce::HeapBlock<juce::uint32> keyDrawColours;   // ARGB, indexed by key number
+    juce::Array<juce::Rectangle<int>> keyBounds;
+
+    juce::RectangleList<int> dirtyKeyBounds;
+
+    int mouseOverKeyNum = -1;
+
+    //==============================================================================
+    // Hit testing
+
+    // Key numbers by tiling coordinates, -1 where there's no key
+    juce::Rectangle<int> keyCoordinateBounds;
+    juce::Array<int> keyNumByCoordinate;
+
     //==============================================================================
     // Position and sizing constants in reference to parent bounds
 
@@ -205,6 +255,9 @@ private:
     const float keyW = 0.027352f;
     const float keyH = 0.07307f;
 
+    // Past this many separate dirty regions, one repaint of their bounds is cheaper
+    const int maxDirtyKeyRegions = 16;
+
     //[/UserVariables]
 
     //==============================================================================
@@ -13,6 +13,79 @@
 
 using namespace LumatoneEditAction;
 
+// ==============================================================================
+// Implementation of KeyDeltaAction
+
+KeyDeltaAction::KeyDeltaAction(LumatoneController* controller, juce::String nameIn, bool bufferKeyUpdates)
+    : LumatoneAction(controller, nameIn)
+    , useKeyBuffer(bufferKeyUpdates)
+{
+}
+
+KeyDeltaAction::KeyDeltaAction(LumatoneController* controller, juce::String nameIn, const LumatoneKeyDelta& deltaIn, bool bufferKeyUpdates)
+    : LumatoneAction(controller, nameIn)
+    , delta(deltaIn)
+    , useKeyBuffer(bufferKeyUpdates)
+    , deltaRecorded(true)
+{
+}
+
+bool KeyDeltaAction::perform()
+{
+    if (!deltaRecorded)
+    {
+        delta.clear();
+        recordDelta();
+        delta.compact(!keepStorage);
+        deltaRecorded = true;
+    }
+
+    sendDelta(true);
+    return true;
+}
+
+bool KeyDeltaAction::undo()
+{
+    jassert(deltaRecorded);
+    sendDelta(false);
+    return true;
+}
+
+juce::UndoableAction* KeyDeltaAction::createCoalescedAction(juce::UndoableAction* nextAction)
+{
+    auto nextKeyAction = dynamic_cast<KeyDeltaAction*>(nextAction);
+    if (nextKeyAction == nullptr || !deltaRecorded || !nextKeyAction->deltaRecorded || nextKeyAction->useKeyBuffer != useKeyBuffer)
+        return nullptr;
+
+    return new KeyDeltaAction(controller, name, LumatoneKeyDelta::merge(delta, nextKeyAction->delta), useKeyBuffer);
+}
+
+void KeyDeltaAction::sendDelta(bool useNewValues)
+{
+    if (delta.isEmpty())
+        return;
+
+    LumatoneKeyChangeSet changedKeys;
+
+    delta.forEachKey(*controller->getMappingData(), useNewValues, [&](const MappedLumatoneKey& key, juce::uint8 fieldMask)
+    {
+        // Colour first, the buffered config update reads the pending colour
+        if (fieldMask & LumatoneKeyDelta::colourFieldMask)
+        {
+            controller->sendKeyColourConfig(key.boardIndex + 1, key.keyIndex, key.colour, false, useKeyBuffer);
+            changedKeys.addKey(key.boardIndex, key.keyIndex, LumatoneKeyChangeSet::colour);
+        }
+
+        if (fieldMask & LumatoneKeyDelta::configFieldMask)
+        {
+            controller->sendKeyConfig(key.boardIndex + 1, key.keyIndex, key, false, useKeyBuffer);
+            changedKeys.addKey(key.boardIndex, key.keyIndex, LumatoneKeyChangeSet::config);
+        }
+    });
+
+    controller->notifyKeysChanged(changedKeys);
+}
+
 // ==============================================================================
 // Implementation of SingleNoteAssignAction
 SingleNoteAssignAction::SingleNoteAssignAction(
@@ -29,12 +102,15 @@ SingleNoteAssignAction::SingleNoteAssignAction(
     int newNoteNumber, 
     juce::Colour newColour,
     bool newCCFaderIsDefault)
-    : LumatoneAction(controller, "SingleNoteAssign")
+    : KeyDeltaAction(controller, "SingleNoteAssign")
     , boardId(boardIndexIn + 1), keyIndex(keyIndexIn)
-    , setKeyType(setKeyType), setChannel(setChannel), setNote(setNote), setColour(setColour), setCCFaderPolarity(setCCPolarity)
     , newData(newKeyType, newChannelNumber, newNoteNumber, newColour, newCCFaderIsDefault)
 {
-    previousData = *controller->getKey(boardIndexIn, keyIndexIn);
+    fieldMask = (setKeyType ? 1 << LumatoneKeyDelta::keyType : 0)
+              | (setChannel ? 1 << LumatoneKeyDelta::channelNumber : 0)
+              | (setNote ? 1 << LumatoneKeyDelta::noteNumber : 0)
+              | (setColour ? 1 << LumatoneKeyDelta::colour : 0)
+              | (setCCPolarity ? 1 << LumatoneKeyDelta::ccFaderDefault : 0);
 }
 
 SingleNoteAssignAction::SingleNoteAssignAction(
@@ -54,59 +130,13 @@ bool SingleNoteAssignAction::isValid() const
 
 bool SingleNoteAssignAction::perform()
 {
-    if (boardId > 0 && boardId <= numOctaveBoards && keyIndex >= 0 && keyIndex < octaveBoardSize)
+    if (isValid())
     {
-        LumatoneKey resultKey = previousData;
-        if (setKeyType || setChannel || setNote || setColour || setCCFaderPolarity)
-        {
-            
-            if (setKeyType)
-            {
-                resultKey.keyType = newData.keyType;
-            }
-            if (setChannel)
-            {
-                resultKey.channelNumber = newData.channelNumber;
-            }
-            if (setNote)
-            {
-                resultKey.noteNumber = newData.noteNumber;
-            }
-            if (setColour)
-            {
-                resultKey.colour = newData.colour;
-            }
-            if (setCCFaderPolarity)
-            {
-                resultKey.ccFaderDefault = newData.ccFaderDefault;
-            }
-
-            newData = resultKey;
-
-            bool onlyColor = setColour && !(setKeyType || setChannel || setNote || setCCFaderPolarity);
-            
-            if (onlyColor)
-            {
-                controller->sendKeyColourConfig(boardId, keyIndex, newData);
-            }
-            else
-            {
-                // Send to device
-                controller->sendKeyParam(
-                    boardId,
-                    keyIndex,
-                    newData);
-            }
-
-            // Notfy that there are changes: in calling function
-        }
-        else
-        {
-            // Nothing to do
-            jassertfalse;
-        }
+        // No fields to set
+        jassert(fieldMask != 0);
 
-        return true;
+        // Notify that there are changes: in calling function
+        return KeyDeltaAction::perform();
     }
     else
     {
@@ -115,70 +145,24 @@ bool SingleNoteAssignAction::perform()
     }
 }
 
-bool SingleNoteAssignAction::undo()
+void SingleNoteAssignAction::recordDelta()
 {
-    if (boardId > 0 && boardId <= numOctaveBoards && keyIndex >= 0 && keyIndex < octaveBoardSize)
-    {
-        if (setKeyType || setChannel || setNote || setColour || setCCFaderPolarity)
-        {
-            LumatoneKey resultKey = newData;
-
-            if (setKeyType)
-            {
-                resultKey.keyType = previousData.keyType;
-            }
-            if (setChannel)
-            {
-                resultKey.channelNumber = previousData.channelNumber;
-            }
-            if (setNote)
-            {
-                resultKey.noteNumber = previousData.noteNumber;
-            }
-            if (setColour)
-            {
-                resultKey.colour = previousData.colour;
-            }
-            if (setCCFaderPolarity)
-            {
-                resultKey.ccFaderDefault = previousData.ccFaderDefault;
-            }
-
-            previousData = resultKey;
-
-            // Send to device
-            controller->sendKeyParam(
-                boardId,
-                keyIndex,
-                previousData);
-
-            // Notify that there are changes: in calling function
-        }
-        else
-        {
-            // Nothing to do
-            jassertfalse;
-        }
-
-        return true;
-    }
-    else
-    {
-        jassertfalse;
-        return false;
-    }
+    delta.addKey(boardId - 1, keyIndex, *controller->getKey(boardId - 1, keyIndex), newData, fieldMask);
 }
 
 // ==============================================================================
 // Implementation of SectionEditAction
 
 SectionEditAction::SectionEditAction(LumatoneController* controller, int boardIndexIn, const LumatoneBoard& newSectionValue, bool bufferKeyUpdates)
-    : LumatoneAction(controller, "SectionEdit")
+    : SectionEditAction(controller, boardIndexIn, std::make_shared<const LumatoneBoard>(newSectionValue), bufferKeyUpdates)
+{
+}
+
+SectionEditAction::SectionEditAction(LumatoneController* controller, int boardIndexIn, std::shared_ptr<const LumatoneBoard> newSectionValue, bool bufferKeyUpdates)
+    : KeyDeltaAction(controller, "SectionEdit", bufferKeyUpdates)
     , boardId(boardIndexIn + 1)
     , newData(newSectionValue)
-    , useKeyBuffer(bufferKeyUpdates)
 {
-    previousData = *controller->getBoard(boardIndexIn);
 }
 
 bool SectionEditAction::isValid() const
@@ -190,11 +174,8 @@ bool SectionEditAction::perform()
 {
     if (boardId > 0 && boardId <= controller->getNumBoards())
     {
-        // Send to device
-        controller->sendAllParamsOfBoard(boardId, &newData, true, useKeyBuffer);
-
-        // Notify that there are changes: in calling function
-        return true;
+        // Send to device, notify that there are changes: in calling function
+        return KeyDeltaAction::perform();
     }
     else
     {
@@ -203,68 +184,84 @@ bool SectionEditAction::perform()
     }
 }
 
-bool SectionEditAction::undo()
+void SectionEditAction::recordDelta()
 {
-    if (boardId >= 0 && boardId <= numOctaveBoards)
-    {
-        // Send to device
-        controller->sendAllParamsOfBoard(boardId, &previousData, true, useKeyBuffer);
+    const int boardIndex = boardId - 1;
 
-        // Notify that there are changes: in calling function
-        return true;
-    }
-    else
-    {
-        jassertfalse;
-        return false;
-    }
+    for (int keyIndex = 0; keyIndex < controller->getOctaveBoardSize(); keyIndex++)
+        delta.addKey(boardIndex, keyIndex, *controller->getKey(boardIndex, keyIndex), newData->theKeys[keyIndex]);
 
+    newData.reset();
 }
 
+// ==============================================================================
+// Implementation of MultiKeyAssignAction
 
 MultiKeyAssignAction::MultiKeyAssignAction(LumatoneController* controller, const juce::Array<MappedLumatoneKey>& updatedKeys, bool setConfigIn, bool setColourIn, bool bufferKeyUpdates)
-    : LumatoneAction(controller, "MultiKeyAssign")
-    , useKeyBuffer(bufferKeyUpdates)
+    : KeyDeltaAction(controller, "MultiKeyAssign", bufferKeyUpdates)
+    , newData(updatedKeys)
     , setConfig(setConfigIn)
     , setColours(setColourIn)
 {
-    for (auto updatedKey : updatedKeys)
-    {
-        auto coord = updatedKey.getKeyCoord();
-        if (controller->getMappingData()->isKeyCoordValid(coord))
-        {
-            newData.add(updatedKey);
+}
 
-            auto key = controller->getKey(coord.boardIndex, coord.keyIndex);
-            previousKeys.add(MappedLumatoneKey(*key, coord));
-        }
+MultiKeyAssignAction::MultiKeyAssignAction(LumatoneController* controller, const juce::Array<MappedLumatoneKey>& updatedKeys, const juce::Array<MappedLumatoneKey>& keysBeforeEdit, bool setConfigIn, bool setColourIn, bool bufferKeyUpdates)
+    : KeyDeltaAction(controller, "MultiKeyAssign", bufferKeyUpdates)
+    , setConfig(setConfigIn)
+    , setColours(setColourIn)
+{
+    jassert(updatedKeys.size() == keysBeforeEdit.size());
+
+    const int numKeys = juce::jmin(updatedKeys.size(), keysBeforeEdit.size());
+    for (int i = 0; i < numKeys; i++)
+    {
+        const auto& updatedKey = updatedKeys.getReference(i);
+        if (controller->getMappingData()->isKeyCoordValid(updatedKey.getKeyCoord()))
+            delta.addKey(updatedKey.boardIndex, updatedKey.keyIndex, keysBeforeEdit.getReference(i), updatedKey, getFieldMask());
     }
+
+    delta.compact();
+    deltaRecorded = true;
 }
 
-bool MultiKeyAssignAction::isValid() const
+void MultiKeyAssignAction::reassign(const juce::Array<MappedLumatoneKey>& updatedKeys, bool setConfigIn, bool setColourIn, bool bufferKeyUpdates)
 {
-    return newData.size() > 0 && newData.size() == previousKeys.size();
+    setConfig = setConfigIn;
+    setColours = setColourIn;
+    useKeyBuffer = bufferKeyUpdates;
+    keepStorage = true;
+
+    newData.clearQuick();
+    newData.addArray(updatedKeys);
+
+    delta.clear();
+    deltaRecorded = false;
 }
 
-void MultiKeyAssignAction::applyMappedKeyData(const juce::Array<MappedLumatoneKey>& newKeys, const juce::Array<MappedLumatoneKey>& oldKeys)
+juce::uint8 MultiKeyAssignAction::getFieldMask() const
 {
-    if (setConfig)
-        controller->sendSelectionParam(newKeys, false, useKeyBuffer);
-        
-    if (setColours)
-        controller->sendSelectionColours(newKeys, true, useKeyBuffer);
+    return (setConfig ? LumatoneKeyDelta::configFieldMask : 0)
+         | (setColours ? LumatoneKeyDelta::colourFieldMask : 0);
 }
 
-bool MultiKeyAssignAction::perform()
+void MultiKeyAssignAction::recordDelta()
 {
-    applyMappedKeyData(newData, previousKeys);
-    return true;
+    for (const auto& updatedKey : newData)
+    {
+        auto coord = updatedKey.getKeyCoord();
+        if (controller->getMappingData()->isKeyCoordValid(coord))
+            delta.addKey(coord.boardIndex, coord.keyIndex, *controller->getKey(coord.boardIndex, coord.keyIndex), updatedKey, getFieldMask());
+    }
+
+    if (keepStorage)
+        newData.clearQuick();
+    else
+        newData.clear();
 }
 
-bool MultiKeyAssignAction::undo()
+bool MultiKeyAssignAction::isValid() const
 {
-    applyMappedKeyData(previousKeys, newData);
-    return true;
+    return deltaRecorded ? !delta.isEmpty() : newData.size() > 0;
 }
 
 // ==============================================================================
@@ -10,11 +10,44 @@
 
 #pragma once
 #include "./lumatone_action.h"
-#include "../data/lumatone_layout.h"
+#include "./key_delta.h"
 
 namespace LumatoneEditAction {
 
-    class SingleNoteAssignAction : public LumatoneAction
+    // Key edit whose undo data is the set of changed fields, see LumatoneKeyDelta
+    class KeyDeltaAction : public LumatoneAction
+    {
+    public:
+        KeyDeltaAction(LumatoneController* controller, juce::String nameIn, bool bufferKeyUpdates=false);
+        KeyDeltaAction(LumatoneController* controller, juce::String nameIn, const LumatoneKeyDelta& deltaIn, bool bufferKeyUpdates=false);
+
+        bool perform() override;
+        bool undo() override;
+
+        int getSizeInUnits() override { return (int)sizeof(KeyDeltaAction) + delta.getSizeInBytes(); }
+
+        // Key edits performed within one transaction are merged into a single action
+        juce::UndoableAction* createCoalescedAction(juce::UndoableAction* nextAction) override;
+
+        const LumatoneKeyDelta& getDelta() const { return delta; }
+
+    protected:
+        // Fills the delta by comparing the edit to the current state, done on the first perform
+        virtual void recordDelta() {}
+
+        void sendDelta(bool useNewValues);
+
+    protected:
+        LumatoneKeyDelta delta;
+
+        bool useKeyBuffer = false;
+        bool deltaRecorded = false;
+
+        // Pooled actions are reassigned every game tick, so they keep their storage instead of trimming it
+        bool keepStorage = false;
+    };
+
+    class SingleNoteAssignAction : public KeyDeltaAction
     {
     public:
         SingleNoteAssignAction(
@@ -33,17 +66,14 @@ namespace LumatoneEditAction {
             bool newCCFaderDefault = true);
 
         SingleNoteAssignAction(const SingleNoteAssignAction& second)
-            : LumatoneAction(second.controller, "SingleNoteAssign")
+            : KeyDeltaAction(second.controller, "SingleNoteAssign", second.delta, second.useKeyBuffer)
             , boardId(second.boardId)
             , keyIndex(second.keyIndex)
-            , setKeyType(second.setKeyType)
-            , setChannel(second.setChannel)
-            , setNote(second.setNote)
-            , setColour(second.setColour)
-            , setCCFaderPolarity(second.setCCFaderPolarity)
-            , previousData(second.previousData)
+            , fieldMask(second.fieldMask)
             , newData(second.newData)
-        {}
+        {
+            deltaRecorded = second.deltaRecorded;
+        }
 
         SingleNoteAssignAction(
             LumatoneController* controller,
@@ -55,82 +85,89 @@ namespace LumatoneEditAction {
         bool isValid() const;
 
         bool perform() override;
-        bool undo() override;
-        
-        int getSizeInUnits() override { return sizeof(SingleNoteAssignAction); }
+
+        int getSizeInUnits() override { return (int)sizeof(SingleNoteAssignAction) + delta.getSizeInBytes(); }
+
+    protected:
+        void recordDelta() override;
 
     private:
         int boardId = - 1;
         int keyIndex = -1;
 
-        bool setKeyType = false;
-        bool setChannel = false;
-        bool setNote = false;
-        bool setColour = false;
-        bool setCCFaderPolarity = false;
+        juce::uint8 fieldMask = 0;
 
-        LumatoneKey previousData;
         LumatoneKey newData;
     };
 
-    class SectionEditAction : public LumatoneAction
+    class SectionEditAction : public KeyDeltaAction
     {
     public:
         SectionEditAction(LumatoneController* controller, int boardIndexIn, const LumatoneBoard& newSectionValue, bool bufferKeyUpdates=false);
 
+        // Shares the board instead of copying it, see LumatoneLayout::shareBoard
+        SectionEditAction(LumatoneController* controller, int boardIndexIn, std::shared_ptr<const LumatoneBoard> newSectionValue, bool bufferKeyUpdates=false);
+
         SectionEditAction(const SectionEditAction& second)
-            : LumatoneAction(second.controller, "SectionEditAction")
+            : KeyDeltaAction(second.controller, "SectionEdit", second.delta, second.useKeyBuffer)
             , boardId(second.boardId)
-            , previousData(second.previousData)
             , newData(second.newData)
-            , useKeyBuffer(second.useKeyBuffer)
-        {}
+        {
+            deltaRecorded = second.deltaRecorded;
+        }
 
         bool isValid() const;
 
         bool perform() override;
-        bool undo() override;
-        int getSizeInUnits() override { return sizeof(SectionEditAction); }
+
+        int getSizeInUnits() override { return (int)sizeof(SectionEditAction) + delta.getSizeInBytes(); }
+
+    protected:
+        void recordDelta() override;
 
     private:
         int boardId = -1;
 
-        LumatoneBoard previousData;
-        LumatoneBoard newData;
-
-        bool useKeyBuffer;
+        // Released once the delta is recorded
+        std::shared_ptr<const LumatoneBoard> newData;
     };
 
-    class MultiKeyAssignAction : public LumatoneAction
+    class MultiKeyAssignAction : public KeyDeltaAction
     {
     public:
         MultiKeyAssignAction(LumatoneController* controller, const juce::Array<MappedLumatoneKey>& updatedKeys, bool setConfig=true, bool setColour=true, bool bufferKeyUpdates=false);
+
+        // For edits already sent to the device, with the key data to restore on undo
+        MultiKeyAssignAction(LumatoneController* controller, const juce::Array<MappedLumatoneKey>& updatedKeys, const juce::Array<MappedLumatoneKey>& keysBeforeEdit, bool setConfig=true, bool setColour=true, bool bufferKeyUpdates=false);
+
         MultiKeyAssignAction(const MultiKeyAssignAction& copy)
-            : LumatoneAction(copy.controller, "MultiKeyAssign")
-			, previousKeys(copy.previousKeys)
+            : KeyDeltaAction(copy.controller, "MultiKeyAssign", copy.delta, copy.useKeyBuffer)
             , newData(copy.newData)
             , setConfig(copy.setConfig)
             , setColours(copy.setColours)
-            , useKeyBuffer(copy.useKeyBuffer)
-        {}
+        {
+            deltaRecorded = copy.deltaRecorded;
+        }
 
         bool isValid() const;
 
-        bool perform() override;
-		bool undo() override;
+        // Reuse this action for a new set of keys, keeping allocated storage
+        void reassign(const juce::Array<MappedLumatoneKey>& updatedKeys, bool setConfig=true, bool setColour=true, bool bufferKeyUpdates=false);
 
-		int getSizeInUnits() override { return sizeof(MultiKeyAssignAction); }
+		int getSizeInUnits() override { return (int)sizeof(MultiKeyAssignAction) + delta.getSizeInBytes() + newData.getNumAllocated() * (int)sizeof(MappedLumatoneKey); }
+
+    protected:
+        void recordDelta() override;
 
 	private:
-		void applyMappedKeyData(const juce::Array<MappedLumatoneKey>& newKeys, const juce::Array<MappedLumatoneKey>& oldKeys);
+		juce::uint8 getFieldMask() const;
 
 	private:
+		// Cleared once the delta is recorded
+		juce::Array<MappedLumatoneKey> newData;
+
         bool setConfig = true;
         bool setColours = true;
-        bool useKeyBuffer = false;
-
-		juce::Array<MappedLumatoneKey> previousKeys;
-		juce::Array<MappedLumatoneKey> newData;
     };
 
     class InvertFootControllerEditAction : public LumatoneAction
@@ -0,0 +1,159 @@
+/*
+  ==============================================================================
+
+    key_delta.cpp
+    Created: 19 Oct 2026
+    Author:  Vincenzo
+
+  ==============================================================================
+*/
+
+#include "key_delta.h"
+
+static_assert(sizeof(LumatoneKeyDelta::Change) == 12, "LumatoneKeyDelta::Change should stay packed");
+
+void LumatoneKeyDelta::addKey(int boardIndex, int keyIndex, const LumatoneKey& before, const LumatoneKey& after, juce::uint8 fieldMask)
+{
+    jassert(boardIndex >= 0 && boardIndex < MAXNUMBOARDS && keyIndex >= 0 && keyIndex < MAXBOARDSIZE);
+
+    for (int field = 0; field < numFields; field++)
+    {
+        if ((fieldMask & (1 << field)) == 0)
+            continue;
+
+        Change change;
+        change.keyNum = (juce::uint16)(boardIndex * MAXBOARDSIZE + keyIndex);
+        change.field = (juce::uint8)field;
+        change.reserved = 0;
+        change.oldValue = getFieldValue(before, (Field)field);
+        change.newValue = getFieldValue(after, (Field)field);
+
+        if (change.oldValue != change.newValue)
+            changes.add(change);
+    }
+}
+
+void LumatoneKeyDelta::compact(bool trimStorage)
+{
+    // Stable, so repeated edits of one field stay in the order they were added
+    std::stable_sort(changes.begin(), changes.end(), isBefore);
+
+    int numKept = 0;
+    for (int i = 0; i < changes.size(); i++)
+    {
+        auto change = changes.getReference(i);
+
+        if (numKept > 0 && isSameField(changes.getReference(numKept - 1), change))
+        {
+            changes.getReference(numKept - 1).newValue = change.newValue;
+            continue;
+        }
+
+        changes.getReference(numKept++) = change;
+    }
+
+    changes.removeRange(numKept, changes.size() - numKept);
+    changes.removeIf([](const Change& change) { return change.oldValue == change.newValue; });
+
+    if (trimStorage)
+        changes.minimiseStorageOverheads();
+}
+
+void LumatoneKeyDelta::forEachKey(const LumatoneLayout& layout, bool useNewValues, std::function<void(const MappedLumatoneKey&, juce::uint8)> keyFnc) const
+{
+    int i = 0;
+    while (i < changes.size())
+    {
+        const int keyNum = changes.getReference(i).keyNum;
+        const int boardIndex = keyNum / MAXBOARDSIZE;
+        const int keyIndex = keyNum % MAXBOARDSIZE;
+
+        MappedLumatoneKey key(*layout.readKey(boardIndex, keyIndex), boardIndex, keyIndex);
+        juce::uint8 fieldMask = 0;
+
+        for (; i < changes.size() && changes.getReference(i).keyNum == keyNum; i++)
+        {
+            const auto& change = changes.getReference(i);
+            setFieldValue(key, (Field)change.field, useNewValues ? change.newValue : change.oldValue);
+            fieldMask |= (juce::uint8)(1 << change.field);
+        }
+
+        keyFnc(key, fieldMask);
+    }
+}
+
+LumatoneKeyDelta LumatoneKeyDelta::merge(const LumatoneKeyDelta& first, const LumatoneKeyDelta& second)
+{
+    LumatoneKeyDelta merged;
+    merged.changes.ensureStorageAllocated(first.changes.size() + second.changes.size());
+
+    int a = 0, b = 0;
+    while (a < first.changes.size() || b < second.changes.size())
+    {
+        if (b == second.changes.size() || (a < first.changes.size() && isBefore(first.changes.getReference(a), second.changes.getReference(b))))
+        {
+            merged.changes.add(first.changes.getReference(a++));
+        }
+        else if (a == first.changes.size() || isBefore(second.changes.getReference(b), first.changes.getReference(a)))
+        {
+            merged.changes.add(second.changes.getReference(b++));
+        }
+        else
+        {
+            // Both edited this field, keep the value from before the first and the one after the second
+            auto change = first.changes.getReference(a++);
+            change.newValue = second.changes.getReference(b++).newValue;
+
+            if (change.oldValue != change.newValue)
+                merged.changes.add(change);
+        }
+    }
+
+    merged.changes.minimiseStorageOverheads();
+    return merged;
+}
+
+juce::uint32 LumatoneKeyDelta::getFieldValue(const LumatoneKey& key, Field field)
+{
+    switch (field)
+    {
+    case noteNumber:
+        return (juce::uint32)key.noteNumber;
+    case channelNumber:
+        return (juce::uint32)key.channelNumber;
+    case keyType:
+        return (juce::uint32)key.keyType;
+    case ccFaderDefault:
+        return key.ccFaderDefault ? 1 : 0;
+    case colour:
+        return key.colour.getARGB();
+    default:
+        jassertfalse;
+        return 0;
+    }
+}
+
+void LumatoneKeyDelta::setFieldValue(LumatoneKey& key, Field field, juce::uint32 value)
+{
+    switch (field)
+    {
+    case noteNumber:
+        key.noteNumber = (int)value;
+        break;
+    case channelNumber:
+        key.channelNumber = (int)value;
+        break;
+    case keyType:
+        key.keyType = (LumatoneKeyType)value;
+        break;
+    case ccFaderDefault:
+        key.ccFaderDefault = value != 0;
+        break;
+    case colour:
+        key.colour = juce::Colour(value);
+        break;
+    default:
+        jassertfalse;
+        break;
+    }
+}
@@ -0,0 +1,86 @@
+/*
+  ==============================================================================
+
+    key_delta.h
+    Created: 19 Oct 2026
+    Author:  Vincenzo
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../data/lumatone_layout.h"
+
+/*
+==============================================================================
+Packed record of key field edits, used as undo data.
+
+Only fields that actually changed are stored, one 12 byte entry each with the
+value before and after, kept sorted by key and field. Applying it in either
+direction touches only the changed keys.
+==============================================================================
+*/
+class LumatoneKeyDelta
+{
+public:
+    enum Field
+    {
+        noteNumber = 0,
+        channelNumber,
+        keyType,
+        ccFaderDefault,
+        colour,
+        numFields
+    };
+
+    // Fields sent with a key config message, the colour is sent separately
+    static constexpr juce::uint8 configFieldMask = (1 << noteNumber) | (1 << channelNumber) | (1 << keyType) | (1 << ccFaderDefault);
+    static constexpr juce::uint8 colourFieldMask = (1 << colour);
+
+    struct Change
+    {
+        juce::uint16 keyNum;    // boardIndex * MAXBOARDSIZE + keyIndex
+        juce::uint8 field;
+        juce::uint8 reserved;
+        juce::uint32 oldValue;
+        juce::uint32 newValue;
+
+        int getBoardIndex() const { return keyNum / MAXBOARDSIZE; }
+        int getKeyIndex() const { return keyNum % MAXBOARDSIZE; }
+    };
+
+public:
+    LumatoneKeyDelta() {}
+
+    // Appends the fields in fieldMask that differ between the two keys, call compact() when done adding
+    void addKey(int boardIndex, int keyIndex, const LumatoneKey& before, const LumatoneKey& after, juce::uint8 fieldMask=configFieldMask | colourFieldMask);
+
+    // Sorts by key, merges repeated edits of the same field and drops edits that cancel out
+    void compact(bool trimStorage=true);
+
+    void clear() { changes.clearQuick(); }
+
+    bool isEmpty() const { return changes.size() == 0; }
+    int getNumChanges() const { return changes.size(); }
+    const Change& getChange(int index) const { return changes.getReference(index); }
+
+    // Heap and object footprint, for undo history accounting
+    int getSizeInBytes() const { return (int)sizeof(LumatoneKeyDelta) + changes.getNumAllocated() * (int)sizeof(Change); }
+
+    // Calls keyFnc once per changed key, with the layout's key updated to the new or old values and a mask of the changed fields
+    void forEachKey(const LumatoneLayout& layout, bool useNewValues, std::function<void(const MappedLumatoneKey&, juce::uint8)> keyFnc) const;
+
+    // Same as applying first, then second
+    static LumatoneKeyDelta merge(const LumatoneKeyDelta& first, const LumatoneKeyDelta& second);
+
+    static juce::uint32 getFieldValue(const LumatoneKey& key, Field field);
+    static void setFieldValue(LumatoneKey& key, Field field, juce::uint32 value);
+
+private:
+    static bool isBefore(const Change& a, const Change& b) { return a.keyNum < b.keyNum || (a.keyNum == b.keyNum && a.field < b.field); }
+    static bool isSameField(const Change& a, const Change& b) { return a.keyNum == b.keyNum && a.field == b.field; }
+
+private:
+    juce::Array<Change> changes;
+};
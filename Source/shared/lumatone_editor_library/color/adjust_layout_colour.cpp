@@ -9,6 +9,7 @@ AdjustLayoutColour::AdjustLayoutColour(LumatoneController* controllerIn)
 
 AdjustLayoutColour::~AdjustLayoutColour()
 {
+    stopTimer();
 }
 
 void AdjustLayoutColour::replaceColour(juce::Colour oldColour, juce::Colour newColour, bool sendUpdate)
@@ -41,14 +42,8 @@ bool AdjustLayoutColour::rotateHue(float change, LumatoneKey& key)
 
 void AdjustLayoutColour::rotateHue(float change, bool sendUpdate)
 {
-    auto coords = currentLayout.getAllKeyCoords();
-    
     hueRotateValue = change;
-    auto updatedKeys = updateAdjustedColoursState(coords);
-    
-    // rotateHue(change, coords, false);
-    if (sendUpdate)
-        sendSelectionUpdate(updatedKeys, true);
+    applyAdjustments(sendUpdate);
 }
 
 void AdjustLayoutColour::rotateHue(float change, const juce::Array<LumatoneKeyCoord>& selection, bool sendUpdate)
@@ -63,7 +58,7 @@ void AdjustLayoutColour::rotateHue(float change, const juce::Array<LumatoneKeyCo
     for (auto coord : selection)
     {
         LumatoneKey key = *currentLayout.readKey(coord.boardIndex, coord.keyIndex);
-        key.colour = (&layoutBeforeAdjust.getBoard(coord.boardIndex)->theKeys[coord.keyIndex])->colour;
+        key.colour = layoutBeforeAdjust.readKey(coord.boardIndex, coord.keyIndex)->colour;
         if (rotateHue(change, key))
             updateKeys.add(MappedLumatoneKey(key, coord));
     }
@@ -83,14 +78,8 @@ bool AdjustLayoutColour::multiplyBrightness(float change, LumatoneKey& key)
 
 void AdjustLayoutColour::multiplyBrightness(float change, bool sendUpdate)
 {
-    auto coords = currentLayout.getAllKeyCoords();
-    
     multiplyBrightnessValue = change;
-    auto updatedKeys = updateAdjustedColoursState(coords);
-
-    // multiplyBrightness(change, coords, false);
-    if (sendUpdate)
-        sendSelectionUpdate(updatedKeys, true);
+    applyAdjustments(sendUpdate);
 }
 
 void AdjustLayoutColour::multiplyBrightness(float change, const juce::Array<LumatoneKeyCoord>& selection, bool sendUpdate)
@@ -105,7 +94,7 @@ void AdjustLayoutColour::multiplyBrightness(float change, const juce::Array<Luma
     for (auto coord : selection)
     {
         auto key = *currentLayout.readKey(coord.boardIndex, coord.keyIndex);
-        key.colour = (&layoutBeforeAdjust.getBoard(coord.boardIndex)->theKeys[coord.keyIndex])->colour;
+        key.colour = layoutBeforeAdjust.readKey(coord.boardIndex, coord.keyIndex)->colour;
         if (multiplyBrightness(change, key))
             updateKeys.add(MappedLumatoneKey(key, coord));
     }
@@ -125,14 +114,8 @@ bool AdjustLayoutColour::multiplySaturation(float change, LumatoneKey& key)
 
 void AdjustLayoutColour::multiplySaturation(float change, bool sendUpdate)
 {
-    auto coords = currentLayout.getAllKeyCoords();
-    
     multiplySaturationValue = change;
-    auto updatedKeys = updateAdjustedColoursState(coords);
-    
-    // multiplySaturation(change, coords, false);
-    if (sendUpdate)
-        sendSelectionUpdate(updatedKeys, true);
+    applyAdjustments(sendUpdate);
 }
 
 void AdjustLayoutColour::multiplySaturation(float change, const juce::Array<LumatoneKeyCoord>& selection, bool sendUpdate)
@@ -147,7 +130,7 @@ void AdjustLayoutColour::multiplySaturation(float change, const juce::Array<Luma
     for (auto coord : selection)
     {
         auto key = *currentLayout.readKey(coord.boardIndex, coord.keyIndex);
-        key.colour = (&layoutBeforeAdjust.getBoard(coord.boardIndex)->theKeys[coord.keyIndex])->colour;
+        key.colour = layoutBeforeAdjust.readKey(coord.boardIndex, coord.keyIndex)->colour;
 
         if (multiplySaturation(change, key))
             updateKeys.add(MappedLumatoneKey(key, coord));
@@ -159,14 +142,8 @@ void AdjustLayoutColour::multiplySaturation(float change, const juce::Array<Luma
 
 void AdjustLayoutColour::adjustWhiteBalance(int newWhitePoint, bool sendUpdate)
 {
-    auto coords = currentLayout.getAllKeyCoords();
-    
     whiteKelvinValue = newWhitePoint;
-    auto updatedKeys = updateAdjustedColoursState(coords);
-    
-    // multiplySaturation(change, coords, false);
-    if (sendUpdate)
-        sendSelectionUpdate(updatedKeys, true);
+    applyAdjustments(sendUpdate);
 }
 
 void AdjustLayoutColour::adjustWhiteBalance(int newWhitePoint, const juce::Array<LumatoneKeyCoord>& selection, bool sendUpdate)
@@ -181,7 +158,7 @@ void AdjustLayoutColour::adjustWhiteBalance(int newWhitePoint, const juce::Array
     for (auto coord : selection)
     {
         auto key = *currentLayout.readKey(coord.boardIndex, coord.keyIndex);
-        key.colour = (&layoutBeforeAdjust.getBoard(coord.boardIndex)->theKeys[coord.keyIndex])->colour;
+        key.colour = layoutBeforeAdjust.readKey(coord.boardIndex, coord.keyIndex)->colour;
 
         if (adjustWhiteBalance(newWhitePoint, key))
             updateKeys.add(MappedLumatoneKey(key, coord));
@@ -191,6 +168,12 @@ void AdjustLayoutColour::adjustWhiteBalance(int newWhitePoint, const juce::Array
         sendSelectionUpdate(updateKeys, true);
 }
 
+void AdjustLayoutColour::adjustContrast(float change, bool sendUpdate)
+{
+    contrastValue = change;
+    applyAdjustments(sendUpdate);
+}
+
 bool AdjustLayoutColour::adjustWhiteBalance(int newWhitePoint, LumatoneKey& key)
 {
     if (key.colour.isTransparent())
@@ -226,6 +209,93 @@ void AdjustLayoutColour::adjustWhiteBalanceLab(int newWhitePoint, LumatoneKey& k
     key.colour = labToRgb(adjustedLab);
 }
 
+void AdjustLayoutColour::applyAdjustments(bool sendUpdate)
+{
+    if (streaming)
+    {
+        // Latest value wins, the timer sends it once the device is ready
+        streamTargetChanged = true;
+        return;
+    }
+
+    auto updatedKeys = updateAdjustedColoursState();
+
+    if (sendUpdate)
+        sendSelectionUpdate(updatedKeys, true);
+}
+
+void AdjustLayoutColour::beginStreaming()
+{
+    if (streaming)
+        return;
+
+    // Undo restores the colours from before this stream, earlier adjustments have their own undo steps
+    layoutBeforeStream = *controller->getMappingData();
+
+    streaming = true;
+    streamTargetChanged = false;
+    startTimer(streamIntervalMs);
+}
+
+void AdjustLayoutColour::endStreaming()
+{
+    if (!streaming)
+        return;
+
+    stopTimer();
+    streaming = false;
+    streamTargetChanged = false;
+
+    // Keys not yet sent since the last diff, which may have returned to their original colour
+    int numPending = adjustKernel.process(getAdjustParameters());
+    const int* changedIndices = adjustKernel.getChangedIndices();
+
+    bool pending[LumatoneColourAdjustKernel::maxNumColours] = { false };
+    for (int i = 0; i < numPending; i++)
+        pending[changedIndices[i]] = true;
+
+    const int octaveBoardSize = adjustKernel.getOctaveBoardSize();
+
+    juce::Array<MappedLumatoneKey> finalKeys;
+    juce::Array<MappedLumatoneKey> keysBeforeEdit;
+
+    for (int index = 0; index < adjustKernel.getNumColours(); index++)
+    {
+        auto coord = LumatoneKeyCoord(index / octaveBoardSize, index % octaveBoardSize);
+        auto keyBefore = *layoutBeforeStream.readKey(coord.boardIndex, coord.keyIndex);
+        auto colour = adjustKernel.getOutputColour(index);
+
+        if (!pending[index] && colour == keyBefore.colour)
+            continue;
+
+        finalKeys.add(MappedLumatoneKey(keyBefore.withColour(colour), coord));
+        keysBeforeEdit.add(MappedLumatoneKey(keyBefore, coord));
+    }
+
+    if (finalKeys.size() == 0)
+        return;
+
+    // Resends every adjusted key so the device ends up exactly at the final colours
+    auto updateAction = new LumatoneEditAction::MultiKeyAssignAction(controller, finalKeys, keysBeforeEdit, false, true, true);
+    controller->performAction(updateAction);
+}
+
+void AdjustLayoutColour::timerCallback()
+{
+    if (!streamTargetChanged)
+        return;
+
+    // Wait for the device to acknowledge what was sent, so slider updates never pile up in the queue
+    if (controller->getSendStatistics().queueSize > 0)
+        return;
+
+    streamTargetChanged = false;
+
+    auto updatedKeys = updateAdjustedColoursState();
+    if (updatedKeys.size() > 0)
+        controller->sendSelectionColours(updatedKeys, true, false);
+}
+
 void AdjustLayoutColour::setGradient(SetGradientOptions options)
 {
     float originColumn = 0;
@@ -326,6 +396,7 @@ void AdjustLayoutColour::beginAction(AdjustLayoutColour::Type type)
         {
             originalLayout = *controller->getMappingData();
         layoutBeforeAdjust = *controller->getMappingData();
+            adjustKernel.loadLayout(layoutBeforeAdjust);
         }
 
     }
@@ -338,39 +409,39 @@ void AdjustLayoutColour::endAction()
     layoutBeforeAdjust = *controller->getMappingData();
     currentLayout = layoutBeforeAdjust;
     currentAction = AdjustLayoutColour::Type::NONE;
+
+    adjustKernel.loadLayout(layoutBeforeAdjust);
 }
 
-juce::Array<MappedLumatoneKey> AdjustLayoutColour::updateAdjustedColoursState(const juce::Array<LumatoneKeyCoord>& selection) const
+LumatoneColourAdjustKernel::Parameters AdjustLayoutColour::getAdjustParameters() const
 {
-    juce::Array<MappedLumatoneKey> updateKeys;
-
-    for (auto coord : selection)
-    {
-        auto key = *layoutBeforeAdjust.readKey(coord.boardIndex, coord.keyIndex);
-        auto keyCopy = key;
+    LumatoneColourAdjustKernel::Parameters params;
+    params.hueRotate = hueRotateValue;
+    params.saturation = multiplySaturationValue;
+    params.brightness = multiplyBrightnessValue;
+    params.whiteKelvin = whiteKelvinValue;
+    params.contrast = contrastValue;
+    return params;
+}
 
-        if (multiplySaturationValue != 1.0f)
-        {
-            multiplySaturation(multiplySaturationValue, key);
-        }
+juce::Array<MappedLumatoneKey> AdjustLayoutColour::updateAdjustedColoursState()
+{
+    int numChanged = adjustKernel.process(getAdjustParameters());
+    const int* changedIndices = adjustKernel.getChangedIndices();
+    const int octaveBoardSize = adjustKernel.getOctaveBoardSize();
 
-        if (multiplyBrightnessValue != 1.0f)
-        {
-            multiplyBrightness(multiplyBrightnessValue, key);
-        }
+    juce::Array<MappedLumatoneKey> updateKeys;
+    updateKeys.ensureStorageAllocated(numChanged);
 
-        if (hueRotateValue != 0.0f)
-        {
-            rotateHue(hueRotateValue, key);
-        }
+    for (int i = 0; i < numChanged; i++)
+    {
+        int index = changedIndices[i];
+        auto coord = LumatoneKeyCoord(index / octaveBoardSize, index % octaveBoardSize);
 
-        if (whiteKelvinValue != 6500)
-        {
-            adjustWhiteBalance(whiteKelvinValue, key);
-        }
+        auto key = *layoutBeforeAdjust.readKey(coord.boardIndex, coord.keyIndex);
+        key.colour = adjustKernel.getOutputColour(index);
 
-        if (!key.colourIsEqual(keyCopy))
-            updateKeys.add(MappedLumatoneKey(key, coord));
+        updateKeys.add(MappedLumatoneKey(key, coord));
     }
 
     return updateKeys;
@@ -384,6 +455,7 @@ void AdjustLayoutColour::commitChanges()
     multiplySaturationValue = 1.0f;
     multiplyBrightnessValue = 1.0f;
     whiteKelvinValue = 6500;
+    contrastValue = 1.0f;
 }
 void AdjustLayoutColour::resetChanges()
 {
@@ -394,6 +466,7 @@ void AdjustLayoutColour::resetChanges()
     multiplySaturationValue = 1.0f;
     multiplyBrightnessValue = 1.0f;
     whiteKelvinValue = 6500;
+    contrastValue = 1.0f;
 }
 
 void AdjustLayoutColour::sendSelectionUpdate(const juce::Array<MappedLumatoneKey>& keyUpdates, bool bufferUpdates)
@@ -405,7 +478,7 @@ void AdjustLayoutColour::sendSelectionUpdate(const juce::Array<MappedLumatoneKey
 void AdjustLayoutColour::sendMappingUpdate(const LumatoneLayout& updatedLayout, bool bufferUpdates)
 {
     for (int i = 0; i < controller->getNumBoards(); i++)
-        controller->performAction(new LumatoneEditAction::SectionEditAction(controller, i, *updatedLayout.readBoard(i), bufferUpdates), true, i == 0);
+        controller->performAction(new LumatoneEditAction::SectionEditAction(controller, i, updatedLayout.shareBoard(i), bufferUpdates), true, i == 0);
 }
 
 // juce::Colour AdjustLayoutColour::inverseSRGB(juce::Colour rgb)
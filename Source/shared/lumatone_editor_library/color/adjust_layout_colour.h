@@ -3,8 +3,9 @@
 #include "../LumatoneController.h"
 #include "../actions/edit_actions.h"
 #include "../hex/lumatone_hex_map.h"
+#include "./colour_adjust_kernel.h"
 
-class AdjustLayoutColour 
+class AdjustLayoutColour : private juce::Timer
 {
 public:
     enum class Type
@@ -40,7 +41,7 @@ public:
 public:
 
     AdjustLayoutColour(LumatoneController* controller);
-    ~AdjustLayoutColour();
+    ~AdjustLayoutColour() override;
 
     void replaceColour(juce::Colour oldColour, juce::Colour newColour, bool sendUpdate=true);
 
@@ -59,10 +60,29 @@ public:
     void adjustWhiteBalance(int newWhitePoint, bool sendUpdate=true);
     void adjustWhiteBalance(int newWhitePoint, const juce::Array<LumatoneKeyCoord>& selection, bool sendUpdate=true);
     static bool adjustWhiteBalance(int newWhitePoint, LumatoneKey& key);
+
+    // Scales distance from mid grey, applied after the other adjustments
+    void adjustContrast(float change, bool sendUpdate=true);
+
 private:
     static void adjustWhiteBalanceRgb(int newWhitePoint, LumatoneKey& key);
     static void adjustWhiteBalanceLab(int newWhitePoint, LumatoneKey& key);
 
+public:
+    // Interactive edits, e.g. while dragging a slider. Adjustments only update the target colours,
+    // and the keys that differ from what was last sent go out whenever the device has caught up.
+    void beginStreaming();
+
+    // Sends the remaining changes and registers the whole stream as one undoable edit
+    void endStreaming();
+
+    bool isStreaming() const { return streaming; }
+
+private:
+    void applyAdjustments(bool sendUpdate);
+
+    void timerCallback() override;
+
 public:
     void setGradient(SetGradientOptions options);
     
@@ -74,7 +94,11 @@ private:
     void endAction();
 
     void applyAdjustmentToSelection(AdjustLayoutColour::Type type, float value, const juce::Array<LumatoneKeyCoord>& selection);
-    juce::Array<MappedLumatoneKey> updateAdjustedColoursState(const juce::Array<LumatoneKeyCoord>& selection) const;
+
+    // Runs all current adjustments over the whole layout, returns keys whose colour changed since the last call
+    juce::Array<MappedLumatoneKey> updateAdjustedColoursState();
+
+    LumatoneColourAdjustKernel::Parameters getAdjustParameters() const;
 
 public:
     
@@ -185,11 +209,19 @@ private:
     LumatoneLayout originalLayout;
     LumatoneLayout layoutBeforeAdjust;
     LumatoneLayout currentLayout;
+    LumatoneLayout layoutBeforeStream;
 
     float hueRotateValue = 0.0f;
     float multiplySaturationValue = 1.0f;
     float multiplyBrightnessValue = 1.0f;
     int whiteKelvinValue = 6500;
+    float contrastValue = 1.0f;
+
+    LumatoneColourAdjustKernel adjustKernel;
+
+    static constexpr int streamIntervalMs = 15;
+    bool streaming = false;
+    bool streamTargetChanged = false;
 
     AdjustLayoutColour::Type currentAction;
 };
@@ -0,0 +1,108 @@
+/*
+  ==============================================================================
+
+    colour_adjust_kernel.cpp
+    Created: 19 Oct 2026
+    Author:  Vincenzo
+
+  ==============================================================================
+*/
+
+#include "colour_adjust_kernel.h"
+#include "adjust_layout_colour.h"
+
+void LumatoneColourAdjustKernel::loadLayout(const LumatoneLayout& layout)
+{
+    octaveBoardSize = layout.getOctaveBoardSize();
+    numColours = juce::jmin(maxNumColours, layout.getNumBoards() * octaveBoardSize);
+
+    for (int i = 0; i < numColours; i++)
+    {
+        auto colour = layout.readKey(i / octaveBoardSize, i % octaveBoardSize)->colour;
+        colour.getHSB(baseHue[i], baseSaturation[i], baseBrightness[i]);
+
+        baseArgb[i] = colour.getARGB();
+        outputArgb[i] = baseArgb[i];
+    }
+}
+
+int LumatoneColourAdjustKernel::process(const Parameters& params)
+{
+    const int n = numColours;
+
+    // Same order as the per-key adjustments: saturation, brightness, hue, white balance
+    juce::FloatVectorOperations::multiply(saturation, baseSaturation, params.saturation, n);
+    juce::FloatVectorOperations::min(saturation, saturation, 1.0f, n);
+
+    juce::FloatVectorOperations::multiply(brightness, baseBrightness, params.brightness, n);
+    juce::FloatVectorOperations::min(brightness, brightness, 1.0f, n);
+
+    for (int i = 0; i < n; i++)
+    {
+        float h = baseHue[i] + params.hueRotate;
+        hue[i] = (h - std::floor(h)) * 6.0f;
+    }
+
+    // Branch-free HSB to RGB: channel = v * (1 - s * clamp(min(k, 4 - k), 0, 1)), k = (offset + h) mod 6
+    for (int i = 0; i < n; i++)
+    {
+        const float h = hue[i];
+        const float vs = brightness[i] * saturation[i];
+
+        float kr = std::fmod(5.0f + h, 6.0f);
+        float kg = std::fmod(3.0f + h, 6.0f);
+        float kb = std::fmod(1.0f + h, 6.0f);
+
+        red[i]   = brightness[i] - vs * juce::jlimit(0.0f, 1.0f, juce::jmin(kr, 4.0f - kr));
+        green[i] = brightness[i] - vs * juce::jlimit(0.0f, 1.0f, juce::jmin(kg, 4.0f - kg));
+        blue[i]  = brightness[i] - vs * juce::jlimit(0.0f, 1.0f, juce::jmin(kb, 4.0f - kb));
+    }
+
+    if (params.whiteKelvin != neutralWhiteKelvin)
+    {
+        const auto white = AdjustLayoutColour::kelvinToColour(params.whiteKelvin);
+        juce::FloatVectorOperations::multiply(red, white.getFloatRed(), n);
+        juce::FloatVectorOperations::multiply(green, white.getFloatGreen(), n);
+        juce::FloatVectorOperations::multiply(blue, white.getFloatBlue(), n);
+    }
+
+    if (params.contrast != 1.0f)
+    {
+        // (c - 0.5) * contrast + 0.5
+        const float offset = 0.5f * (1.0f - params.contrast);
+        for (float* plane : { red, green, blue })
+        {
+            juce::FloatVectorOperations::multiply(plane, params.contrast, n);
+            juce::FloatVectorOperations::add(plane, offset, n);
+        }
+    }
+
+    for (float* plane : { red, green, blue })
+    {
+        juce::FloatVectorOperations::clip(plane, plane, 0.0f, 1.0f, n);
+        juce::FloatVectorOperations::multiply(plane, 255.0f, n);
+    }
+
+    int numChanged = 0;
+    for (int i = 0; i < n; i++)
+    {
+        juce::uint32 argb = baseArgb[i];
+
+        // Transparent keys are left as they are
+        if ((argb >> 24) != 0)
+        {
+            argb = (argb & 0xff000000)
+                 | ((juce::uint32)juce::roundToInt(red[i]) << 16)
+                 | ((juce::uint32)juce::roundToInt(green[i]) << 8)
+                 |  (juce::uint32)juce::roundToInt(blue[i]);
+        }
+
+        if (argb != outputArgb[i])
+        {
+            outputArgb[i] = argb;
+            changedIndices[numChanged++] = i;
+        }
+    }
+
+    return numChanged;
+}
@@ -0,0 +1,77 @@
+/*
+  ==============================================================================
+
+    colour_adjust_kernel.h
+    Created: 19 Oct 2026
+    Author:  Vincenzo
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "../data/lumatone_layout.h"
+
+/*
+==============================================================================
+Applies hue, saturation, brightness, white balance and contrast adjustments
+to every key colour of a layout in one pass.
+
+Base colours are converted to HSB planes once when loaded; each process call
+only runs float operations over those planes and quantises at the end.
+Output colours are tracked so only keys whose 8-bit colour changed since the
+previous call are reported.
+==============================================================================
+*/
+class LumatoneColourAdjustKernel
+{
+public:
+
+    static constexpr int maxNumColours = MAXNUMBOARDS * MAXBOARDSIZE;
+    static constexpr int neutralWhiteKelvin = 6500;
+
+    struct Parameters
+    {
+        float hueRotate = 0.0f;
+        float saturation = 1.0f;
+        float brightness = 1.0f;
+        int whiteKelvin = neutralWhiteKelvin;
+        float contrast = 1.0f;
+    };
+
+public:
+
+    // Loads key colours indexed by board * octaveBoardSize + key, and treats them as the last output
+    void loadLayout(const LumatoneLayout& layout);
+
+    // Returns the number of keys whose output colour changed
+    int process(const Parameters& params);
+
+    int getNumColours() const { return numColours; }
+    int getOctaveBoardSize() const { return octaveBoardSize; }
+
+    const int* getChangedIndices() const { return changedIndices; }
+    juce::Colour getOutputColour(int index) const { return juce::Colour(outputArgb[index]); }
+
+private:
+
+    int numColours = 0;
+    int octaveBoardSize = 0;
+
+    float baseHue[maxNumColours];
+    float baseSaturation[maxNumColours];
+    float baseBrightness[maxNumColours];
+    juce::uint32 baseArgb[maxNumColours];
+
+    float hue[maxNumColours];
+    float saturation[maxNumColours];
+    float brightness[maxNumColours];
+
+    float red[maxNumColours];
+    float green[maxNumColours];
+    float blue[maxNumColours];
+
+    juce::uint32 outputArgb[maxNumColours];
+
+    int changedIndices[maxNumColours];
+};
@@ -21,17 +21,40 @@ LumatoneColourModel::~LumatoneColourModel()
     cache = nullptr;
 }
 
+std::shared_ptr<LumatoneColourModel> LumatoneColourModel::getShared()
+{
+    // Parsing the table takes a while, so this waits on a proper lock
+    static juce::CriticalSection sharedLock;
+    static std::weak_ptr<LumatoneColourModel> sharedModel;
+
+    const juce::ScopedLock l(sharedLock);
+
+    auto model = sharedModel.lock();
+    if (model == nullptr)
+    {
+        model = std::make_shared<LumatoneColourModel>();
+        sharedModel = model;
+    }
+
+    return model;
+}
+
 juce::Colour LumatoneColourModel::getModelColour(juce::Colour colour)
 {
     if (colour.isTransparent())
         return juce::Colour();
 
     LumatoneEditor::ColourHash hash = LumatoneEditor::getColourHash(colour);
-    auto cached = (*cache)[hash];
-    if (cached != juce::Colours::transparentBlack)
-        return cached;
+    {
+        juce::SpinLock::ScopedLockType l(cacheLock);
+        auto cached = (*cache)[hash];
+        if (cached != juce::Colours::transparentBlack)
+            return cached;
+    }
 
     auto modelColour = calculateModelColour(LumatoneColourModel::Type::ADJUSTED, colour);
+
+    juce::SpinLock::ScopedLockType l(cacheLock);
     cache->set(hash, modelColour);
     return modelColour;
 }
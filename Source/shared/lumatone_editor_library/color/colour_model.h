@@ -43,6 +43,10 @@ public:
     LumatoneColourModel();
     ~LumatoneColourModel();
 
+    // One model for every state in the process, parsed when the first one is requested
+    static std::shared_ptr<LumatoneColourModel> getShared();
+
+    // Safe to call from any thread
     juce::Colour getModelColour(juce::Colour colour);
 
     // LumatoneColour getLumatoneColour(juce::Colour colour);
@@ -63,5 +67,6 @@ private:
     ColourTable raw;
     ColourTable adjusted;
 
+    juce::SpinLock cacheLock;
     std::unique_ptr<juce::HashMap<LumatoneEditor::ColourHash,juce::Colour>> cache;
 };
@@ -4,7 +4,7 @@
 LumatoneApplicationState::LumatoneApplicationState(juce::String nameIn, juce::ValueTree stateIn, juce::UndoManager *undoManagerIn)
     : LumatoneState(nameIn, stateIn, undoManagerIn)
 {
-    colourModel = std::make_shared<LumatoneColourModel>();
+    colourModel = LumatoneColourModel::getShared();
     layoutContext = std::make_shared<LumatoneContext>(*mappingData);
     loadStateProperties(stateIn);
 }
@@ -12,7 +12,7 @@ LumatoneApplicationState::LumatoneApplicationState(juce::String nameIn, juce::Va
 LumatoneApplicationState::LumatoneApplicationState(juce::String nameIn, const LumatoneState &stateIn, juce::UndoManager *undoManagerIn)
     : LumatoneState(nameIn, stateIn, undoManagerIn)
 {
-    colourModel = std::make_shared<LumatoneColourModel>();
+    colourModel = LumatoneColourModel::getShared();
     layoutContext = std::make_shared<LumatoneContext>(*mappingData);
     loadStateProperties(state);
 }
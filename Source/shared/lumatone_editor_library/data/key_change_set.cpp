@@ -0,0 +1,61 @@
+/*
+  ==============================================================================
+
+    key_change_set.cpp
+    Created: 19 Oct 2026
+    Author:  Vincenzo
+
+  ==============================================================================
+*/
+
+#include "key_change_set.h"
+
+void LumatoneKeyChangeSet::addKey(int boardIndex, int keyIndex, juce::uint8 fields)
+{
+    jassert(boardIndex >= 0 && boardIndex < MAXNUMBOARDS && keyIndex >= 0 && keyIndex < MAXBOARDSIZE);
+    jassert(fields != 0);
+
+    const int keyNum = boardIndex * MAXBOARDSIZE + keyIndex;
+    dirtyKeys[keyNum / 64] |= (juce::uint64)1 << (keyNum % 64);
+    changedFields |= fields;
+}
+
+void LumatoneKeyChangeSet::addKeys(const LumatoneKeyChangeSet& other)
+{
+    for (int word = 0; word < numWords; word++)
+        dirtyKeys[word] |= other.dirtyKeys[word];
+
+    changedFields |= other.changedFields;
+}
+
+void LumatoneKeyChangeSet::clear()
+{
+    for (auto& word : dirtyKeys)
+        word = 0;
+
+    changedFields = 0;
+}
+
+bool LumatoneKeyChangeSet::containsKey(int boardIndex, int keyIndex) const
+{
+    const int keyNum = boardIndex * MAXBOARDSIZE + keyIndex;
+    if (keyNum < 0 || keyNum >= maxNumKeys)
+        return false;
+
+    return (dirtyKeys[keyNum / 64] & ((juce::uint64)1 << (keyNum % 64))) != 0;
+}
+
+int LumatoneKeyChangeSet::getNumKeys() const
+{
+    int numKeys = 0;
+    for (auto word : dirtyKeys)
+        numKeys += juce::countNumberOfBits(word);
+
+    return numKeys;
+}
+
+int LumatoneKeyChangeSet::findLowestSetBit(juce::uint64 bits)
+{
+    jassert(bits != 0);
+    return juce::countNumberOfBits((bits & (~bits + 1)) - 1);
+}
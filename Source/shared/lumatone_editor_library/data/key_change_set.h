@@ -0,0 +1,77 @@
+/*
+  ==============================================================================
+
+    key_change_set.h
+    Created: 19 Oct 2026
+    Author:  Vincenzo
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "./lumatone_layout.h"
+
+/*
+==============================================================================
+Set of keys that changed, one bit per key, for batched editor notifications.
+
+Only says which keys and which kinds of fields changed. The new values are
+read from the layout, so sending one doesn't copy any key data.
+==============================================================================
+*/
+class LumatoneKeyChangeSet
+{
+public:
+    enum ChangedFields
+    {
+        config = 1 << 0,    // note, channel, key type or fader polarity
+        colour = 1 << 1
+    };
+
+    static constexpr int maxNumKeys = MAXNUMBOARDS * MAXBOARDSIZE;
+
+public:
+    LumatoneKeyChangeSet() {}
+
+    void addKey(int boardIndex, int keyIndex, juce::uint8 fields=config | colour);
+    void addKeys(const LumatoneKeyChangeSet& other);
+
+    void clear();
+
+    bool isEmpty() const { return changedFields == 0; }
+    bool containsKey(int boardIndex, int keyIndex) const;
+    int getNumKeys() const;
+
+    // Union of ChangedFields over all keys
+    juce::uint8 getChangedFields() const { return changedFields; }
+    bool hasConfigChanges() const { return (changedFields & config) != 0; }
+    bool hasColourChanges() const { return (changedFields & colour) != 0; }
+
+    // Calls keyFnc(boardIndex, keyIndex) for each key in order
+    template <typename KeyFunction>
+    void forEachKey(KeyFunction&& keyFnc) const
+    {
+        for (int word = 0; word < numWords; word++)
+        {
+            auto bits = dirtyKeys[word];
+            while (bits != 0)
+            {
+                const int bit = findLowestSetBit(bits);
+                const int keyNum = word * 64 + bit;
+                keyFnc(keyNum / MAXBOARDSIZE, keyNum % MAXBOARDSIZE);
+
+                bits &= bits - 1;
+            }
+        }
+    }
+
+private:
+    static int findLowestSetBit(juce::uint64 bits);
+
+private:
+    static constexpr int numWords = (maxNumKeys + 63) / 64;
+
+    juce::uint64 dirtyKeys[numWords] = {};
+    juce::uint8 changedFields = 0;
+};
@@ -0,0 +1,505 @@
+/*
+  ==============================================================================
+
+    layout_library.cpp
+    Created: 19 Oct 2026
+    Author:  Vincenzo
+
+  ==============================================================================
+*/
+
+#include "layout_library.h"
+#include "lumatone_layout_parser.h"
+
+static constexpr int cacheMagic = 0x494c544c; // "LTLI"
+static constexpr int cacheVersion = 1;
+
+static juce::uint16 toRgb565(juce::Colour colour)
+{
+    return (juce::uint16)(((colour.getRed() >> 3) << 11) | ((colour.getGreen() >> 2) << 5) | (colour.getBlue() >> 3));
+}
+
+juce::Colour LumatoneLayoutLibrary::Entry::getThumbnailColour(int keyNum) const
+{
+    auto rgb = thumbnail[keyNum];
+    int red = (rgb >> 11) & 0x1f;
+    int green = (rgb >> 5) & 0x3f;
+    int blue = rgb & 0x1f;
+
+    return juce::Colour((juce::uint8)((red << 3) | (red >> 2)),
+                        (juce::uint8)((green << 2) | (green >> 4)),
+                        (juce::uint8)((blue << 3) | (blue >> 2)));
+}
+
+bool LumatoneLayoutLibrary::Entry::hasColour(juce::Colour colour, int tolerance) const
+{
+    for (int i = 0; i < juce::jmin(numColours, numHistogramColours); i++)
+    {
+        auto c = juce::Colour(histogramColours[i]);
+        if (std::abs(c.getRed() - colour.getRed()) <= tolerance
+         && std::abs(c.getGreen() - colour.getGreen()) <= tolerance
+         && std::abs(c.getBlue() - colour.getBlue()) <= tolerance)
+            return true;
+    }
+
+    return false;
+}
+
+//==============================================================================
+
+LumatoneLayoutLibrary::LumatoneLayoutLibrary(juce::File cacheFileIn, int numThreads)
+    : cacheFile(cacheFileIn)
+    , pool(juce::jmax(1, numThreads))
+{
+    loadCache();
+}
+
+LumatoneLayoutLibrary::~LumatoneLayoutLibrary()
+{
+    stopTimer();
+
+    cancelled = true;
+    pool.removeAllJobs(true, 10000);
+
+    cancelPendingUpdate();
+    listeners.clear();
+}
+
+void LumatoneLayoutLibrary::addDirectory(const juce::File& directory, bool scanNow)
+{
+    if (!directory.isDirectory() || directories.contains(directory))
+        return;
+
+    directories.add(directory);
+
+    if (scanNow)
+        rescan();
+}
+
+void LumatoneLayoutLibrary::removeDirectory(const juce::File& directory)
+{
+    directories.removeFirstMatchingValue(directory);
+    rescan();
+}
+
+void LumatoneLayoutLibrary::startWatching(int intervalMs)
+{
+    startTimer(intervalMs);
+}
+
+void LumatoneLayoutLibrary::stopWatching()
+{
+    stopTimer();
+}
+
+void LumatoneLayoutLibrary::timerCallback()
+{
+    rescan();
+}
+
+void LumatoneLayoutLibrary::rescan()
+{
+    if (scanning)
+    {
+        rescanPending = true;
+        return;
+    }
+
+    scanning = true;
+    rescanPending = false;
+
+    numFilesToParse = 0;
+    numFilesParsed = 0;
+
+    // Held until the scan has queued its parse jobs
+    numJobsRemaining = 1;
+
+    auto directoriesToScan = directories;
+    auto knownEntries = entries;
+
+    pool.addJob([this, directoriesToScan, knownEntries]()
+    {
+        scanDirectories(directoriesToScan, knownEntries);
+        finishJob();
+        return juce::ThreadPoolJob::jobHasFinished;
+    });
+}
+
+void LumatoneLayoutLibrary::scanDirectories(juce::Array<juce::File> directoriesToScan, juce::Array<EntryPtr> knownEntries)
+{
+    juce::HashMap<juce::String, EntryPtr> unseenEntries;
+    for (auto& entry : knownEntries)
+        unseenEntries.set(entry->file.getFullPathName(), entry);
+
+    juce::Array<juce::File> filesToParse;
+
+    for (auto& directory : directoriesToScan)
+    {
+        for (const auto& dirEntry : juce::RangedDirectoryIterator(directory, true, "*.ltn", juce::File::findFiles))
+        {
+            if (cancelled)
+                return;
+
+            auto path = dirEntry.getFile().getFullPathName();
+            auto known = unseenEntries[path];
+
+            if (known != nullptr)
+            {
+                unseenEntries.remove(path);
+
+                if (known->fileSize == dirEntry.getFileSize()
+                 && known->lastModified == dirEntry.getModificationTime().toMilliseconds())
+                    continue;
+            }
+
+            filesToParse.add(dirEntry.getFile());
+        }
+    }
+
+    {
+        const juce::ScopedLock sl(resultsLock);
+        for (juce::HashMap<juce::String, EntryPtr>::Iterator it(unseenEntries); it.next();)
+            removedPaths.add(it.getKey());
+    }
+
+    numFilesToParse = filesToParse.size();
+
+    for (int start = 0; start < filesToParse.size(); start += filesPerJob)
+    {
+        juce::Array<juce::File> chunk;
+        chunk.addArray(filesToParse, start, filesPerJob);
+
+        numJobsRemaining++;
+        pool.addJob([this, chunk]()
+        {
+            parseFiles(chunk);
+            finishJob();
+            return juce::ThreadPoolJob::jobHasFinished;
+        });
+    }
+}
+
+void LumatoneLayoutLibrary::parseFiles(juce::Array<juce::File> files)
+{
+    juce::Array<EntryPtr> results;
+    results.ensureStorageAllocated(files.size());
+
+    LumatoneLayout layout;
+    LumatoneLayoutParser parser(layout);
+
+    for (auto& file : files)
+    {
+        if (cancelled)
+            return;
+
+        parser.parseFile(file);
+        results.add(createEntry(file, layout, parser.getNumErrors()));
+        numFilesParsed++;
+    }
+
+    const juce::ScopedLock sl(resultsLock);
+    parsedEntries.addArray(results);
+}
+
+void LumatoneLayoutLibrary::finishJob()
+{
+    if (--numJobsRemaining == 0 && !cancelled)
+        triggerAsyncUpdate();
+}
+
+void LumatoneLayoutLibrary::handleAsyncUpdate()
+{
+    juce::Array<EntryPtr> parsed;
+    juce::StringArray removed;
+    {
+        const juce::ScopedLock sl(resultsLock);
+        parsed.swapWith(parsedEntries);
+        removed.swapWith(removedPaths);
+    }
+
+    scanning = false;
+
+    if (parsed.size() > 0 || removed.size() > 0)
+    {
+        juce::HashMap<juce::String, int> indexByPath;
+        for (int i = 0; i < entries.size(); i++)
+            indexByPath.set(entries.getReference(i)->file.getFullPathName(), i);
+
+        for (auto& path : removed)
+        {
+            if (indexByPath.contains(path))
+                entries.getReference(indexByPath[path]) = nullptr;
+        }
+
+        for (auto& entry : parsed)
+        {
+            auto path = entry->file.getFullPathName();
+            if (indexByPath.contains(path))
+                entries.getReference(indexByPath[path]) = entry;
+            else
+                entries.add(entry);
+        }
+
+        entries.removeAllInstancesOf(nullptr);
+
+        std::sort(entries.begin(), entries.end(), [](const EntryPtr& a, const EntryPtr& b)
+        {
+            return a->getName().compareNatural(b->getName()) < 0;
+        });
+
+        auto fileToWrite = cacheFile;
+        auto entriesToWrite = entries;
+        pool.addJob([fileToWrite, entriesToWrite]()
+        {
+            writeCache(fileToWrite, entriesToWrite);
+            return juce::ThreadPoolJob::jobHasFinished;
+        });
+
+        listeners.call(&Listener::layoutLibraryUpdated, this);
+    }
+
+    if (rescanPending)
+        rescan();
+}
+
+//==============================================================================
+
+juce::Array<LumatoneLayoutLibrary::EntryPtr> LumatoneLayoutLibrary::findByName(const juce::String& searchText) const
+{
+    juce::Array<EntryPtr> found;
+    for (auto& entry : entries)
+    {
+        if (entry->getName().containsIgnoreCase(searchText))
+            found.add(entry);
+    }
+
+    return found;
+}
+
+juce::Array<LumatoneLayoutLibrary::EntryPtr> LumatoneLayoutLibrary::findWithColour(juce::Colour colour, int tolerance) const
+{
+    juce::Array<EntryPtr> found;
+    for (auto& entry : entries)
+    {
+        if (entry->hasColour(colour, tolerance))
+            found.add(entry);
+    }
+
+    return found;
+}
+
+juce::Array<LumatoneLayoutLibrary::EntryPtr> LumatoneLayoutLibrary::findWithContentHash(juce::uint64 contentHash) const
+{
+    juce::Array<EntryPtr> found;
+    for (auto& entry : entries)
+    {
+        if (entry->contentHash == contentHash)
+            found.add(entry);
+    }
+
+    return found;
+}
+
+//==============================================================================
+
+juce::uint64 LumatoneLayoutLibrary::getContentHash(const LumatoneLayout& layout)
+{
+    // 64-bit FNV-1a over the binary layout
+    auto blob = layout.toBinary();
+    auto data = static_cast<const juce::uint8*>(blob.getData());
+
+    juce::uint64 hash = 0xcbf29ce484222325ull;
+    for (size_t i = 0; i < blob.getSize(); i++)
+    {
+        hash ^= data[i];
+        hash *= 0x100000001b3ull;
+    }
+
+    return hash;
+}
+
+LumatoneLayoutLibrary::EntryPtr LumatoneLayoutLibrary::createEntry(const juce::File& file, const LumatoneLayout& layout, int numParseErrors)
+{
+    auto entry = std::make_shared<Entry>();
+    entry->file = file;
+    entry->fileSize = file.getSize();
+    entry->lastModified = file.getLastModificationTime().toMilliseconds();
+    entry->contentHash = getContentHash(layout);
+    entry->numBoards = layout.getNumBoards();
+    entry->octaveBoardSize = layout.getOctaveBoardSize();
+    entry->numParseErrors = numParseErrors;
+
+    juce::uint32 colours[thumbnailSize];
+    int numKeys = 0;
+
+    entry->lowestNote = 127;
+    entry->highestNote = 0;
+
+    for (int boardIndex = 0; boardIndex < layout.getNumBoards(); boardIndex++)
+    {
+        for (int keyIndex = 0; keyIndex < layout.getOctaveBoardSize(); keyIndex++)
+        {
+            auto key = layout.readKey(boardIndex, keyIndex);
+
+            colours[numKeys] = key->colour.getARGB();
+            entry->thumbnail[numKeys] = toRgb565(key->colour);
+            numKeys++;
+
+            if (key->keyType == LumatoneKeyType::disabled || key->keyType == LumatoneKeyType::disabledDefault)
+                continue;
+
+            entry->numKeysEnabled++;
+
+            if (key->channelNumber >= 1 && key->channelNumber <= 16)
+                entry->channelMask |= (juce::uint16)(1 << (key->channelNumber - 1));
+
+            if (key->keyType == LumatoneKeyType::noteOnNoteOff)
+            {
+                entry->lowestNote = juce::jmin(entry->lowestNote, key->noteNumber);
+                entry->highestNote = juce::jmax(entry->highestNote, key->noteNumber);
+            }
+        }
+    }
+
+    if (entry->lowestNote > entry->highestNote)
+        entry->lowestNote = entry->highestNote = 0;
+
+    // Run lengths of the sorted colours, then keep the most used ones
+    std::sort(colours, colours + numKeys);
+
+    for (int i = 0; i < numKeys;)
+    {
+        int runEnd = i + 1;
+        while (runEnd < numKeys && colours[runEnd] == colours[i])
+            runEnd++;
+
+        int count = runEnd - i;
+        entry->numColours++;
+
+        int slot = juce::jmin(entry->numColours, numHistogramColours) - 1;
+        if (entry->numColours > numHistogramColours && count <= entry->histogramCounts[slot])
+        {
+            i = runEnd;
+            continue;
+        }
+
+        while (slot > 0 && entry->histogramCounts[slot - 1] < count)
+        {
+            entry->histogramColours[slot] = entry->histogramColours[slot - 1];
+            entry->histogramCounts[slot] = entry->histogramCounts[slot - 1];
+            slot--;
+        }
+
+        entry->histogramColours[slot] = colours[i];
+        entry->histogramCounts[slot] = count;
+
+        i = runEnd;
+    }
+
+    return entry;
+}
+
+//==============================================================================
+
+bool LumatoneLayoutLibrary::loadCache()
+{
+    juce::FileInputStream stream(cacheFile);
+    if (!stream.openedOk())
+        return false;
+
+    if (stream.readInt() != cacheMagic || stream.readInt() != cacheVersion)
+        return false;
+
+    int numEntries = stream.readInt();
+    if (numEntries < 0 || numEntries > maxCacheEntries)
+        return false;
+
+    juce::Array<EntryPtr> loadedEntries;
+    loadedEntries.ensureStorageAllocated(numEntries);
+
+    for (int i = 0; i < numEntries; i++)
+    {
+        auto entry = std::make_shared<Entry>();
+
+        entry->file = juce::File(stream.readString());
+        entry->fileSize = stream.readInt64();
+        entry->lastModified = stream.readInt64();
+        entry->contentHash = (juce::uint64)stream.readInt64();
+
+        entry->numBoards = stream.readByte();
+        entry->octaveBoardSize = stream.readByte();
+        entry->numParseErrors = stream.readInt();
+
+        entry->numColours = stream.readShort();
+        for (int c = 0; c < numHistogramColours; c++)
+        {
+            entry->histogramColours[c] = (juce::uint32)stream.readInt();
+            entry->histogramCounts[c] = stream.readShort();
+        }
+
+        entry->numKeysEnabled = stream.readShort();
+        entry->lowestNote = stream.readByte();
+        entry->highestNote = stream.readByte();
+        entry->channelMask = (juce::uint16)stream.readShort();
+
+        if (stream.read(entry->thumbnail, (int)sizeof(entry->thumbnail)) != (int)sizeof(entry->thumbnail))
+            return false;
+
+        loadedEntries.add(entry);
+    }
+
+    entries.swapWith(loadedEntries);
+    return true;
+}
+
+bool LumatoneLayoutLibrary::writeCache(const juce::File& file, const juce::Array<EntryPtr>& entriesToWrite)
+{
+    if (file == juce::File())
+        return false;
+
+    file.getParentDirectory().createDirectory();
+
+    // Write next to the cache and swap it in, so a crash never leaves a partial cache behind
+    juce::TemporaryFile tempFile(file);
+    {
+        juce::FileOutputStream stream(tempFile.getFile());
+        if (!stream.openedOk())
+            return false;
+
+        stream.writeInt(cacheMagic);
+        stream.writeInt(cacheVersion);
+        stream.writeInt(entriesToWrite.size());
+
+        for (auto& entry : entriesToWrite)
+        {
+            stream.writeString(entry->file.getFullPathName());
+            stream.writeInt64(entry->fileSize);
+            stream.writeInt64(entry->lastModified);
+            stream.writeInt64((juce::int64)entry->contentHash);
+
+            stream.writeByte((char)entry->numBoards);
+            stream.writeByte((char)entry->octaveBoardSize);
+            stream.writeInt(entry->numParseErrors);
+
+            stream.writeShort((short)entry->numColours);
+            for (int c = 0; c < numHistogramColours; c++)
+            {
+                stream.writeInt((int)entry->histogramColours[c]);
+                stream.writeShort((short)entry->histogramCounts[c]);
+            }
+
+            stream.writeShort((short)entry->numKeysEnabled);
+            stream.writeByte((char)entry->lowestNote);
+            stream.writeByte((char)entry->highestNote);
+            stream.writeShort((short)entry->channelMask);
+
+            stream.write(entry->thumbnail, sizeof(entry->thumbnail));
+        }
+
+        stream.flush();
+        if (stream.getStatus().failed())
+            return false;
+    }
+
+    return tempFile.overwriteTargetFileWithTemporary();
+}
@@ -0,0 +1,148 @@
+/*
+  ==============================================================================
+
+    layout_library.h
+    Created: 19 Oct 2026
+    Author:  Vincenzo
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "lumatone_layout.h"
+
+/*
+==============================================================================
+Index of the .ltn layouts found in a set of directories.
+
+Directories are scanned on a thread pool. Only files that are new or whose size
+or modification time changed get parsed, and the index is kept in a cache file
+so a collection is browsable straight away on the next launch. Browsing and
+listener callbacks happen on the message thread.
+==============================================================================
+*/
+class LumatoneLayoutLibrary : private juce::Timer
+                            , private juce::AsyncUpdater
+{
+public:
+    static constexpr int numHistogramColours = 8;
+    static constexpr int thumbnailSize = MAXNUMBOARDS * MAXBOARDSIZE;
+
+    struct Entry
+    {
+        juce::File file;
+        juce::int64 fileSize = 0;
+        juce::int64 lastModified = 0;
+
+        // Hash of the parsed layout rather than the file text, so reformatted copies still match
+        juce::uint64 contentHash = 0;
+
+        int numBoards = 0;
+        int octaveBoardSize = 0;
+        int numParseErrors = 0;
+
+        // Most used key colours, by descending count
+        int numColours = 0;
+        juce::uint32 histogramColours[numHistogramColours] = {};
+        int histogramCounts[numHistogramColours] = {};
+
+        int numKeysEnabled = 0;
+        int lowestNote = 0;
+        int highestNote = 0;
+        juce::uint16 channelMask = 0;
+
+        // Key colours as RGB565, indexed by board * octaveBoardSize + key
+        juce::uint16 thumbnail[thumbnailSize] = {};
+
+        juce::String getName() const { return file.getFileNameWithoutExtension(); }
+        juce::Colour getThumbnailColour(int keyNum) const;
+
+        bool usesChannel(int channel) const { return (channelMask & (1 << (channel - 1))) != 0; }
+        bool hasColour(juce::Colour colour, int tolerance=8) const;
+    };
+
+    using EntryPtr = std::shared_ptr<const Entry>;
+
+    class Listener
+    {
+    public:
+        virtual ~Listener() {}
+        virtual void layoutLibraryUpdated(LumatoneLayoutLibrary* library) = 0;
+    };
+
+public:
+    LumatoneLayoutLibrary(juce::File cacheFileIn, int numThreads=juce::SystemStats::getNumCpus());
+    ~LumatoneLayoutLibrary() override;
+
+    void addDirectory(const juce::File& directory, bool scanNow=true);
+    void removeDirectory(const juce::File& directory);
+    const juce::Array<juce::File>& getDirectories() const { return directories; }
+
+    // Looks for new, changed and removed files, parsing only the ones that need it
+    void rescan();
+
+    // Rescans periodically, as there's no portable directory change notification in juce_core
+    void startWatching(int intervalMs=5000);
+    void stopWatching();
+
+    bool isScanning() const { return scanning; }
+    int getNumFilesToParse() const { return numFilesToParse.load(); }
+    int getNumFilesParsed() const { return numFilesParsed.load(); }
+
+    //============================================================================
+    // Browsing, from the message thread
+
+    int getNumEntries() const { return entries.size(); }
+    EntryPtr getEntry(int index) const { return entries[index]; }
+    const juce::Array<EntryPtr>& getEntries() const { return entries; }
+
+    juce::Array<EntryPtr> findByName(const juce::String& searchText) const;
+    juce::Array<EntryPtr> findWithColour(juce::Colour colour, int tolerance=8) const;
+    juce::Array<EntryPtr> findWithContentHash(juce::uint64 contentHash) const;
+
+    static EntryPtr createEntry(const juce::File& file, const LumatoneLayout& layout, int numParseErrors=0);
+    static juce::uint64 getContentHash(const LumatoneLayout& layout);
+
+    void addListener(Listener* listener) { listeners.add(listener); }
+    void removeListener(Listener* listener) { listeners.remove(listener); }
+
+private:
+    void scanDirectories(juce::Array<juce::File> directoriesToScan, juce::Array<EntryPtr> knownEntries);
+    void parseFiles(juce::Array<juce::File> files);
+    void finishJob();
+
+    void handleAsyncUpdate() override;
+    void timerCallback() override;
+
+    bool loadCache();
+    static bool writeCache(const juce::File& file, const juce::Array<EntryPtr>& entriesToWrite);
+
+private:
+    static constexpr int filesPerJob = 32;
+    static constexpr int maxCacheEntries = 1000000;
+
+    juce::File cacheFile;
+    juce::Array<juce::File> directories;
+
+    juce::Array<EntryPtr> entries;
+
+    juce::ThreadPool pool;
+    std::atomic<bool> cancelled { false };
+
+    bool scanning = false;
+    bool rescanPending = false;
+
+    std::atomic<int> numJobsRemaining { 0 };
+    std::atomic<int> numFilesToParse { 0 };
+    std::atomic<int> numFilesParsed { 0 };
+
+    // Filled by the pool threads, merged into entries on the message thread
+    juce::CriticalSection resultsLock;
+    juce::Array<EntryPtr> parsedEntries;
+    juce::StringArray removedPaths;
+
+    juce::ListenerList<Listener> listeners;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LumatoneLayoutLibrary)
+};
@@ -9,6 +9,7 @@
 */
 
 #include "lumatone_layout.h"
+#include "lumatone_layout_parser.h"
 
 /*
 ==============================================================================
@@ -212,28 +213,71 @@ LumatoneLayout::LumatoneLayout(int numBoardsIn, int octaveBoardSizeIn, bool init
 
 void LumatoneLayout::clearVelocityIntervalTable()
 {
-    jassert(sizeof(DefaultVelocityIntervalTable) == sizeof(table));
-    memmove(table, DefaultVelocityIntervalTable, sizeof(DefaultVelocityIntervalTable));
+    auto& intervalTable = editConfigTables().velocityIntervalTable;
+    jassert(sizeof(DefaultVelocityIntervalTable) == sizeof(intervalTable));
+    memmove(intervalTable, DefaultVelocityIntervalTable, sizeof(DefaultVelocityIntervalTable));
+}
+
+void LumatoneLayout::Ownership::releaseAll() const
+{
+    for (auto& ownsBoard : boards)
+        ownsBoard = false;
+
+    configTables = false;
+}
+
+void LumatoneLayout::Ownership::takeFrom(Ownership& other)
+{
+    for (int i = 0; i < MAXNUMBOARDS; i++)
+        boards[i] = other.boards[i].exchange(false);
+
+    configTables = other.configTables.exchange(false);
+}
+
+LumatoneLayout::ConfigTables& LumatoneLayout::editConfigTables()
+{
+    if (!ownership.configTables)
+    {
+        configTables = std::make_shared<ConfigTables>(*configTables);
+        ownership.configTables = true;
+    }
+
+    return *configTables;
 }
 
 const LumatoneBoard* LumatoneLayout::readBoard(int index) const
 {
-    return &boards[index];
+    return boards[index].get();
 }
 
 LumatoneBoard* LumatoneLayout::getBoard(int index)
 {
-    return &boards[index];
+    auto& board = boards[index];
+
+    // Copy on write, a board still shared with another layout or an undo action is never edited in place
+    if (!ownership.boards[index])
+    {
+        board = std::make_shared<LumatoneBoard>(*board);
+        ownership.boards[index] = true;
+    }
+
+    return board.get();
+}
+
+std::shared_ptr<const LumatoneBoard> LumatoneLayout::shareBoard(int index) const
+{
+    ownership.boards[index] = false;
+    return boards[index];
 }
 
 LumatoneKey *LumatoneLayout::getKey(int boardIndex, int keyIndex)
 {
-    return &boards[boardIndex].theKeys[keyIndex];
+    return &getBoard(boardIndex)->theKeys[keyIndex];
 }
 
 const LumatoneKey *LumatoneLayout::readKey(int boardIndex, int keyIndex) const
 {
-    return &boards[boardIndex].theKeys[keyIndex];
+    return &boards[boardIndex]->theKeys[keyIndex];
 }
 
 const LumatoneKey* LumatoneLayout::readKey(int keyNum) const
@@ -244,7 +288,7 @@ const LumatoneKey* LumatoneLayout::readKey(int keyNum) const
 
 MappedLumatoneKey LumatoneLayout::getMappedKey(int boardIndex, int keyIndex) const
 {
-    return MappedLumatoneKey(boards[boardIndex].theKeys[keyIndex], boardIndex, keyIndex);
+    return MappedLumatoneKey(boards[boardIndex]->theKeys[keyIndex], boardIndex, keyIndex);
 }
 
 bool LumatoneLayout::isKeyCoordValid(const LumatoneKeyCoord& coord) const
@@ -270,9 +314,10 @@ void LumatoneLayout::transform(std::function<void(int,int,LumatoneKey&)> transfo
 {
     for (int b = 0; b < getNumBoards(); b++)
     {
-        for (int k = 0; k < getOctaveBoardSize(); k++)\
+        auto board = getBoard(b);
+        for (int k = 0; k < getOctaveBoardSize(); k++)
         {
-            transformFnc(b, k, *getKey(b, k));
+            transformFnc(b, k, board->theKeys[k]);
         }
     }
 }
@@ -288,10 +333,11 @@ void LumatoneLayout::clearAll(bool initializeWithNoteKeyType)
 {
     auto newKeyType = (initializeWithNoteKeyType) ? LumatoneKeyType::noteOnNoteOff : LumatoneKeyType::disabled;
 
-    for (int i = 0; i < numBoards; i++)
+    // Fresh boards rather than edits, so copies sharing the old ones keep them
+    for (int i = 0; i < MAXNUMBOARDS; i++)
     {
-        boards[i] = LumatoneBoard(newKeyType, octaveBoardSize);
-        boards[i].board_idx = i;
+        boards[i] = std::make_shared<LumatoneBoard>(newKeyType, octaveBoardSize, i);
+        ownership.boards[i] = true;
     }
 
     // Default values for options
@@ -301,18 +347,20 @@ void LumatoneLayout::clearAll(bool initializeWithNoteKeyType)
     invertSustain = false;
     expressionControllerSensivity = 0;
 
+    configTables = std::make_shared<ConfigTables>();
+    ownership.configTables = true;
     clearVelocityIntervalTable();
-    velocityTable = LumatoneConfigTable(LumatoneConfigTable::TableType::velocityInterval);
-    faderTable = LumatoneConfigTable(LumatoneConfigTable::TableType::fader);
-    afterTouchTable = LumatoneConfigTable(LumatoneConfigTable::TableType::afterTouch);
-    lumaTouchTable = LumatoneConfigTable(LumatoneConfigTable::TableType::lumaTouch);
+    configTables->velocityTable = LumatoneConfigTable(LumatoneConfigTable::TableType::velocityInterval);
+    configTables->faderTable = LumatoneConfigTable(LumatoneConfigTable::TableType::fader);
+    configTables->afterTouchTable = LumatoneConfigTable(LumatoneConfigTable::TableType::afterTouch);
+    configTables->lumaTouchTable = LumatoneConfigTable(LumatoneConfigTable::TableType::lumaTouch);
 }
 
 bool LumatoneLayout::isEmpty() const
 {
     bool isEmpty = true;
-    for (int i = 0; i < octaveBoardSize && isEmpty; i++) {
-        isEmpty &= boards[i].isEmpty();
+    for (int i = 0; i < numBoards && isEmpty; i++) {
+        isEmpty &= boards[i]->isEmpty();
     }
 
     return isEmpty;
@@ -320,185 +368,18 @@ bool LumatoneLayout::isEmpty() const
 
 void LumatoneLayout::fromStringArray(const juce::StringArray& stringArray)
 {
-    clearAll(true);
-
-    bool hasFiftySixKeys = false;
+    LumatoneLayoutParser parser(*this);
+    parser.begin();
 
-    int boardIndex = -1;
-    for (int i = 0; i < stringArray.size(); i++)
+    for (auto& line : stringArray)
     {
-        juce::String currentLine = stringArray[i];
-        int pos1, pos2;
-        if ((pos1 = currentLine.indexOf("[Board")) >= 0) 
-        {
-            pos2 = currentLine.indexOf("]");
-            if (pos2 >= 0 && pos2 > pos1) 
-            {
-                boardIndex = currentLine.substring(pos1 + 6, pos2).getIntValue();
-            } 
-            else
-                jassert(false);
-        } 
-        else if ((pos1 = currentLine.indexOf("Key_")) >= 0) 
-        {
-            pos2 = currentLine.indexOf("=");
-            if (pos2 >= 0 && pos2 > pos1) 
-            {
-                int keyIndex = currentLine.substring(pos1 + 4, pos2).getIntValue();
-                int keyValue = currentLine.substring(pos2 + 1).getIntValue();
-                if (boardIndex >= 0 && boardIndex < octaveBoardSize) 
-                {
-                    if (keyIndex >= 0 && keyIndex < 56)
-                        boards[boardIndex].theKeys[keyIndex].noteNumber = keyValue;
-                    else
-                        jassert(false);
-                }
-                else
-                    jassert(false);
-            }
-        } 
-        else if ((pos1 = currentLine.indexOf("Chan_")) >= 0) 
-        {
-            pos2 = currentLine.indexOf("=");
-            if (pos2 >= 0 && pos2 > pos1)
-            {
-                int keyIndex = currentLine.substring(pos1 + 5, pos2).getIntValue();
-                int keyValue = currentLine.substring(pos2 + 1).getIntValue();
-                if (boardIndex >= 0 && boardIndex < octaveBoardSize)
-                {
-                    if (keyIndex >= 0 && keyIndex < 56)
-                    {
-
-                        if (keyValue > 0 && keyValue <= 16)
-                        {
-                            boards[boardIndex].theKeys[keyIndex].channelNumber = keyValue;
-                        } else
-                        {
-                            boards[boardIndex].theKeys[keyIndex].channelNumber = 1;
-                            boards[boardIndex].theKeys[keyIndex].keyType = LumatoneKeyType::disabledDefault;
-                        }
-
-                        if (keyIndex == 55)
-                            hasFiftySixKeys = true;
-                    }
-                    else
-                        jassert(false);
-                }
-                else
-                    jassert(false);
-            }
-        }
-        else if ((pos1 = currentLine.indexOf("Col_")) >= 0)
-        {
-            pos2 = currentLine.indexOf("=");
-            if (pos2 >= 0 && pos2 > pos1)
-            {
-                int keyIndex = currentLine.substring(pos1 + 4, pos2).getIntValue();
-                int colValue = currentLine.substring(pos2 + 1).getHexValue32();
-                if (boardIndex >= 0 && boardIndex < octaveBoardSize)
-                {
-                    if (keyIndex >= 0 && keyIndex < 56)
-                        boards[boardIndex].theKeys[keyIndex].colour = juce::Colour(colValue).withAlpha(1.0f);
-                    else
-                        jassert(false);
-                }
-                else
-                    jassert(false);
-            }
-        }
-        else if ((pos1 = currentLine.indexOf("KTyp_")) >= 0)
-        {
-            pos2 = currentLine.indexOf("=");
-            if (pos2 >= 0 && pos2 > pos1)
-            {
-                int keyIndex = currentLine.substring(pos1 + 5, pos2).getIntValue();
-                int keyValue = currentLine.substring(pos2 + 1).getIntValue();
-                if (boardIndex >= 0 && boardIndex < octaveBoardSize)
-                {
-                    if (keyIndex >= 0 && keyIndex < 56)
-                    {
-                        auto currentKeyType = boards[boardIndex].theKeys[keyIndex].keyType;
-                        if (keyValue < 0 && keyValue >= 5 || currentKeyType == LumatoneKeyType::disabledDefault)
-                            boards[boardIndex].theKeys[keyIndex].keyType = LumatoneKeyType::disabled;
-                        else
-                            boards[boardIndex].theKeys[keyIndex].keyType = (LumatoneKeyType)keyValue;
-                    }
-                    else
-                        jassert(false);
-                }
-            }
-            else
-                jassert(false);
-        }
-        else if ((pos1 = currentLine.indexOf("CCInvert_")) >= 0)
-        {
-            int keyIndex = currentLine.substring(pos1 + 9, currentLine.length()).getIntValue();
-            if (boardIndex >= 0 && boardIndex < octaveBoardSize)
-            {
-                if (keyIndex >= 0 && keyIndex < 56)
-                        boards[boardIndex].theKeys[keyIndex].ccFaderDefault = false;
-                else
-                    jassert(false);
-            }
-        }
-
-        // General options
-        else if ((pos1 = currentLine.indexOf("AfterTouchActive=")) >= 0)
-            afterTouchActive = currentLine.substring(pos1 + 17).getIntValue() > 0;
-
-        else if ((pos1 = currentLine.indexOf("LightOnKeyStrokes=")) >= 0)
-            lightOnKeyStrokes = currentLine.substring(pos1 + 18).getIntValue() > 0;
-
-        else if ((pos1 = currentLine.indexOf("InvertFootController=")) >= 0)
-            invertExpression = currentLine.substring(pos1 + 21).getIntValue() > 0;
-
-        else if ((pos1 = currentLine.indexOf("InvertSustain=")) >= 0)
-            invertSustain = currentLine.substring(pos1 + 14).getIntValue() > 0;
-
-        else if ((pos1 = currentLine.indexOf("ExprCtrlSensivity=")) >= 0)
-            expressionControllerSensivity = currentLine.substring(pos1 + 18).getIntValue();
-
-        // Velocity curve config
-        else if ((pos1 = currentLine.indexOf("VelocityIntrvlTbl=")) >= 0)
-        {
-            juce::String intervalTableString = currentLine.substring(pos1 + 18);
-            juce::StringArray intervalTableValueArray = juce::StringArray::fromTokens(intervalTableString, false);
-            if (intervalTableValueArray.size() > 0)
-            {
-                jassert(intervalTableValueArray.size() >= VELOCITYINTERVALTABLESIZE);
-
-                for (int x = 0; x < VELOCITYINTERVALTABLESIZE; x++)
-                {
-                    table[x] = intervalTableValueArray[x].getIntValue();
-                }
-            }
-            else
-            {
-                clearVelocityIntervalTable();
-            }
-        }
-        // Note on/off velocity configuration
-        else if ((pos1 = currentLine.indexOf("NoteOnOffVelocityCrvTbl=")) >= 0) 
-        {
-            velocityTable = LumatoneConfigTable(currentLine.substring(pos1 + 24));
-        }
-        // Fader configuration
-        else if ((pos1 = currentLine.indexOf("FaderConfig=")) >= 0) 
-        {
-            faderTable = LumatoneConfigTable(currentLine.substring(pos1 + 12));
-        }
-        // Aftertouch configuration
-        else if ((pos1 = currentLine.indexOf("afterTouchConfig=")) >= 0) 
-        {
-            afterTouchTable = LumatoneConfigTable(currentLine.substring(pos1 + 17));
-        }
-        // Lumatouch configuration
-        else if ((pos1 = currentLine.indexOf("LumaTouchConfig=")) >= 0) 
-        {
-            lumaTouchTable = LumatoneConfigTable(currentLine.substring(pos1 + 17));
-        }
+        auto lineText = line.toRawUTF8();
+        parser.parseLine(lineText, lineText + strlen(lineText));
     }
 
+    for (auto& error : parser.getErrors())
+        DBG("LumatoneLayout::fromStringArray: " + error.toString());
+
     // Conversion between 55-key and 56-key layout
     //if (TerpstraSysExApplication::getApp().getOctaveBoardSize() == 56 && !hasFiftySixKeys) {
     //    // Loaded layout has 55-key layout. Adjust geometry to 56-key layout
@@ -522,15 +403,17 @@ juce::StringArray LumatoneLayout::toStringArray() const
     for (int boardIndex = 0; boardIndex < numBoards; boardIndex++) {
         result.add("[Board" + juce::String(boardIndex) + "]");
 
+        const LumatoneBoard& board = *boards[boardIndex];
+
         //for (int keyIndex = 0; keyIndex < TerpstraSysExApplication::getApp().getOctaveBoardSize(); keyIndex++) {
             for (int keyIndex = 0; keyIndex < 56; keyIndex++) {
-            result.add("Key_" + juce::String(keyIndex) + "=" + juce::String(boards[boardIndex].theKeys[keyIndex].noteNumber));
-            result.add("Chan_" + juce::String(keyIndex) + "=" + juce::String(boards[boardIndex].theKeys[keyIndex].channelNumber));
-            //if (boards[boardIndex].theKeys[keyIndex].colour != juce::Colour())
-            result.add("Col_" + juce::String(keyIndex) + "=" + boards[boardIndex].theKeys[keyIndex].colour.toDisplayString(false));
-            if (boards[boardIndex].theKeys[keyIndex].keyType != LumatoneKeyType::noteOnNoteOff)
-                result.add("KTyp_" + juce::String(keyIndex) + "=" + juce::String(boards[boardIndex].theKeys[keyIndex].keyType));
-            if (boards[boardIndex].theKeys[keyIndex].ccFaderDefault != true)
+            result.add("Key_" + juce::String(keyIndex) + "=" + juce::String(board.theKeys[keyIndex].noteNumber));
+            result.add("Chan_" + juce::String(keyIndex) + "=" + juce::String(board.theKeys[keyIndex].channelNumber));
+            //if (board.theKeys[keyIndex].colour != juce::Colour())
+            result.add("Col_" + juce::String(keyIndex) + "=" + board.theKeys[keyIndex].colour.toDisplayString(false));
+            if (board.theKeys[keyIndex].keyType != LumatoneKeyType::noteOnNoteOff)
+                result.add("KTyp_" + juce::String(keyIndex) + "=" + juce::String(board.theKeys[keyIndex].keyType));
+            if (board.theKeys[keyIndex].ccFaderDefault != true)
                 result.add("CCInvert_" + juce::String(keyIndex));
         }
     }
@@ -544,41 +427,199 @@ juce::StringArray LumatoneLayout::toStringArray() const
 
     // Velocity curve interval table
     juce::String intervalTableString;
-    for (auto intervalTableValue : table)
+    for (auto intervalTableValue : configTables->velocityIntervalTable)
         intervalTableString += juce::String(intervalTableValue) + " ";
     result.add("VelocityIntrvlTbl=" + intervalTableString);
 
     // Note on/off velocity configuration
-    result.add("NoteOnOffVelocityCrvTbl=" + velocityTable.toConfigString());
+    result.add("NoteOnOffVelocityCrvTbl=" + configTables->velocityTable.toConfigString());
     // Fader configuration
-    result.add("FaderConfig=" + faderTable.toConfigString());
+    result.add("FaderConfig=" + configTables->faderTable.toConfigString());
     // Aftertouch configuration
-    result.add("afterTouchConfig=" + afterTouchTable.toConfigString());
+    result.add("afterTouchConfig=" + configTables->afterTouchTable.toConfigString());
     // Lumatouch configuration
-    result.add("LumaTouchConfig=" + lumaTouchTable.toConfigString());
+    result.add("LumaTouchConfig=" + configTables->lumaTouchTable.toConfigString());
 
     return result;
 }
 
-LumatoneConfigTable* LumatoneLayout::getConfigTable(LumatoneConfigTable::TableType velocityCurveType)
+/*
+Binary layout, all values little endian:
+    uint32  magic
+    uint16  version
+    uint8   numBoards, octaveBoardSize
+    uint8   option flags, expression sensitivity
+    per key, 8 bytes: uint8 note, channel, key type, flags; uint32 ARGB colour
+    int16   velocity interval table
+    per config table: int8 draw mode, int16 x 128 values
+*/
+
+static constexpr int binaryHeaderSize = 10;
+static constexpr int binaryKeySize = 8;
+static constexpr int binaryConfigTableSize = 1 + 128 * 2;
+static constexpr int binaryTablesSize = VELOCITYINTERVALTABLESIZE * 2 + 4 * binaryConfigTableSize;
+
+enum BinaryOptionFlags
+{
+    afterTouchActiveFlag    = 0x01,
+    lightOnKeyStrokesFlag   = 0x02,
+    invertExpressionFlag    = 0x04,
+    invertSustainFlag       = 0x08
+};
+
+static size_t getBinaryLayoutSize(int numBoards, int octaveBoardSize)
+{
+    return (size_t)(binaryHeaderSize + numBoards * octaveBoardSize * binaryKeySize + binaryTablesSize);
+}
+
+static void writeBinaryConfigTable(juce::MemoryOutputStream& stream, const LumatoneConfigTable& configTable)
+{
+    stream.writeByte((char)configTable.editStrategy);
+    for (int x = 0; x < 128; x++)
+        stream.writeShort((short)configTable.velocityValues[x]);
+}
+
+static void readBinaryConfigTable(juce::MemoryInputStream& stream, LumatoneConfigTable& configTable)
+{
+    configTable.editStrategy = (LumatoneConfigTable::DrawMode)(juce::int8)stream.readByte();
+    for (int x = 0; x < 128; x++)
+        configTable.velocityValues[x] = stream.readShort();
+}
+
+juce::MemoryBlock LumatoneLayout::toBinary() const
+{
+    juce::MemoryBlock block;
+    block.ensureSize(getBinaryLayoutSize(numBoards, octaveBoardSize));
+
+    juce::MemoryOutputStream stream(block, false);
+
+    stream.writeInt((int)binaryMagic);
+    stream.writeShort((short)binaryVersion);
+    stream.writeByte((char)numBoards);
+    stream.writeByte((char)octaveBoardSize);
+
+    int optionFlags = (afterTouchActive ? afterTouchActiveFlag : 0)
+                    | (lightOnKeyStrokes ? lightOnKeyStrokesFlag : 0)
+                    | (invertExpression ? invertExpressionFlag : 0)
+                    | (invertSustain ? invertSustainFlag : 0);
+    stream.writeByte((char)optionFlags);
+    stream.writeByte((char)expressionControllerSensivity);
+
+    for (int boardIndex = 0; boardIndex < numBoards; boardIndex++)
+    {
+        for (int keyIndex = 0; keyIndex < octaveBoardSize; keyIndex++)
+        {
+            const LumatoneKey& key = boards[boardIndex]->theKeys[keyIndex];
+            stream.writeByte((char)key.noteNumber);
+            stream.writeByte((char)key.channelNumber);
+            stream.writeByte((char)key.keyType);
+            stream.writeByte((char)(key.ccFaderDefault ? 1 : 0));
+            stream.writeInt((int)key.colour.getARGB());
+        }
+    }
+
+    for (auto intervalTableValue : configTables->velocityIntervalTable)
+        stream.writeShort((short)intervalTableValue);
+
+    writeBinaryConfigTable(stream, configTables->velocityTable);
+    writeBinaryConfigTable(stream, configTables->faderTable);
+    writeBinaryConfigTable(stream, configTables->afterTouchTable);
+    writeBinaryConfigTable(stream, configTables->lumaTouchTable);
+
+    stream.flush();
+    jassert(block.getSize() == getBinaryLayoutSize(numBoards, octaveBoardSize));
+
+    return block;
+}
+
+bool LumatoneLayout::fromBinary(const void* data, size_t numBytes)
+{
+    if (data == nullptr || numBytes < (size_t)binaryHeaderSize)
+        return false;
+
+    juce::MemoryInputStream stream(data, numBytes, false);
+
+    if ((juce::uint32)stream.readInt() != binaryMagic)
+        return false;
+
+    if (stream.readShort() != binaryVersion)
+        return false;
+
+    int numBoardsIn = (juce::uint8)stream.readByte();
+    int octaveBoardSizeIn = (juce::uint8)stream.readByte();
+
+    if (numBoardsIn <= 0 || numBoardsIn > MAXNUMBOARDS
+     || octaveBoardSizeIn <= 0 || octaveBoardSizeIn > MAXBOARDSIZE
+     || numBytes != getBinaryLayoutSize(numBoardsIn, octaveBoardSizeIn))
+        return false;
+
+    numBoards = numBoardsIn;
+    octaveBoardSize = octaveBoardSizeIn;
+    clearAll();
+
+    int optionFlags = (juce::uint8)stream.readByte();
+    afterTouchActive = (optionFlags & afterTouchActiveFlag) != 0;
+    lightOnKeyStrokes = (optionFlags & lightOnKeyStrokesFlag) != 0;
+    invertExpression = (optionFlags & invertExpressionFlag) != 0;
+    invertSustain = (optionFlags & invertSustainFlag) != 0;
+    expressionControllerSensivity = (juce::uint8)stream.readByte();
+
+    for (int boardIndex = 0; boardIndex < numBoards; boardIndex++)
+    {
+        LumatoneBoard& board = *boards[boardIndex];
+
+        for (int keyIndex = 0; keyIndex < octaveBoardSize; keyIndex++)
+        {
+            LumatoneKey& key = board.theKeys[keyIndex];
+            key.noteNumber = (juce::uint8)stream.readByte();
+            key.channelNumber = (juce::uint8)stream.readByte();
+
+            int keyType = (juce::uint8)stream.readByte();
+            key.keyType = (keyType > LumatoneKeyType::disabled) ? LumatoneKeyType::disabled : (LumatoneKeyType)keyType;
+
+            key.ccFaderDefault = stream.readByte() != 0;
+            key.colour = juce::Colour((juce::uint32)stream.readInt());
+        }
+    }
+
+    ConfigTables& tables = *configTables;
+
+    for (auto& intervalTableValue : tables.velocityIntervalTable)
+        intervalTableValue = stream.readShort();
+
+    readBinaryConfigTable(stream, tables.velocityTable);
+    readBinaryConfigTable(stream, tables.faderTable);
+    readBinaryConfigTable(stream, tables.afterTouchTable);
+    readBinaryConfigTable(stream, tables.lumaTouchTable);
+
+    return true;
+}
+
+const LumatoneConfigTable* LumatoneLayout::readConfigTable(LumatoneConfigTable::TableType velocityCurveType) const
 {
 	switch (velocityCurveType)
 	{
 	case LumatoneConfigTable::TableType::velocityInterval:
-		return &velocityTable;
+		return &configTables->velocityTable;
 
 	case LumatoneConfigTable::TableType::fader:
-		return &faderTable;
+		return &configTables->faderTable;
 	case LumatoneConfigTable::TableType::afterTouch:
-		return &afterTouchTable;
+		return &configTables->afterTouchTable;
 	case LumatoneConfigTable::TableType::lumaTouch:
-		return &lumaTouchTable;
+		return &configTables->lumaTouchTable;
 	default:
 		jassertfalse;
 		return nullptr;
 	}
 }
 
+LumatoneConfigTable* LumatoneLayout::getConfigTable(LumatoneConfigTable::TableType velocityCurveType)
+{
+	editConfigTables();
+	return const_cast<LumatoneConfigTable*>(readConfigTable(velocityCurveType));
+}
+
 juce::Array<juce::Colour> LumatoneLayout::getLayoutColours() const
 {
     juce::Array<juce::Colour> layoutColours = readBoard(0)->getBoardColours();
@@ -601,7 +642,7 @@ juce::Array<LumatoneKeyCoord> LumatoneLayout::getKeysWithColour(const juce::Colo
     juce::Array<LumatoneKeyCoord> keyCoords;
 
     for (int i = 0; i < numBoards; i++)
-        keyCoords.addArray(boards[i].getKeysWithColour(c));
+        keyCoords.addArray(boards[i]->getKeysWithColour(c));
 
     return keyCoords;
 }
@@ -58,10 +58,56 @@ A complete key mapping
 // Number of entries in the velocity interval table
 #define VELOCITYINTERVALTABLESIZE 127
 
+/*
+==============================================================================
+Boards and curve tables are held by reference count and shared between copies,
+so copying a layout for a snapshot or a listener doesn't copy any key data.
+Non-const accessors copy a shared board or table set before returning it, so
+edits never show through in other copies. Don't write through one of those
+pointers after the layout has been copied, get it again instead.
+
+A layout's own copies, edits and shareBoard() calls must come from one thread
+at a time, but copies sharing its boards can be used on any thread.
+==============================================================================
+*/
 class LumatoneLayout
 {
 private:
-	LumatoneBoard boards[MAXNUMBOARDS];
+	struct ConfigTables
+	{
+		int velocityIntervalTable[VELOCITYINTERVALTABLESIZE];
+
+		LumatoneConfigTable velocityTable;
+		LumatoneConfigTable faderTable;
+		LumatoneConfigTable afterTouchTable;
+		LumatoneConfigTable lumaTouchTable;
+	};
+
+	std::shared_ptr<LumatoneBoard> boards[MAXNUMBOARDS];
+	std::shared_ptr<ConfigTables> configTables;
+
+	// Which boards and tables are referenced by this layout only, so they can be edited in place.
+	// Copying the layout or sharing a board gives up ownership on both sides, editing takes it back
+	// by copying. Unlike shared_ptr::use_count(), this can't miss a copy made on another thread.
+	struct Ownership
+	{
+		Ownership() { releaseAll(); }
+		Ownership(const Ownership& other) { releaseAll(); other.releaseAll(); }
+		Ownership(Ownership&& other) noexcept { takeFrom(other); }
+
+		Ownership& operator=(const Ownership& other) { releaseAll(); other.releaseAll(); return *this; }
+		Ownership& operator=(Ownership&& other) noexcept { takeFrom(other); return *this; }
+
+		void releaseAll() const;
+		void takeFrom(Ownership& other);
+
+		mutable std::atomic<bool> boards[MAXNUMBOARDS];
+		mutable std::atomic<bool> configTables;
+	};
+
+	Ownership ownership;
+
+	ConfigTables& editConfigTables();
 
 public:
 	LumatoneLayout(int numBoards=5, int octaveBoardSize=56, bool initializeWithNotes=false);
@@ -73,11 +119,24 @@ public:
 	void fromStringArray(const juce::StringArray& stringArray);
 	juce::StringArray toStringArray() const;
 
+	// Compact versioned form used for state and undo snapshots, the .ltn text is only for import/export
+	juce::MemoryBlock toBinary() const;
+
+	// Returns false and leaves the layout unchanged if the data is not a supported layout blob
+	bool fromBinary(const void* data, size_t numBytes);
+
+	static constexpr juce::uint32 binaryMagic = 0x424c544c; // "LTLB"
+	static constexpr int binaryVersion = 1;
+
 	int getNumBoards() const { return numBoards; }
 	int getOctaveBoardSize() const { return octaveBoardSize; }
 
+	const LumatoneConfigTable* readConfigTable(LumatoneConfigTable::TableType tableType) const;
 	LumatoneConfigTable* getConfigTable(LumatoneConfigTable::TableType tableType);
 
+	const int* readVelocityIntervalTable() const { return configTables->velocityIntervalTable; }
+	int* getVelocityIntervalTable() { return editConfigTables().velocityIntervalTable; }
+
 	juce::Array<juce::Colour> getLayoutColours() const;
     juce::Array<LumatoneKeyCoord> getKeysWithColour(const juce::Colour& c) const;
 
@@ -85,6 +144,9 @@ public:
 	const LumatoneBoard* readBoard(int index) const;
 	LumatoneBoard* getBoard(int index);
 
+	// Reference to the board that stays valid and unchanged however this layout is edited later
+	std::shared_ptr<const LumatoneBoard> shareBoard(int index) const;
+
 	LumatoneKey* getKey(int boardIndex, int keyIndex);
 	const LumatoneKey* readKey(int boardIndex, int keyIndex) const;
 	const LumatoneKey* readKey(int keyNum) const;
@@ -115,12 +177,4 @@ public:
 	bool invertExpression;
 	bool invertSustain;
 	int expressionControllerSensivity;
-
-	// Velocity curves
-	int table[VELOCITYINTERVALTABLESIZE];
-
-	LumatoneConfigTable	velocityTable;
-	LumatoneConfigTable faderTable;
-	LumatoneConfigTable afterTouchTable;
-	LumatoneConfigTable lumaTouchTable;
 };
@@ -0,0 +1,460 @@
+/*
+  ==============================================================================
+
+    lumatone_layout_parser.cpp
+    Created: 19 Oct 2026
+    Author:  Vincenzo
+
+  ==============================================================================
+*/
+
+#include "lumatone_layout_parser.h"
+
+static bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+static void skipSpaces(const char*& pos, const char* end)
+{
+    while (pos < end && isSpace(*pos))
+        pos++;
+}
+
+// Advances past the prefix if the text starts with it
+template <size_t N>
+static bool consume(const char*& pos, const char* end, const char (&prefix)[N])
+{
+    const size_t length = N - 1;
+    if ((size_t)(end - pos) < length || memcmp(pos, prefix, length) != 0)
+        return false;
+
+    pos += length;
+    return true;
+}
+
+juce::String LumatoneLayoutParser::Error::toString() const
+{
+    return "Line " + juce::String(line) + ", column " + juce::String(column) + ": " + message;
+}
+
+LumatoneLayoutParser::LumatoneLayoutParser(LumatoneLayout& layoutToFill)
+    : layout(layoutToFill)
+{
+}
+
+bool LumatoneLayoutParser::parse(const char* text, size_t numBytes)
+{
+    begin();
+
+    const char* pos = text;
+    const char* end = text + numBytes;
+
+    // UTF-8 byte order mark
+    if (numBytes >= 3 && (juce::uint8)pos[0] == 0xef && (juce::uint8)pos[1] == 0xbb && (juce::uint8)pos[2] == 0xbf)
+        pos += 3;
+
+    while (pos < end)
+    {
+        auto lineEnd = (const char*)memchr(pos, '\n', (size_t)(end - pos));
+        if (lineEnd == nullptr)
+            lineEnd = end;
+
+        parseLine(pos, lineEnd);
+        pos = lineEnd + 1;
+    }
+
+    return !hasErrors();
+}
+
+bool LumatoneLayoutParser::parseFile(const juce::File& file)
+{
+    if (!file.existsAsFile())
+    {
+        begin();
+        addError(nullptr, "File " + file.getFullPathName() + " does not exist");
+        return false;
+    }
+
+    juce::MemoryMappedFile mappedFile(file, juce::MemoryMappedFile::readOnly);
+
+    if (mappedFile.getData() == nullptr && file.getSize() > 0)
+    {
+        begin();
+        addError(nullptr, "File " + file.getFullPathName() + " could not be opened");
+        return false;
+    }
+
+    return parse((const char*)mappedFile.getData(), mappedFile.getSize());
+}
+
+void LumatoneLayoutParser::begin()
+{
+    layout.clearAll(true);
+
+    boardIndex = -1;
+    lineNumber = 0;
+    lineStart = nullptr;
+
+    errors.clearQuick();
+    numErrors = 0;
+}
+
+void LumatoneLayoutParser::parseLine(const char* line, const char* lineEnd)
+{
+    lineNumber++;
+    lineStart = line;
+
+    const char* pos = line;
+    const char* end = lineEnd;
+
+    skipSpaces(pos, end);
+    while (end > pos && isSpace(*(end - 1)))
+        end--;
+
+    if (pos == end)
+        return;
+
+    int keyIndex = 0;
+    int value = 0;
+
+    switch (*pos)
+    {
+    case '[':
+        if (consume(pos, end, "[Board"))
+            parseBoardHeader(pos, end);
+        return;
+
+    case 'K':
+        if (consume(pos, end, "Key_"))
+        {
+            if (parseKeyValue(pos, end, keyIndex, value))
+                layout.getKey(boardIndex, keyIndex)->noteNumber = value;
+        }
+        else if (consume(pos, end, "KTyp_"))
+        {
+            if (parseKeyValue(pos, end, keyIndex, value))
+            {
+                auto key = layout.getKey(boardIndex, keyIndex);
+                if (value < LumatoneKeyType::disabledDefault || value > LumatoneKeyType::disabled)
+                {
+                    addError(pos, "Invalid key type " + juce::String(value));
+                    key->keyType = LumatoneKeyType::disabled;
+                }
+                else if (key->keyType == LumatoneKeyType::disabledDefault)
+                    key->keyType = LumatoneKeyType::disabled;
+                else
+                    key->keyType = (LumatoneKeyType)value;
+            }
+        }
+        return;
+
+    case 'C':
+        if (consume(pos, end, "Chan_"))
+        {
+            if (parseKeyValue(pos, end, keyIndex, value))
+            {
+                auto key = layout.getKey(boardIndex, keyIndex);
+                if (value > 0 && value <= 16)
+                {
+                    key->channelNumber = value;
+                }
+                else
+                {
+                    key->channelNumber = 1;
+                    key->keyType = LumatoneKeyType::disabledDefault;
+                }
+            }
+        }
+        else if (consume(pos, end, "Col_"))
+        {
+            juce::uint32 colourValue = 0;
+            if (parseKeyIndex(pos, end, keyIndex) && expect(pos, end, '=') && readHex(pos, end, colourValue))
+                layout.getKey(boardIndex, keyIndex)->colour = juce::Colour(colourValue).withAlpha(1.0f);
+        }
+        else if (consume(pos, end, "CCInvert_"))
+        {
+            if (parseKeyIndex(pos, end, keyIndex))
+                layout.getKey(boardIndex, keyIndex)->ccFaderDefault = false;
+        }
+        return;
+
+    // General options
+    case 'A':
+        if (consume(pos, end, "AfterTouchActive=") && readInt(pos, end, value))
+            layout.afterTouchActive = value > 0;
+        return;
+
+    case 'L':
+        if (consume(pos, end, "LightOnKeyStrokes="))
+        {
+            if (readInt(pos, end, value))
+                layout.lightOnKeyStrokes = value > 0;
+        }
+        else if (consume(pos, end, "LumaTouchConfig="))
+            parseConfigTable(pos, end, *layout.getConfigTable(LumatoneConfigTable::TableType::lumaTouch));
+        return;
+
+    case 'I':
+        if (consume(pos, end, "InvertFootController="))
+        {
+            if (readInt(pos, end, value))
+                layout.invertExpression = value > 0;
+        }
+        else if (consume(pos, end, "InvertSustain="))
+        {
+            if (readInt(pos, end, value))
+                layout.invertSustain = value > 0;
+        }
+        return;
+
+    case 'E':
+        if (consume(pos, end, "ExprCtrlSensivity=") && readInt(pos, end, value))
+            layout.expressionControllerSensivity = value;
+        return;
+
+    // Velocity curve config
+    case 'V':
+        if (consume(pos, end, "VelocityIntrvlTbl="))
+            parseIntervalTable(pos, end);
+        return;
+
+    case 'N':
+        if (consume(pos, end, "NoteOnOffVelocityCrvTbl="))
+            parseConfigTable(pos, end, *layout.getConfigTable(LumatoneConfigTable::TableType::velocityInterval));
+        return;
+
+    case 'F':
+        if (consume(pos, end, "FaderConfig="))
+            parseConfigTable(pos, end, *layout.getConfigTable(LumatoneConfigTable::TableType::fader));
+        return;
+
+    case 'a':
+        if (consume(pos, end, "afterTouchConfig="))
+            parseConfigTable(pos, end, *layout.getConfigTable(LumatoneConfigTable::TableType::afterTouch));
+        return;
+
+    default:
+        // Unknown entries are ignored
+        return;
+    }
+}
+
+bool LumatoneLayoutParser::parseBoardHeader(const char* pos, const char* end)
+{
+    skipSpaces(pos, end);
+    const char* indexPos = pos;
+
+    int index = 0;
+    if (!readInt(pos, end, index) || !expect(pos, end, ']'))
+        return false;
+
+    if (index < 0 || index >= layout.getNumBoards())
+    {
+        addError(indexPos, "Board index " + juce::String(index) + " is out of range");
+        boardIndex = -1;
+        return false;
+    }
+
+    boardIndex = index;
+    return true;
+}
+
+bool LumatoneLayoutParser::parseKeyValue(const char* pos, const char* end, int& keyIndex, int& value)
+{
+    return parseKeyIndex(pos, end, keyIndex)
+        && expect(pos, end, '=')
+        && readInt(pos, end, value);
+}
+
+bool LumatoneLayoutParser::parseKeyIndex(const char*& pos, const char* end, int& keyIndex)
+{
+    const char* indexPos = pos;
+    if (!readInt(pos, end, keyIndex))
+        return false;
+
+    return checkKeyIndex(indexPos, keyIndex);
+}
+
+bool LumatoneLayoutParser::checkKeyIndex(const char* pos, int keyIndex)
+{
+    if (boardIndex < 0)
+    {
+        addError(pos, "Key data before a [Board] header");
+        return false;
+    }
+
+    if (keyIndex < 0 || keyIndex >= MAXBOARDSIZE)
+    {
+        addError(pos, "Key index " + juce::String(keyIndex) + " is out of range");
+        return false;
+    }
+
+    return true;
+}
+
+void LumatoneLayoutParser::parseIntervalTable(const char* pos, const char* end)
+{
+    skipSpaces(pos, end);
+    if (pos == end)
+    {
+        layout.clearVelocityIntervalTable();
+        return;
+    }
+
+    int* intervalTable = layout.getVelocityIntervalTable();
+
+    int numValues = 0;
+    while (pos < end && numValues < VELOCITYINTERVALTABLESIZE)
+    {
+        if (!readInt(pos, end, intervalTable[numValues]))
+            return;
+
+        numValues++;
+        skipSpaces(pos, end);
+    }
+
+    if (numValues < VELOCITYINTERVALTABLESIZE)
+        addError(pos, "Velocity interval table has " + juce::String(numValues) + " of " + juce::String(VELOCITYINTERVALTABLESIZE) + " values");
+}
+
+void LumatoneLayoutParser::parseConfigTable(const char* pos, const char* end, LumatoneConfigTable& configTable)
+{
+    skipSpaces(pos, end);
+
+    LumatoneConfigTable::DrawMode drawMode = LumatoneConfigTable::DrawMode::freeDrawing;
+    if (consume(pos, end, "LINEAR"))
+        drawMode = LumatoneConfigTable::DrawMode::linearSegments;
+    else if (consume(pos, end, "Quadratic"))
+        drawMode = LumatoneConfigTable::DrawMode::quadraticCurves;
+
+    skipSpaces(pos, end);
+    if (pos == end)
+    {
+        if (drawMode == LumatoneConfigTable::DrawMode::freeDrawing)
+        {
+            configTable = LumatoneConfigTable();
+        }
+        else
+        {
+            // Initialize segment table
+            configTable.editStrategy = drawMode;
+            for (int x = 0; x < 128; x++)
+                configTable.velocityValues[x] = -1;
+        }
+
+        return;
+    }
+
+    configTable.editStrategy = drawMode;
+
+    int numValues = 0;
+    while (pos < end && numValues < 128)
+    {
+        if (!readInt(pos, end, configTable.velocityValues[numValues]))
+            break;
+
+        numValues++;
+        skipSpaces(pos, end);
+    }
+
+    if (numValues < 128)
+    {
+        if (pos == end)
+            addError(pos, "Table has " + juce::String(numValues) + " of 128 values");
+
+        for (int x = numValues; x < 128; x++)
+            configTable.velocityValues[x] = 0;
+    }
+}
+
+bool LumatoneLayoutParser::readInt(const char*& pos, const char* end, int& value)
+{
+    skipSpaces(pos, end);
+
+    bool negative = false;
+    if (pos < end && (*pos == '-' || *pos == '+'))
+    {
+        negative = *pos == '-';
+        pos++;
+    }
+
+    if (pos == end || *pos < '0' || *pos > '9')
+    {
+        addError(pos, "Expected a number");
+        return false;
+    }
+
+    int result = 0;
+    while (pos < end && *pos >= '0' && *pos <= '9')
+    {
+        // Clamp instead of overflowing, out of range values are caught by the callers
+        if (result < 100000000)
+            result = result * 10 + (*pos - '0');
+        pos++;
+    }
+
+    value = negative ? -result : result;
+    return true;
+}
+
+bool LumatoneLayoutParser::readHex(const char*& pos, const char* end, juce::uint32& value)
+{
+    skipSpaces(pos, end);
+
+    if (pos < end && *pos == '#')
+        pos++;
+    else
+        consume(pos, end, "0x");
+
+    juce::uint32 result = 0;
+    int numDigits = 0;
+
+    while (pos < end && numDigits < 8)
+    {
+        const int digit = juce::CharacterFunctions::getHexDigitValue((juce::juce_wchar)(juce::uint8)*pos);
+        if (digit < 0)
+            break;
+
+        result = (result << 4) | (juce::uint32)digit;
+        numDigits++;
+        pos++;
+    }
+
+    if (numDigits == 0)
+    {
+        addError(pos, "Expected a hex colour");
+        return false;
+    }
+
+    value = result;
+    return true;
+}
+
+bool LumatoneLayoutParser::expect(const char*& pos, const char* end, char c)
+{
+    skipSpaces(pos, end);
+
+    if (pos == end || *pos != c)
+    {
+        addError(pos, "Expected '" + juce::String::charToString(c) + "'");
+        return false;
+    }
+
+    pos++;
+    return true;
+}
+
+void LumatoneLayoutParser::addError(const char* position, const juce::String& message)
+{
+    numErrors++;
+
+    if (errors.size() >= maxErrors)
+        return;
+
+    Error error;
+    error.line = lineNumber;
+    error.column = (position != nullptr && lineStart != nullptr) ? (int)(position - lineStart) + 1 : 0;
+    error.message = message;
+    errors.add(error);
+}
@@ -0,0 +1,82 @@
+/*
+  ==============================================================================
+
+    lumatone_layout_parser.h
+    Created: 19 Oct 2026
+    Author:  Vincenzo
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "lumatone_layout.h"
+
+/*
+==============================================================================
+Single pass parser for .ltn layout text.
+
+Lines are dispatched on their prefix and values are read in place, so parsing
+does not allocate unless an error is recorded. Malformed lines are reported
+with their line and column and skipped, the rest of the layout still loads.
+==============================================================================
+*/
+class LumatoneLayoutParser
+{
+public:
+    struct Error
+    {
+        int line = 0;
+        int column = 0;
+        juce::String message;
+
+        juce::String toString() const;
+    };
+
+    // Stop recording errors after this many, so garbage input can't grow the list unbounded
+    static constexpr int maxErrors = 64;
+
+public:
+    LumatoneLayoutParser(LumatoneLayout& layoutToFill);
+
+    // Clears the layout and parses complete .ltn text, returns false if any errors were found
+    bool parse(const char* text, size_t numBytes);
+
+    // Parses a file through a memory mapped view rather than reading it into lines
+    bool parseFile(const juce::File& file);
+
+    // For input that is already split into lines, call begin() once then parseLine() for each line
+    void begin();
+    void parseLine(const char* line, const char* lineEnd);
+
+    const juce::Array<Error>& getErrors() const { return errors; }
+    bool hasErrors() const { return numErrors > 0; }
+
+    // Total including errors that weren't recorded past maxErrors
+    int getNumErrors() const { return numErrors; }
+
+private:
+    bool parseBoardHeader(const char* pos, const char* end);
+    bool parseKeyValue(const char* pos, const char* end, int& keyIndex, int& value);
+    bool parseKeyIndex(const char*& pos, const char* end, int& keyIndex);
+    bool checkKeyIndex(const char* pos, int keyIndex);
+
+    void parseIntervalTable(const char* pos, const char* end);
+    void parseConfigTable(const char* pos, const char* end, LumatoneConfigTable& configTable);
+
+    bool readInt(const char*& pos, const char* end, int& value);
+    bool readHex(const char*& pos, const char* end, juce::uint32& value);
+    bool expect(const char*& pos, const char* end, char c);
+
+    void addError(const char* position, const juce::String& message);
+
+private:
+    LumatoneLayout& layout;
+
+    int boardIndex = -1;
+    int lineNumber = 0;
+    const char* lineStart = nullptr;
+
+    juce::Array<Error> errors;
+    int numErrors = 0;
+};
@@ -3,23 +3,29 @@
 #include "../listeners/midi_listener.h"
 
 #include "../lumatone_midi_driver/lumatone_midi_driver.h"
+#include "../lumatone_midi_driver/host_midi_queue.h"
 
 LumatoneApplicationMidiController::LumatoneApplicationMidiController(LumatoneApplicationState stateIn, LumatoneFirmwareDriver& firmwareDriverIn)
     : appState("LumatoneApplicationMidiController", stateIn)
     , firmwareDriver(firmwareDriverIn)
 {
     firmwareDriver.addDriverListener(this);
+    deviceMidiState.addMidiStateListener(&deviceAftertouchForwarder);
 }
 
 LumatoneApplicationMidiController::~LumatoneApplicationMidiController()
 {
     listeners.clear();
+    deviceMidiState.removeMidiStateListener(&deviceAftertouchForwarder);
     firmwareDriver.removeDriverListener(this);
 }
 
 void LumatoneApplicationMidiController::sendMidiMessage(const juce::MidiMessage msg)
 {
-    firmwareDriver.sendMessageNow(msg);
+    if (hostMidiQueue != nullptr)
+        hostMidiQueue->addMessage(msg);
+    else
+        firmwareDriver.sendMessageNow(msg);
 }
 
 void LumatoneApplicationMidiController::sendMidiMessageInContext(const juce::MidiMessage msg, int boardIndex, int keyIndex)
@@ -48,62 +54,50 @@ void LumatoneApplicationMidiController::sendMidiMessageInContext(const juce::Mid
     sendMidiMessage(newMsg);
 }
 
-void LumatoneApplicationMidiController::sendKeyNoteOn(int boardIndex, int keyIndex, juce::uint8 velocity, bool ignoreContext)
+void LumatoneApplicationMidiController::scheduleMidiMessage(const juce::MidiMessage& msg, double timeMs)
 {
-    bool useContext = !ignoreContext && appState.isContextSet();
-
-    // const LumatoneKey* keyData = appState.getKey(boardIndex, keyIndex);
-    // LumatoneKeyContext context = appState.getKeyContext(boardIndex, keyIndex);
-    // LumatoneKey key = *keyData;
-    // LumatoneKey ctx = appState.getKeyContext(boardIndex, keyIndex);
-
-// #if JUCE_DEBUG
-//     LumatoneKey key;
-//     if (useContext)
-//         key = (LumatoneKey)appState.getKeyContext(boardIndex, keyIndex);
-//     else 
-//         key = appState.getKeyContext(boardIndex, keyIndex);
-// #else
-//     LumatoneKey key = (useContext)
-//         ? (LumatoneKey)appState.getKeyContext(boardIndex, keyIndex);
-//         : appState.getKeyContext(boardIndex, keyIndex); 
-// #endif
-
-    LumatoneKey key
-    #if JUCE_DEBUG
-    ; if (useContext)
-        key = 
-    #else 
-       = (useContext) ? 
-    #endif
-        (LumatoneKey)appState.getKeyContext(boardIndex, keyIndex)
-    #if JUCE_DEBUG
-    ; else
-        key = 
-    #else
-        :
-    #endif
-        *appState.getKey(boardIndex, keyIndex);
-    
+    if (timeMs <= 0)
+        sendMidiMessage(msg);
+    else if (hostMidiQueue != nullptr)
+        hostMidiQueue->addMessageAt(msg, timeMs);
+    else
+        firmwareDriver.sendMessageAt(msg, timeMs);
+}
 
-    jassert(key.channelNumber > 0 && key.channelNumber <= 16 && key.noteNumber >= 0 && key.noteNumber < 128);
-        
-    juce::MidiMessage msg = juce::MidiMessage::noteOn(key.channelNumber, key.noteNumber, velocity);
-    sendMidiMessage(msg);
+void LumatoneApplicationMidiController::sendKeyNoteOn(int boardIndex, int keyIndex, juce::uint8 velocity, bool ignoreContext)
+{
+    scheduleKeyNoteOn(boardIndex, keyIndex, velocity, 0, ignoreContext);
 }
 
 void LumatoneApplicationMidiController::sendKeyNoteOff(int boardIndex, int keyIndex, bool ignoreContext)
 {
-    bool useContext = !ignoreContext && appState.isContextSet();
+    scheduleKeyNoteOff(boardIndex, keyIndex, 0, ignoreContext);
+}
 
-    LumatoneKey key = (useContext)
-        ? (LumatoneKey)appState.getKeyContext(boardIndex, keyIndex)
-        : *appState.getKey(boardIndex, keyIndex);
+void LumatoneApplicationMidiController::scheduleKeyNoteOn(int boardIndex, int keyIndex, juce::uint8 velocity, double timeMs, bool ignoreContext)
+{
+    LumatoneKey key = getKeyToPlay(boardIndex, keyIndex, ignoreContext);
+    jassert(key.channelNumber > 0 && key.channelNumber <= 16 && key.noteNumber >= 0 && key.noteNumber < 128);
 
+    juce::MidiMessage msg = juce::MidiMessage::noteOn(key.channelNumber, key.noteNumber, velocity);
+    scheduleMidiMessage(msg, timeMs);
+}
+
+void LumatoneApplicationMidiController::scheduleKeyNoteOff(int boardIndex, int keyIndex, double timeMs, bool ignoreContext)
+{
+    LumatoneKey key = getKeyToPlay(boardIndex, keyIndex, ignoreContext);
     jassert(key.channelNumber > 0 && key.channelNumber <= 16 && key.noteNumber >= 0 && key.noteNumber < 128);
-        
+
     juce::MidiMessage msg = juce::MidiMessage::noteOff(key.channelNumber, key.noteNumber);
-    sendMidiMessage(msg);
+    scheduleMidiMessage(msg, timeMs);
+}
+
+LumatoneKey LumatoneApplicationMidiController::getKeyToPlay(int boardIndex, int keyIndex, bool ignoreContext) const
+{
+    if (!ignoreContext && appState.isContextSet())
+        return (LumatoneKey)appState.getKeyContext(boardIndex, keyIndex);
+
+    return *appState.getKey(boardIndex, keyIndex);
 }
 
 void LumatoneApplicationMidiController::allNotesOff(int midiChannel)
@@ -177,14 +171,25 @@ void LumatoneApplicationMidiController::midiMessageReceived(juce::MidiInput *sou
         listeners.call(&LumatoneEditor::MidiListener::handleAnyNoteOff, message.getChannel(), message.getNoteNumber());
         listeners.call(&LumatoneEditor::MidiListener::handleDeviceNoteOff, message.getChannel(), message.getNoteNumber());
     }
-    else if (message.isAftertouch())
-    {
-        listeners.call(&LumatoneEditor::MidiListener::handleAnyAftertouch, message.getChannel(), message.getNoteNumber(), (juce::uint8) message.getAfterTouchValue());
-        listeners.call(&LumatoneEditor::MidiListener::handleDeviceAftertouch, message.getChannel(), message.getNoteNumber(), (juce::uint8) message.getAfterTouchValue());
-    }
+    // Aftertouch listeners are called by deviceMidiState
     else if (message.isController())
     {
         listeners.call(&LumatoneEditor::MidiListener::handleAnyController, message.getChannel(), message.getControllerNumber(), (juce::uint8) message.getControllerValue());
         listeners.call(&LumatoneEditor::MidiListener::handleDeviceController, message.getChannel(), message.getControllerNumber(), (juce::uint8) message.getControllerValue());
     }
 }
+
+void LumatoneApplicationMidiController::midiBufferReceived(juce::MidiInput* source, const juce::MidiBuffer& buffer)
+{
+    LumatoneMidiState::ScopedBatch deviceBatch(deviceMidiState);
+    LumatoneMidiState::ScopedBatch appBatch(appMidiState);
+
+    for (const auto metadata : buffer)
+        midiMessageReceived(source, metadata.getMessage());
+}
+
+void LumatoneApplicationMidiController::DeviceAftertouchForwarder::handleAftertouch(LumatoneMidiState* midiState, int midiChannel, int midiNote, juce::uint8 aftertouch)
+{
+    controller.listeners.call(&LumatoneEditor::MidiListener::handleAnyAftertouch, midiChannel, midiNote, aftertouch);
+    controller.listeners.call(&LumatoneEditor::MidiListener::handleDeviceAftertouch, midiChannel, midiNote, aftertouch);
+}
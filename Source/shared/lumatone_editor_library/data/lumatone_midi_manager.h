@@ -21,6 +21,7 @@
 #include "./lumatone_context.h"
 
 class LumatoneFirmwareDriver;
+class LumatoneHostMidiQueue;
 
 namespace LumatoneEditor
 {
@@ -38,12 +39,21 @@ public:
     LumatoneMidiState* getDeviceMidiState() { return &deviceMidiState; }
     LumatoneMidiState* getAppMidiState() { return &appMidiState; }
 
+    // Plugin mode, sends this controller's non-SysEx MIDI through its own queue instead of the driver's,
+    // so it reaches the host on this instance's track. nullptr to use the driver.
+    void setHostMidiQueue(LumatoneHostMidiQueue* queue) { hostMidiQueue = queue; }
+
     void sendMidiMessage(const juce::MidiMessage msg);
     void sendMidiMessageInContext(const juce::MidiMessage msg, int boardIndex, int keyIndex);
 
     void sendKeyNoteOn(int boardIndex, int keyIndex, juce::uint8 velocity, bool ignoreContext=false);
     void sendKeyNoteOff(int boardIndex, int keyIndex, bool ignoreContext=false);
 
+    // Send at a juce::Time::getMillisecondCounterHiRes() time, or now if timeMs is 0
+    void scheduleMidiMessage(const juce::MidiMessage& msg, double timeMs);
+    void scheduleKeyNoteOn(int boardIndex, int keyIndex, juce::uint8 velocity, double timeMs, bool ignoreContext=false);
+    void scheduleKeyNoteOff(int boardIndex, int keyIndex, double timeMs, bool ignoreContext=false);
+
     void allNotesOff(int midiChannel);
     void allNotesOff();
 
@@ -67,18 +77,38 @@ protected:
 
     // LumatoneFirmwareDriver::Collector implementation
 	void midiMessageReceived(juce::MidiInput* source, const juce::MidiMessage& message) override;
+    void midiBufferReceived(juce::MidiInput* source, const juce::MidiBuffer& buffer) override;
     void midiMessageSent(juce::MidiOutput* target, const juce::MidiMessage& message) override {}
     void midiSendQueueSize(int size) override {}
     void noAnswerToMessage(juce::MidiDeviceInfo expectedDevice, const juce::MidiMessage& message) override {}
 
 
+private:
+
+    // Key in the current context, or in the layout
+    LumatoneKey getKeyToPlay(int boardIndex, int keyIndex, bool ignoreContext) const;
+
+private:
+
+    // Device aftertouch goes to listeners through the device state, so it's coalesced per key within a block
+    struct DeviceAftertouchForwarder : public LumatoneMidiState::Listener
+    {
+        DeviceAftertouchForwarder(LumatoneApplicationMidiController& controllerIn) : controller(controllerIn) {}
+        void handleAftertouch(LumatoneMidiState* midiState, int midiChannel, int midiNote, juce::uint8 aftertouch) override;
+
+        LumatoneApplicationMidiController& controller;
+    };
+
 private:
 
     LumatoneApplicationState appState;
     LumatoneFirmwareDriver& firmwareDriver;
+    LumatoneHostMidiQueue* hostMidiQueue = nullptr;
 
     LumatoneMidiState deviceMidiState;
     LumatoneMidiState appMidiState; 
+
+    DeviceAftertouchForwarder deviceAftertouchForwarder { *this };
 };
 
 
@@ -17,19 +17,59 @@ LumatoneMidiState::LumatoneMidiState()
 
 void LumatoneMidiState::reset()
 {
-    juce::MidiKeyboardState::reset();
+    for (int n = 0; n < 128; n++)
+        noteStates[n].store(0, std::memory_order_relaxed);
 
     for (int ch = 0; ch < 16; ch++)
     {
         for (int n = 0; n < 128; n++)
         {
-            velocityStates[ch][n] = 0;
+            velocityStates[ch][n].store(0, std::memory_order_relaxed);
+            aftertouchStates[ch][n].store(0, std::memory_order_relaxed);
+            controllerStates[ch][n].store(0, std::memory_order_relaxed);
+            pendingAftertouch[ch][n] = noPendingAftertouch;
+            pendingAftertouchListed[ch][n] = false;
         }
     }
 
+    numPendingAftertouch = 0;
+
+    const juce::SpinLock::ScopedLockType lock(eventsToAddLock);
     eventsToAdd.clear();
 }
 
+bool LumatoneMidiState::isNoteOn(int midiChannel, int midiNoteNumber) const noexcept
+{
+    jassert(midiChannel > 0 && midiChannel <= 16);
+
+    return juce::isPositiveAndBelow(midiNoteNumber, 128)
+        && (noteStates[midiNoteNumber].load(std::memory_order_relaxed) & (1 << (midiChannel - 1))) != 0;
+}
+
+bool LumatoneMidiState::isNoteOnForChannels(int midiChannelMask, int midiNoteNumber) const noexcept
+{
+    return juce::isPositiveAndBelow(midiNoteNumber, 128)
+        && (noteStates[midiNoteNumber].load(std::memory_order_relaxed) & midiChannelMask) != 0;
+}
+
+void LumatoneMidiState::allNotesOff(int midiChannel)
+{
+    const juce::uint16 mask = (midiChannel <= 0) ? 0xffff : (juce::uint16)(1 << (midiChannel - 1));
+
+    for (int n = 0; n < 128; n++)
+        noteStates[n].fetch_and((juce::uint16)~mask, std::memory_order_relaxed);
+}
+
+void LumatoneMidiState::setNoteState(int midiChannel, int midiNote, bool isOn)
+{
+    const juce::uint16 bit = (juce::uint16)(1 << (midiChannel - 1));
+
+    if (isOn)
+        noteStates[midiNote].fetch_or(bit, std::memory_order_relaxed);
+    else
+        noteStates[midiNote].fetch_and((juce::uint16)~bit, std::memory_order_relaxed);
+}
+
 void LumatoneMidiState::processNextMidiEvent(const juce::MidiMessage& message)
 {
     if (message.isNoteOn())
@@ -42,7 +82,28 @@ void LumatoneMidiState::processNextMidiEvent(const juce::MidiMessage& message)
     }
     else if (message.isAftertouch())
     {
-        aftertouchInternal(message.getChannel(), message.getNoteNumber(), message.getAfterTouchValue());
+        const int channel = message.getChannel();
+        const int note = message.getNoteNumber();
+        const auto value = (juce::uint8)message.getAfterTouchValue();
+
+        if (batchDepth > 0)
+        {
+            aftertouchStates[channel - 1][note].store(value, std::memory_order_relaxed);
+
+            auto& listed = pendingAftertouchListed[channel - 1][note];
+            if (!listed)
+            {
+                jassert(numPendingAftertouch < 16 * 128);
+                pendingAftertouchKeys[numPendingAftertouch++] = (juce::uint16)((channel - 1) * 128 + note);
+                listed = true;
+            }
+
+            pendingAftertouch[channel - 1][note] = value;
+        }
+        else
+        {
+            aftertouchInternal(channel, note, value);
+        }
     }
     else if (message.isController())
     {
@@ -57,12 +118,16 @@ void LumatoneMidiState::processNextMidiEvent(const juce::MidiMessage& message)
 
 void LumatoneMidiState::processNextMidiBuffer(juce::MidiBuffer& buffer, int startSample, int numSamples, bool injectIndirectEvents)
 {
-    const juce::ScopedLock sl(lock);
+    {
+        ScopedBatch batch(*this);
 
-    for (const auto metadata : buffer)
-        processNextMidiEvent(metadata.getMessage());
+        for (const auto metadata : buffer)
+            processNextMidiEvent(metadata.getMessage());
+    }
 
-    if (injectIndirectEvents)
+    const juce::SpinLock::ScopedLockType lock(eventsToAddLock);
+
+    if (injectIndirectEvents && !eventsToAdd.isEmpty())
     {
         const int firstEventToAdd = eventsToAdd.getFirstEventTime();
         const double scaleFactor = numSamples / (double)(eventsToAdd.getLastEventTime() + 1 - firstEventToAdd);
@@ -77,6 +142,42 @@ void LumatoneMidiState::processNextMidiBuffer(juce::MidiBuffer& buffer, int star
     eventsToAdd.clear();
 }
 
+void LumatoneMidiState::beginBatch()
+{
+    batchDepth++;
+}
+
+void LumatoneMidiState::endBatch()
+{
+    jassert(batchDepth > 0);
+    if (--batchDepth == 0)
+        flushPendingAftertouch();
+}
+
+void LumatoneMidiState::flushPendingAftertouch(int midiChannel, int midiNote)
+{
+    auto& pending = pendingAftertouch[midiChannel - 1][midiNote];
+    if (pending == noPendingAftertouch)
+        return;
+
+    // Stays listed until the batch ends, skipped on the full flush
+    auto value = pending;
+    pending = noPendingAftertouch;
+    aftertouchInternal(midiChannel, midiNote, value);
+}
+
+void LumatoneMidiState::flushPendingAftertouch()
+{
+    for (int i = 0; i < numPendingAftertouch; i++)
+    {
+        const int keyIndex = pendingAftertouchKeys[i];
+        pendingAftertouchListed[keyIndex / 128][keyIndex % 128] = false;
+        flushPendingAftertouch(keyIndex / 128 + 1, keyIndex % 128);
+    }
+
+    numPendingAftertouch = 0;
+}
+
 void LumatoneMidiState::noteOn(const int midiChannel, const int midiNote, juce::uint8 velocity)
 {
     jassert(midiChannel > 0 && midiChannel <= 16);
@@ -87,8 +188,11 @@ void LumatoneMidiState::noteOn(const int midiChannel, const int midiNote, juce::
         const int timeNow = (int)juce::Time::getMillisecondCounter();
 
         auto msg = juce::MidiMessage::noteOn(midiChannel, midiNote, velocity);
-        eventsToAdd.addEvent(msg, timeNow);
-        eventsToAdd.clear(0, timeNow - 500);
+        {
+            const juce::SpinLock::ScopedLockType lock(eventsToAddLock);
+            eventsToAdd.addEvent(msg, timeNow);
+            eventsToAdd.clear(0, timeNow - 500);
+        }
 
         noteOnInternal(msg, midiChannel, midiNote, velocity);
     }
@@ -104,8 +208,11 @@ void LumatoneMidiState::noteOff(const int midiChannel, const int midiNote, const
         const int timeNow = (int)juce::Time::getMillisecondCounter();
 
         auto msg = juce::MidiMessage::noteOff(midiChannel, midiNote, velocity);
-        eventsToAdd.addEvent(msg, timeNow);
-        eventsToAdd.clear(0, timeNow - 500);
+        {
+            const juce::SpinLock::ScopedLockType lock(eventsToAddLock);
+            eventsToAdd.addEvent(msg, timeNow);
+            eventsToAdd.clear(0, timeNow - 500);
+        }
 
         noteOffInternal(msg, midiChannel, midiNote, velocity);
     }
@@ -121,8 +228,11 @@ void LumatoneMidiState::aftertouch(const int midiChannel, const int midiNote, co
         const int timeNow = (int)juce::Time::getMillisecondCounter();
 
         auto msg = juce::MidiMessage::aftertouchChange(midiChannel, midiNote, aftertouch);
-        eventsToAdd.addEvent(msg, timeNow);
-        eventsToAdd.clear(0, timeNow - 500);
+        {
+            const juce::SpinLock::ScopedLockType lock(eventsToAddLock);
+            eventsToAdd.addEvent(msg, timeNow);
+            eventsToAdd.clear(0, timeNow - 500);
+        }
 
         aftertouchInternal(midiChannel, midiNote, aftertouch);
     }
@@ -139,8 +249,11 @@ void LumatoneMidiState::controller(const int midiChannel, const int number, cons
         const int timeNow = (int)juce::Time::getMillisecondCounter();
 
         auto msg = juce::MidiMessage::controllerEvent(midiChannel, number, value);
-        eventsToAdd.addEvent(msg, timeNow);
-        eventsToAdd.clear(0, timeNow - 500);
+        {
+            const juce::SpinLock::ScopedLockType lock(eventsToAddLock);
+            eventsToAdd.addEvent(msg, timeNow);
+            eventsToAdd.clear(0, timeNow - 500);
+        }
 
         controllerInternal(midiChannel, number, value);
     }
@@ -159,9 +272,10 @@ void LumatoneMidiState::removeMidiStateListener(LumatoneMidiState::Listener* lis
 
 void LumatoneMidiState::noteOnInternal(const juce::MidiMessage& msg, int midiChannel, int midiNote, juce::uint8 velocity)
 {
-    juce::MidiKeyboardState::processNextMidiEvent(msg);
+    flushPendingAftertouch(midiChannel, midiNote);
 
-    velocityStates[midiChannel - 1][midiNote] = velocity;
+    setNoteState(midiChannel, midiNote, true);
+    velocityStates[midiChannel - 1][midiNote].store(velocity, std::memory_order_relaxed);
 
     midiListeners.call(&LumatoneMidiState::Listener::handleLumatoneMidi, this, msg);
     midiListeners.call(&LumatoneMidiState::Listener::handleNoteOn, this, midiChannel, midiNote, velocity);
@@ -169,9 +283,10 @@ void LumatoneMidiState::noteOnInternal(const juce::MidiMessage& msg, int midiCha
 
 void LumatoneMidiState::noteOffInternal(const juce::MidiMessage& msg, int midiChannel, int midiNote, juce::uint8 velocity)
 {
-    juce::MidiKeyboardState::processNextMidiEvent(msg);
+    flushPendingAftertouch(midiChannel, midiNote);
 
-    velocityStates[midiChannel - 1][midiNote] = velocity;
+    setNoteState(midiChannel, midiNote, false);
+    velocityStates[midiChannel - 1][midiNote].store(velocity, std::memory_order_relaxed);
 
     midiListeners.call(&LumatoneMidiState::Listener::handleLumatoneMidi, this, msg);
     midiListeners.call(&LumatoneMidiState::Listener::handleNoteOff, this,  midiChannel, midiNote);
@@ -179,13 +294,16 @@ void LumatoneMidiState::noteOffInternal(const juce::MidiMessage& msg, int midiCh
 
 void LumatoneMidiState::aftertouchInternal(int midiChannel, int midiNote, juce::uint8 aftertouch)
 {
-    aftertouchStates[midiChannel - 1][midiNote] = aftertouch;
+    // A direct update supersedes a batched one
+    pendingAftertouch[midiChannel - 1][midiNote] = noPendingAftertouch;
+
+    aftertouchStates[midiChannel - 1][midiNote].store(aftertouch, std::memory_order_relaxed);
     midiListeners.call(&LumatoneMidiState::Listener::handleAftertouch, this, midiChannel, midiNote, aftertouch);
 }
 
 void LumatoneMidiState::controllerInternal(int midiChannel, int midiNote, juce::uint8 value)
 {
-    controllerStates[midiChannel - 1][midiNote] = value;
+    controllerStates[midiChannel - 1][midiNote].store(value, std::memory_order_relaxed);
     midiListeners.call(&LumatoneMidiState::Listener::handleController, this, midiChannel, midiNote, value);
 }
 
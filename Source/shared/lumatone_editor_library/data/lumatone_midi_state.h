@@ -12,7 +12,16 @@
 
 #include <JuceHeader.h>
 
-class LumatoneMidiState : private juce::MidiKeyboardState
+/*
+    Note, aftertouch and controller state for 16 MIDI channels.
+
+    State is written by a single thread (the one processing MIDI), and can be
+    read from any thread without locking. The noteOn, noteOff, aftertouch and
+    controller calls may come from another thread, such as the message thread
+    while the audio thread processes buffers, so the events they queue for
+    injection are kept behind their own lock.
+*/
+class LumatoneMidiState
 {
 public:
 
@@ -21,13 +30,36 @@ public:
 
     void reset();
 
-    bool isNoteOn(int midiChannel, int midiNoteNumber) const noexcept { return juce::MidiKeyboardState::isNoteOn(midiChannel, midiNoteNumber); }
-    bool isNoteOnForChannels(int midiChannelMask, int midiNoteNumber) const noexcept { return juce::MidiKeyboardState::isNoteOnForChannels(midiChannelMask, midiNoteNumber); }
-    void allNotesOff(int midiChannel) { return juce::MidiKeyboardState::allNotesOff(midiChannel); }
+    bool isNoteOn(int midiChannel, int midiNoteNumber) const noexcept;
+    bool isNoteOnForChannels(int midiChannelMask, int midiNoteNumber) const noexcept;
+
+    // Clears note states without notifying listeners, 0 for all channels
+    void allNotesOff(int midiChannel);
+
+    juce::uint8 getVelocity(int midiChannel, int midiNote) const noexcept { return velocityStates[midiChannel - 1][midiNote].load(std::memory_order_relaxed); }
+    juce::uint8 getAftertouch(int midiChannel, int midiNote) const noexcept { return aftertouchStates[midiChannel - 1][midiNote].load(std::memory_order_relaxed); }
+    juce::uint8 getControllerValue(int midiChannel, int ccNum) const noexcept { return controllerStates[midiChannel - 1][ccNum].load(std::memory_order_relaxed); }
 
     void processNextMidiEvent(const juce::MidiMessage& message);
+
+    // Processes the buffer as one batch, see beginBatch
     void processNextMidiBuffer(juce::MidiBuffer& buffer, int startSample, int numSamples, bool injectIndirectEvents);
 
+    // While a batch is open, aftertouch listener calls are coalesced per key and made with the
+    // latest value when the batch ends, or before a note on or off of the same key.
+    // State queries are always up to date.
+    void beginBatch();
+    void endBatch();
+
+    struct ScopedBatch
+    {
+        ScopedBatch(LumatoneMidiState& stateIn) : state(stateIn) { state.beginBatch(); }
+        ~ScopedBatch() { state.endBatch(); }
+
+    private:
+        LumatoneMidiState& state;
+    };
+
 public:
     void noteOn(const int midiChannel, const int midiNote, const juce::uint8 velocity);
     void noteOff(const int midiChannel, const int midiNote, const juce::uint8 velocity);
@@ -67,10 +99,31 @@ protected:
 
 private:
 
-    juce::CriticalSection lock;
+    void setNoteState(int midiChannel, int midiNote, bool isOn);
+
+    void flushPendingAftertouch(int midiChannel, int midiNote);
+    void flushPendingAftertouch();
+
+private:
+
     juce::MidiBuffer eventsToAdd;
+    juce::SpinLock eventsToAddLock;
+
+    // One bit per channel
+    std::atomic<juce::uint16> noteStates[128];
+
+    std::atomic<juce::uint8> velocityStates[16][128];
+    std::atomic<juce::uint8> aftertouchStates[16][128];
+    std::atomic<juce::uint8> controllerStates[16][128];
+
+    // Batched aftertouch, only touched by the writing thread
+    static constexpr juce::uint8 noPendingAftertouch = 0xff;
+
+    int batchDepth = 0;
+    juce::uint8 pendingAftertouch[16][128];
 
-    juce::uint8 velocityStates[16][128];
-    juce::uint8 aftertouchStates[16][128];
-    juce::uint8 controllerStates[16][128];
+    // Each key is listed at most once per batch, even after being flushed by a note on or off
+    bool pendingAftertouchListed[16][128];
+    juce::uint16 pendingAftertouchKeys[16 * 128];
+    int numPendingAftertouch = 0;
 };
\ No newline at end of file
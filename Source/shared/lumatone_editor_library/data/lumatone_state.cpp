@@ -9,6 +9,7 @@
 */
 
 #include "lumatone_state.h"
+#include "lumatone_layout_parser.h"
 
 #include "../lumatone_output_map.h"
 
@@ -20,6 +21,7 @@ juce::Array<juce::Identifier> LumatoneState::getLumatoneStateProperties()
     properties.add(LumatoneStateProperty::LastConnectedNumBoards);
 
     properties.add(LumatoneStateProperty::MappingData);
+    properties.add(LumatoneStateProperty::MappingBlob);
 
     return properties;
 }
@@ -94,6 +96,22 @@ void LumatoneState::handleStatePropertyChange(juce::ValueTree stateIn, const juc
             mappingData.reset(new LumatoneLayout(loadedLayout));
         }
     }
+    else if (property == LumatoneStateProperty::MappingBlob)
+    {
+        auto* blob = stateIn.getProperty(property).getBinaryData();
+        if (blob == nullptr || blob->isEmpty())
+            return;
+
+        LumatoneLayout loadedLayout;
+        if (loadedLayout.fromBinary(blob->getData(), blob->getSize()))
+        {
+            mappingData.reset(new LumatoneLayout(loadedLayout));
+        }
+        else
+        {
+            jassertfalse;
+        }
+    }
     else if (property == LumatoneStateProperty::InvertExpression)
     {
         invertExpression = (bool)stateIn.getProperty(property, false);
@@ -260,11 +278,15 @@ bool LumatoneState::loadLayoutFromFile(const juce::File& layoutFile)
     {
         fileOpened = true;
 
-        juce::StringArray stringArray;
-        layoutFile.readLines(stringArray);
-
         LumatoneLayout newLayout(getNumBoards(), getOctaveBoardSize(), true);
-        newLayout.fromStringArray(stringArray);
+        LumatoneLayoutParser parser(newLayout);
+
+        // Malformed lines are skipped, the rest of the layout is still usable
+        if (!parser.parseFile(layoutFile))
+        {
+            for (auto& error : parser.getErrors())
+                DBG(layoutFile.getFileName() + ": " + error.toString());
+        }
 
         // TODO: something if boards/size don't match?
         fileParsed = true;
@@ -274,10 +296,10 @@ bool LumatoneState::loadLayoutFromFile(const juce::File& layoutFile)
         {
             *mappingData = LumatoneLayout(newLayout);
 
-            auto layoutString = mappingData->toStringArray().joinIntoString(juce::newLine);
-            DBG("Loaded: " + layoutString);
+            writeBinaryProperty(LumatoneStateProperty::MappingBlob, mappingData->toBinary(), undoManager);
 
-            writeStringProperty(LumatoneStateProperty::MappingData, layoutString, undoManager);
+            if (state.hasProperty(LumatoneStateProperty::MappingData))
+                state.removeProperty(LumatoneStateProperty::MappingData, undoManager);
 
             invertSustain = mappingData->invertSustain;
             writeBoolProperty(LumatoneStateProperty::InvertSustain, invertSustain, undoManager);
@@ -27,7 +27,10 @@ namespace LumatoneStateProperty
     static const juce::Identifier LastConnectedFirmwareVersion = juce::Identifier("LastConnectedFirmwareVersion");
     static const juce::Identifier LastConnectedNumBoards = juce::Identifier("LastConnectedNumBoards");
 
+    // Legacy .ltn text, only read when restoring older states
     static const juce::Identifier MappingData = juce::Identifier("MappingData");
+    // LumatoneLayout::toBinary blob
+    static const juce::Identifier MappingBlob = juce::Identifier("MappingBlob");
 
     static const juce::Identifier InvertExpression = juce::Identifier("InvertExpression");
     static const juce::Identifier InvertSustain = juce::Identifier("InvertSustain");
@@ -48,3 +48,8 @@ void LumatoneStateBase::writeStringProperty(const juce::Identifier key, juce::St
 {
     state.setPropertyExcludingListener(this, key, value, undo);
 }
+
+void LumatoneStateBase::writeBinaryProperty(const juce::Identifier key, const juce::MemoryBlock& value, juce::UndoManager* undo)
+{
+    state.setPropertyExcludingListener(this, key, juce::var(value), undo);
+}
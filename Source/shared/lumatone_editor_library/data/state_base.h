@@ -33,4 +33,5 @@ protected:
     void writeBoolProperty(const juce::Identifier key, bool value, juce::UndoManager* undo=nullptr);
     void writeIntProperty(const juce::Identifier key, int value, juce::UndoManager* undo=nullptr);
     void writeStringProperty(const juce::Identifier key, juce::String value, juce::UndoManager* undo=nullptr);
+    void writeBinaryProperty(const juce::Identifier key, const juce::MemoryBlock& value, juce::UndoManager* undo=nullptr);
 };
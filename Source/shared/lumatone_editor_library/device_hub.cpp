@@ -0,0 +1,166 @@
+/*
+  ==============================================================================
+
+    device_hub.cpp
+    Created: 19 Oct 2026
+    Author:  Vincenzo
+
+  ==============================================================================
+*/
+
+#include "device_hub.h"
+
+#include "DeviceActivityMonitor.h"
+#include "LumatoneController.h"
+
+LumatoneDeviceHub::LumatoneDeviceHub()
+{
+}
+
+LumatoneDeviceHub::~LumatoneDeviceHub()
+{
+    jassert(sessions.size() == 0);
+
+    monitor = nullptr;
+    driver = nullptr;
+}
+
+void LumatoneDeviceHub::addSession(LumatoneDeviceSession* session, LumatoneFirmwareDriver::HostMode hostMode)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    if (driver == nullptr)
+        driver = std::make_unique<LumatoneFirmwareDriver>(hostMode);
+
+    // Instances in one process should all be hosted the same way
+    jassert(driver->getHostMode() == hostMode);
+
+    sessions.addIfNotAlreadyThere(session);
+}
+
+void LumatoneDeviceHub::removeSession(LumatoneDeviceSession* session)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    sessions.removeFirstMatchingValue(session);
+
+    if (owner.load() == session)
+        setOwner(sessions.getLast());
+}
+
+void LumatoneDeviceHub::sessionControllerChanged(LumatoneDeviceSession* session, LumatoneController* previousController)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    if (previousController != nullptr && monitor != nullptr)
+        monitor->removeStatusListener(previousController);
+
+    auto controller = session->getController();
+    if (controller == nullptr)
+        return;
+
+    const bool ownsDevice = owner.load() == session || owner.load() == nullptr;
+    controller->setOwnsDeviceOutput(ownsDevice);
+
+    if (monitor == nullptr)
+    {
+        // Settings for detection are read from the first instance's state
+        monitor = std::make_unique<DeviceActivityMonitor>(driver.get(), (LumatoneApplicationState)*controller);
+        monitor->addStatusListener(controller);
+        monitor->startDeviceDetection();
+    }
+    else
+    {
+        monitor->addStatusListener(controller);
+
+        // Catch up with a connection made before this instance was added
+        if (monitor->isConnectionEstablished())
+            controller->connectionStateChanged(ConnectionState::ONLINE);
+    }
+
+    if (ownsDevice)
+        setOwner(session);
+}
+
+void LumatoneDeviceHub::setOwner(LumatoneDeviceSession* session)
+{
+    JUCE_ASSERT_MESSAGE_THREAD
+
+    auto previousOwner = owner.exchange(session);
+    if (previousOwner == session)
+        return;
+
+    if (previousOwner != nullptr && previousOwner->getController() != nullptr)
+        previousOwner->getController()->setOwnsDeviceOutput(false);
+
+    if (session != nullptr && session->getController() != nullptr)
+    {
+        auto controller = session->getController();
+        controller->setOwnsDeviceOutput(true);
+
+        // Replace the previous owner's layout on the device
+        if (previousOwner != nullptr && monitor != nullptr && monitor->isConnectionEstablished())
+            controller->sendCurrentMapping();
+    }
+}
+
+//==============================================================================
+
+LumatoneDeviceSession::LumatoneDeviceSession(LumatoneFirmwareDriver::HostMode hostMode)
+{
+    hub->addSession(this, hostMode);
+}
+
+LumatoneDeviceSession::~LumatoneDeviceSession()
+{
+    setController(nullptr);
+    hub->removeSession(this);
+}
+
+void LumatoneDeviceSession::setController(LumatoneController* controllerIn)
+{
+    if (controller == controllerIn)
+        return;
+
+    auto previousController = controller;
+    controller = controllerIn;
+
+    if (previousController != nullptr)
+        previousController->setHostMidiQueue(nullptr);
+
+    if (controller != nullptr && getFirmwareDriver()->getHostMode() == LumatoneFirmwareDriver::HostMode::Plugin)
+        controller->setHostMidiQueue(&hostMidiQueue);
+
+    hub->sessionControllerChanged(this, previousController);
+}
+
+void LumatoneDeviceSession::requestDeviceOwnership()
+{
+    hub->setOwner(this);
+}
+
+void LumatoneDeviceSession::processBlock(juce::MidiBuffer& midiMessages, int numSamples, double sampleRate)
+{
+    auto driver = getFirmwareDriver();
+    if (driver->getHostMode() != LumatoneFirmwareDriver::HostMode::Plugin)
+    {
+        driver->readNextBuffer(midiMessages);
+        return;
+    }
+
+    if (ownsDevice())
+    {
+        // Passed on as one block so listeners can coalesce it
+        driver->handleIncomingMidiBuffer(midiMessages);
+
+        driver->readNextBuffer(midiMessages, numSamples, sampleRate);
+    }
+    else
+    {
+        // The device is usually routed to every track, so other instances would see the same messages
+        midiMessages.clear();
+    }
+
+    // Notes from this instance's controller go out on its own track
+    hostMidiQueue.readNextBuffer(midiMessages, numSamples, sampleRate);
+}
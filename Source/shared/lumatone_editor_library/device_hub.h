@@ -0,0 +1,109 @@
+/*
+  ==============================================================================
+
+    device_hub.h
+    Created: 19 Oct 2026
+    Author:  Vincenzo
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include "./lumatone_midi_driver/lumatone_midi_driver.h"
+
+class LumatoneController;
+class DeviceActivityMonitor;
+class LumatoneDeviceSession;
+
+/*
+==============================================================================
+Process-wide owner of the connection to the Lumatone.
+
+Every instance of the app or plugin in a process shares one firmware driver,
+so there's one send queue and one stream of SysEx to the device, and one
+activity monitor, so the device is only pinged once. The hub is created with
+the first LumatoneDeviceSession and deleted with the last one.
+
+One session at a time owns the device. Only its controller sends key and LED
+updates, and in plugin mode only its audio callback passes MIDI between the
+host and the driver. Notes played by each controller go out on the track of
+its own instance. The other controllers keep their own layouts and
+receive everything the device sends. Ownership goes to the session that asks
+for it last, normally when its editor is opened or clicked, and the new
+owner sends its whole layout.
+==============================================================================
+*/
+class LumatoneDeviceHub
+{
+public:
+    LumatoneDeviceHub();
+    ~LumatoneDeviceHub();
+
+    LumatoneFirmwareDriver* getFirmwareDriver() const { return driver.get(); }
+    DeviceActivityMonitor* getDeviceMonitor() const { return monitor.get(); }
+
+    int getNumSessions() const { return sessions.size(); }
+    LumatoneDeviceSession* getOwner() const { return owner.load(); }
+
+private:
+    friend class LumatoneDeviceSession;
+
+    // The first session decides the host mode of the driver
+    void addSession(LumatoneDeviceSession* session, LumatoneFirmwareDriver::HostMode hostMode);
+    void removeSession(LumatoneDeviceSession* session);
+
+    void sessionControllerChanged(LumatoneDeviceSession* session, LumatoneController* previousController);
+
+    void setOwner(LumatoneDeviceSession* session);
+
+private:
+    std::unique_ptr<LumatoneFirmwareDriver> driver;
+    std::unique_ptr<DeviceActivityMonitor> monitor;
+
+    // Message thread only
+    juce::Array<LumatoneDeviceSession*> sessions;
+
+    // Read from audio callbacks
+    std::atomic<LumatoneDeviceSession*> owner { nullptr };
+
+    JUCE_DECLARE_NON_COPYABLE(LumatoneDeviceHub)
+};
+
+/*
+==============================================================================
+An instance's handle on the LumatoneDeviceHub, keeping it alive.
+==============================================================================
+*/
+class LumatoneDeviceSession
+{
+public:
+    LumatoneDeviceSession(LumatoneFirmwareDriver::HostMode hostMode);
+    ~LumatoneDeviceSession();
+
+    LumatoneFirmwareDriver* getFirmwareDriver() const { return hub->getFirmwareDriver(); }
+    DeviceActivityMonitor* getDeviceMonitor() const { return hub->getDeviceMonitor(); }
+
+    // The instance's controller, made with getFirmwareDriver(). Set to nullptr before deleting it.
+    void setController(LumatoneController* controllerIn);
+    LumatoneController* getController() const { return controller; }
+
+    bool ownsDevice() const { return hub->getOwner() == this; }
+
+    // Makes this session the one that sends its layout to the device
+    void requestDeviceOwnership();
+
+    // Plugin mode audio callback. The owning session hands device messages from the host to the
+    // driver and replaces the buffer with the driver's output for this block, the others just clear it.
+    // Every session then adds the notes its own controller sent.
+    void processBlock(juce::MidiBuffer& midiMessages, int numSamples, double sampleRate);
+
+private:
+    juce::SharedResourcePointer<LumatoneDeviceHub> hub;
+    LumatoneController* controller = nullptr;
+
+    // Plugin mode, the controller's non-SysEx MIDI, only SysEx goes through the shared driver
+    LumatoneHostMidiQueue hostMidiQueue;
+
+    JUCE_DECLARE_NON_COPYABLE(LumatoneDeviceSession)
+};
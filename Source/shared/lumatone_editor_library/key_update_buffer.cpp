@@ -105,7 +105,7 @@ void LumatoneKeyUpdateBuffer::timerCallback()
             if (keyUpdate.boardIndex >= 0 && keyUpdate.keyIndex >= 0)
             {
                 // auto currentKey = getKey(board, keyIndex);
-                auto currentKey = preUpdateLayout.getBoard(board)->theKeys[keyIndex];
+                auto currentKey = *preUpdateLayout.readKey(board, keyIndex);
                 if (!currentKey.configIsEqual(keyUpdate))
                     firmwareDriver.sendKeyFunctionParameters(boardId, keyIndex, keyUpdate.noteNumber, keyUpdate.channelNumber, keyUpdate.keyType, keyUpdate.ccFaderDefault);
                 
@@ -3,6 +3,7 @@
 
 #include <JuceHeader.h>
 #include "../data/lumatone_context.h"
+#include "../data/key_change_set.h"
 
 namespace LumatoneEditor
 {
@@ -14,18 +15,20 @@ public:
     virtual ~EditorListener() {}
     
     // App Actions
-    virtual void completeMappingLoaded(LumatoneLayout mappingData) {}
-    virtual void boardChanged(LumatoneBoard boardData) {}
-    virtual void keyChanged(int boardIndex, int keyIndex, LumatoneKey lumatoneKey) {}
+    // Data is passed by reference and only valid during the call, copy anything that needs to be kept
+    virtual void completeMappingLoaded(const LumatoneLayout& mappingData) {}
+    virtual void boardChanged(const LumatoneBoard& boardData) {}
+    virtual void keyChanged(int boardIndex, int keyIndex, const LumatoneKey& lumatoneKey) {}
 
     virtual void tableChanged(LumatoneConfigTable::TableType type, const juce::uint8* table, int tableSize) {}
 
-    virtual void selectionChanged(juce::Array<MappedLumatoneKey> selection) {}
+    // Sent once for a batch of key edits, new values are in the emitter's layout
+    virtual void keysChanged(const LumatoneKeyChangeSet& changedKeys) {}
 
     virtual void contextChanged(LumatoneContext* context) {}
 
     // Firmware Actions
-    virtual void keyConfigChanged(int boardIndex, int keyIndex, LumatoneKey keyData) {}
+    virtual void keyConfigChanged(int boardIndex, int keyIndex, const LumatoneKey& keyData) {}
     virtual void keyColourChanged(int boardIndex, int keyIndex, juce::Colour keyColour) {}
     virtual void expressionPedalSensitivityChanged(unsigned char value) {}
     virtual void invertFootControllerChanged(bool inverted) {}
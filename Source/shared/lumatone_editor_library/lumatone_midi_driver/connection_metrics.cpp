@@ -0,0 +1,264 @@
+/*
+  ==============================================================================
+
+    connection_metrics.cpp
+    Created: 19 Oct 2026
+    Author:  Vincenzo
+
+  ==============================================================================
+*/
+
+#include "connection_metrics.h"
+
+LumatoneConnectionMetrics::LumatoneConnectionMetrics()
+{
+    startTimeMs = juce::Time::getMillisecondCounter();
+}
+
+LumatoneConnectionMetrics::~LumatoneConnectionMetrics()
+{
+    stopTimer();
+}
+
+LumatoneConnectionMetrics::Slot& LumatoneConnectionMetrics::getCurrentSlot()
+{
+    // Numbered from 1 so a zeroed slot is never mistaken for a current one
+    const juce::uint32 slotNum = juce::Time::getMillisecondCounter() / slotDurationMs + 1;
+
+    auto& slot = slots[slotNum % numSlots];
+    if (slot.slotNum != slotNum)
+    {
+        slot = Slot();
+        slot.slotNum = slotNum;
+        slot.maxQueueSize = currentQueueSize;
+    }
+
+    return slot;
+}
+
+int LumatoneConnectionMetrics::getLatencyBucket(double latencyMs)
+{
+    if (latencyMs < smallestLatencyBucketMs)
+        return 0;
+
+    const int bucket = 1 + (int)(std::log2(latencyMs / smallestLatencyBucketMs) * latencyBucketsPerOctave);
+    return juce::jmin(bucket, numLatencyBuckets - 1);
+}
+
+double LumatoneConnectionMetrics::getLatencyBucketValue(int bucket)
+{
+    if (bucket == 0)
+        return smallestLatencyBucketMs * 0.5;
+
+    // Geometric middle of the bucket, halving the worst case error of using either edge
+    return smallestLatencyBucketMs * std::exp2((bucket - 0.5) / latencyBucketsPerOctave);
+}
+
+void LumatoneConnectionMetrics::messageSent(int numBytes)
+{
+    juce::SpinLock::ScopedLockType l(lock);
+    auto& slot = getCurrentSlot();
+    slot.messagesSent++;
+    slot.bytesSent += numBytes;
+}
+
+void LumatoneConnectionMetrics::messageReceived(int numBytes)
+{
+    juce::SpinLock::ScopedLockType l(lock);
+    auto& slot = getCurrentSlot();
+    slot.messagesReceived++;
+    slot.bytesReceived += numBytes;
+}
+
+void LumatoneConnectionMetrics::answerReceived(double latencyMs, bool deviceBusy)
+{
+    const int bucket = getLatencyBucket(latencyMs);
+
+    juce::SpinLock::ScopedLockType l(lock);
+    auto& slot = getCurrentSlot();
+
+    if (deviceBusy)
+        slot.numBusy++;
+    else
+        slot.numAnswers++;
+
+    if (slot.numLatencySamples == 0)
+    {
+        slot.latencyMinMs = (float)latencyMs;
+        slot.latencyMaxMs = (float)latencyMs;
+    }
+    else
+    {
+        slot.latencyMinMs = juce::jmin(slot.latencyMinMs, (float)latencyMs);
+        slot.latencyMaxMs = juce::jmax(slot.latencyMaxMs, (float)latencyMs);
+    }
+
+    slot.numLatencySamples++;
+    slot.latencyCounts[bucket]++;
+}
+
+void LumatoneConnectionMetrics::answerTimedOut()
+{
+    juce::SpinLock::ScopedLockType l(lock);
+    getCurrentSlot().numTimeouts++;
+}
+
+void LumatoneConnectionMetrics::messageRetried()
+{
+    juce::SpinLock::ScopedLockType l(lock);
+    getCurrentSlot().numRetries++;
+}
+
+void LumatoneConnectionMetrics::messageDequeued(double waitMs)
+{
+    juce::SpinLock::ScopedLockType l(lock);
+    auto& slot = getCurrentSlot();
+    slot.numDequeued++;
+    slot.queueWaitTotalMs += waitMs;
+    slot.queueWaitMaxMs = juce::jmax(slot.queueWaitMaxMs, (float)waitMs);
+}
+
+void LumatoneConnectionMetrics::queueSizeChanged(int size)
+{
+    juce::SpinLock::ScopedLockType l(lock);
+    currentQueueSize = size;
+
+    auto& slot = getCurrentSlot();
+    slot.maxQueueSize = juce::jmax(slot.maxQueueSize, size);
+}
+
+void LumatoneConnectionMetrics::reset()
+{
+    juce::SpinLock::ScopedLockType l(lock);
+    for (auto& slot : slots)
+        slot = Slot();
+
+    startTimeMs = juce::Time::getMillisecondCounter();
+}
+
+LumatoneConnectionMetrics::Snapshot LumatoneConnectionMetrics::getSnapshot() const
+{
+    Snapshot snapshot;
+    Slot total;
+    bool hasLatency = false;
+
+    const juce::uint32 nowMs = juce::Time::getMillisecondCounter();
+    const juce::uint32 currentSlotNum = nowMs / slotDurationMs + 1;
+
+    {
+        juce::SpinLock::ScopedLockType l(lock);
+
+        // The current slot is only partly filled, so the window ends now rather than at a slot boundary
+        const juce::uint32 fullWindowMs = (numSlots - 1) * slotDurationMs + nowMs % slotDurationMs;
+        snapshot.windowMs = (int)juce::jmax((juce::uint32)1, juce::jmin(fullWindowMs, nowMs - startTimeMs));
+        snapshot.queueSize = currentQueueSize;
+
+        for (const auto& slot : slots)
+        {
+            if (slot.slotNum == 0 || currentSlotNum - slot.slotNum >= (juce::uint32)numSlots)
+                continue;
+
+            total.messagesSent += slot.messagesSent;
+            total.messagesReceived += slot.messagesReceived;
+            total.bytesSent += slot.bytesSent;
+            total.bytesReceived += slot.bytesReceived;
+
+            total.numAnswers += slot.numAnswers;
+            total.numBusy += slot.numBusy;
+            total.numTimeouts += slot.numTimeouts;
+            total.numRetries += slot.numRetries;
+
+            if (slot.numLatencySamples > 0)
+            {
+                total.latencyMinMs = hasLatency ? juce::jmin(total.latencyMinMs, slot.latencyMinMs) : slot.latencyMinMs;
+                total.latencyMaxMs = hasLatency ? juce::jmax(total.latencyMaxMs, slot.latencyMaxMs) : slot.latencyMaxMs;
+                hasLatency = true;
+
+                total.numLatencySamples += slot.numLatencySamples;
+                for (int i = 0; i < numLatencyBuckets; i++)
+                    total.latencyCounts[i] += slot.latencyCounts[i];
+            }
+
+            total.numDequeued += slot.numDequeued;
+            total.queueWaitTotalMs += slot.queueWaitTotalMs;
+            total.queueWaitMaxMs = juce::jmax(total.queueWaitMaxMs, slot.queueWaitMaxMs);
+
+            total.maxQueueSize = juce::jmax(total.maxQueueSize, slot.maxQueueSize);
+        }
+    }
+
+    snapshot.numAnswers = total.numAnswers;
+    snapshot.numBusy = total.numBusy;
+    snapshot.numTimeouts = total.numTimeouts;
+    snapshot.numRetries = total.numRetries;
+
+    const int numAllAnswers = total.numAnswers + total.numBusy;
+    if (numAllAnswers > 0)
+        snapshot.busyRate = (float)total.numBusy / (float)numAllAnswers;
+
+    snapshot.numLatencySamples = total.numLatencySamples;
+    if (total.numLatencySamples > 0)
+    {
+        snapshot.latencyMinMs = total.latencyMinMs;
+        snapshot.latencyMaxMs = total.latencyMaxMs;
+
+        auto getPercentile = [&](double fraction)
+        {
+            const int targetCount = juce::jmax(1, (int)std::ceil(fraction * total.numLatencySamples));
+
+            int count = 0;
+            for (int i = 0; i < numLatencyBuckets; i++)
+            {
+                count += total.latencyCounts[i];
+                if (count >= targetCount)
+                    return juce::jlimit(total.latencyMinMs, total.latencyMaxMs, (float)getLatencyBucketValue(i));
+            }
+
+            return total.latencyMaxMs;
+        };
+
+        snapshot.latencyP50Ms = getPercentile(0.5);
+        snapshot.latencyP99Ms = getPercentile(0.99);
+    }
+
+    const float windowSeconds = snapshot.windowMs * 0.001f;
+    snapshot.messagesSentPerSecond = total.messagesSent / windowSeconds;
+    snapshot.messagesReceivedPerSecond = total.messagesReceived / windowSeconds;
+    snapshot.bytesSentPerSecond = total.bytesSent / windowSeconds;
+    snapshot.bytesReceivedPerSecond = total.bytesReceived / windowSeconds;
+
+    if (total.numDequeued > 0)
+        snapshot.queueWaitMeanMs = (float)(total.queueWaitTotalMs / total.numDequeued);
+    snapshot.queueWaitMaxMs = total.queueWaitMaxMs;
+
+    snapshot.maxQueueSize = juce::jmax(total.maxQueueSize, snapshot.queueSize);
+
+    return snapshot;
+}
+
+void LumatoneConnectionMetrics::addListener(Listener* listener)
+{
+    listeners.add(listener);
+    if (!isTimerRunning())
+        startTimer(updateIntervalMs);
+}
+
+void LumatoneConnectionMetrics::removeListener(Listener* listener)
+{
+    listeners.remove(listener);
+    if (listeners.isEmpty())
+        stopTimer();
+}
+
+void LumatoneConnectionMetrics::setUpdateIntervalMs(int intervalMs)
+{
+    updateIntervalMs = juce::jmax(1, intervalMs);
+    if (isTimerRunning())
+        startTimer(updateIntervalMs);
+}
+
+void LumatoneConnectionMetrics::timerCallback()
+{
+    const auto snapshot = getSnapshot();
+    listeners.call(&Listener::connectionMetricsUpdated, snapshot);
+}
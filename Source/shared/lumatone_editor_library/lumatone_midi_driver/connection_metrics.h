@@ -0,0 +1,163 @@
+/*
+  ==============================================================================
+
+    connection_metrics.h
+    Created: 19 Oct 2026
+    Author:  Vincenzo
+
+  ==============================================================================
+*/
+
+#ifndef LUMATONE_CONNECTION_METRICS_H
+#define LUMATONE_CONNECTION_METRICS_H
+
+#include <JuceHeader.h>
+
+/*
+==============================================================================
+Rolling connection health figures for LumatoneFirmwareDriver.
+
+Events are counted into one second slots of a ring covering the last
+numSlots seconds. Ack latencies go into a logarithmic histogram with quarter
+octave buckets, so percentiles cost nothing to record and are accurate to
+about 10%. Recording takes a spin lock for a handful of increments and never
+allocates, so it is safe to leave on and to call from the MIDI thread.
+
+Listeners get a snapshot on the message thread at the update interval, the
+timer only runs while there are listeners.
+==============================================================================
+*/
+class LumatoneConnectionMetrics : private juce::Timer
+{
+public:
+    static constexpr int numSlots = 10;
+    static constexpr int slotDurationMs = 1000;
+
+    static constexpr int numLatencyBuckets = 64;
+    static constexpr int latencyBucketsPerOctave = 4;
+    static constexpr double smallestLatencyBucketMs = 0.25;
+
+    struct Snapshot
+    {
+        int windowMs = 0;
+
+        // Answers that retired a message, busy answers and timeouts are counted separately
+        int numAnswers = 0;
+        int numBusy = 0;
+        int numTimeouts = 0;
+        int numRetries = 0;
+
+        // Busy answers out of all answers, including busy ones
+        float busyRate = 0.0f;
+
+        // Time from sending a message to its answer, including busy answers
+        int numLatencySamples = 0;
+        float latencyMinMs = 0.0f;
+        float latencyP50Ms = 0.0f;
+        float latencyP99Ms = 0.0f;
+        float latencyMaxMs = 0.0f;
+
+        float messagesSentPerSecond = 0.0f;
+        float messagesReceivedPerSecond = 0.0f;
+        float bytesSentPerSecond = 0.0f;
+        float bytesReceivedPerSecond = 0.0f;
+
+        // Time messages spent in the send queue before their first send
+        float queueWaitMeanMs = 0.0f;
+        float queueWaitMaxMs = 0.0f;
+
+        int queueSize = 0;
+        int maxQueueSize = 0;
+    };
+
+    class Listener
+    {
+    public:
+        virtual ~Listener() {}
+        virtual void connectionMetricsUpdated(const Snapshot& metrics) = 0;
+    };
+
+public:
+    LumatoneConnectionMetrics();
+    ~LumatoneConnectionMetrics() override;
+
+    //============================================================================
+    // Recording, from any thread
+
+    void messageSent(int numBytes);
+    void messageReceived(int numBytes);
+
+    // An answer to a waiting message arrived, latencyMs after it was sent
+    void answerReceived(double latencyMs, bool deviceBusy);
+    void answerTimedOut();
+
+    // A message was sent again after a busy answer
+    void messageRetried();
+
+    // A message left the send queue after waiting waitMs
+    void messageDequeued(double waitMs);
+
+    void queueSizeChanged(int size);
+
+    void reset();
+
+    //============================================================================
+
+    Snapshot getSnapshot() const;
+
+    void addListener(Listener* listener);
+    void removeListener(Listener* listener);
+
+    void setUpdateIntervalMs(int intervalMs);
+
+private:
+    struct Slot
+    {
+        juce::uint32 slotNum = 0;
+
+        int messagesSent = 0;
+        int messagesReceived = 0;
+        juce::int64 bytesSent = 0;
+        juce::int64 bytesReceived = 0;
+
+        int numAnswers = 0;
+        int numBusy = 0;
+        int numTimeouts = 0;
+        int numRetries = 0;
+
+        int numLatencySamples = 0;
+        float latencyMinMs = 0.0f;
+        float latencyMaxMs = 0.0f;
+        int latencyCounts[numLatencyBuckets] = {};
+
+        int numDequeued = 0;
+        double queueWaitTotalMs = 0.0;
+        float queueWaitMaxMs = 0.0f;
+
+        int maxQueueSize = 0;
+    };
+
+    // Returns the slot for the current time, clearing it if it holds an older second. Call with lock held.
+    Slot& getCurrentSlot();
+
+    static int getLatencyBucket(double latencyMs);
+
+    // Representative latency of a histogram bucket, used for percentiles
+    static double getLatencyBucketValue(int bucket);
+
+    void timerCallback() override;
+
+private:
+    juce::SpinLock lock;
+
+    Slot slots[numSlots];
+    juce::uint32 startTimeMs = 0;
+    int currentQueueSize = 0;
+
+    int updateIntervalMs = 500;
+    juce::ListenerList<Listener> listeners;
+
+    JUCE_DECLARE_NON_COPYABLE(LumatoneConnectionMetrics)
+};
+
+#endif // LUMATONE_CONNECTION_METRICS_H
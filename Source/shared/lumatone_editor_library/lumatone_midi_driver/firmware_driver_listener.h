@@ -22,6 +22,14 @@ public:
     virtual ~LumatoneFirmwareDriverListener() {}
     
     virtual void midiMessageReceived(juce::MidiInput* source, const juce::MidiMessage& message) = 0;
+
+    // A block of messages from the host in plugin mode, in order
+    virtual void midiBufferReceived(juce::MidiInput* source, const juce::MidiBuffer& buffer)
+    {
+        for (const auto metadata : buffer)
+            midiMessageReceived(source, metadata.getMessage());
+    }
+
     virtual void midiMessageSent(juce::MidiOutput* target, const juce::MidiMessage& message) = 0;
     virtual void midiSendQueueSize(int size) = 0;
     // virtual void generalLogMessage(juce::String textMessage, ErrorLevel errorLevel) {}
@@ -9,7 +9,48 @@ void LumatoneSysEx::fillManufacturerId(unsigned char* data)
 
 juce::MidiMessage LumatoneSysEx::createTerpstraSysEx(juce::uint8 boardIndex, juce::uint8 cmd, juce::uint8 data1, juce::uint8 data2, juce::uint8 data3, juce::uint8 data4)
 {
-    unsigned char sysExData[9];
+    LumatoneSysExFrame frame;
+    fillTerpstraSysEx(frame, boardIndex, cmd, data1, data2, data3, data4);
+    return frame.toMidiMessage();
+}
+
+// Create a SysEx message to send 8-bit color precision
+juce::MidiMessage LumatoneSysEx::createExtendedKeyColourSysEx(juce::uint8 boardIndex, juce::uint8 cmd, juce::uint8 keyIndex, juce::uint8 redUpper, juce::uint8 redLower, juce::uint8 greenUpper, juce::uint8 greenLower, juce::uint8 blueUpper, juce::uint8 blueLower)
+{
+    LumatoneSysExFrame frame;
+    fillExtendedKeyColourSysEx(frame, boardIndex, cmd, keyIndex, redUpper, redLower, greenUpper, greenLower, blueUpper, blueLower);
+    return frame.toMidiMessage();
+}
+
+juce::MidiMessage LumatoneSysEx::createExtendedKeyColourSysEx(juce::uint8 boardIndex, juce::uint8 cmd, juce::uint8 keyIndex, int red, int green, int blue)
+{
+    return createExtendedKeyColourSysEx(boardIndex, cmd, keyIndex, red >> 4, red & 0xf, green >> 4, green & 0xf, blue >> 4, blue & 0xf);
+}
+
+juce::MidiMessage LumatoneSysEx::createExtendedMacroColourSysEx(juce::uint8 cmd, juce::uint8 redUpper, juce::uint8 redLower, juce::uint8 greenUpper, juce::uint8 greenLower, juce::uint8 blueUpper, juce::uint8 blueLower)
+{
+    LumatoneSysExFrame frame;
+    fillExtendedMacroColourSysEx(frame, cmd, redUpper, redLower, greenUpper, greenLower, blueUpper, blueLower);
+    return frame.toMidiMessage();
+}
+
+juce::MidiMessage LumatoneSysEx::createExtendedMacroColourSysEx(juce::uint8 cmd, int red, int green, int blue)
+{
+    return createExtendedMacroColourSysEx(cmd, red >> 4, red & 0xf, green >> 4, green & 0xf, blue >> 4, blue & 0xf);
+}
+
+juce::MidiMessage LumatoneSysEx::createTableSysEx(juce::uint8 boardIndex, juce::uint8 cmd, juce::uint8 tableSize, const juce::uint8 table[])
+{
+    LumatoneSysExFrame frame;
+    fillTableSysEx(frame, boardIndex, cmd, tableSize, table);
+    return frame.toMidiMessage();
+}
+
+//============================================================================
+
+void LumatoneSysEx::fillTerpstraSysEx(LumatoneSysExFrame& frame, juce::uint8 boardIndex, juce::uint8 cmd, juce::uint8 data1, juce::uint8 data2, juce::uint8 data3, juce::uint8 data4)
+{
+    auto sysExData = frame.prepare(9);
     fillManufacturerId(sysExData);
     sysExData[3] = boardIndex;
     sysExData[4] = cmd;
@@ -17,15 +58,11 @@ juce::MidiMessage LumatoneSysEx::createTerpstraSysEx(juce::uint8 boardIndex, juc
     sysExData[6] = data2;
     sysExData[7] = data3;
     sysExData[8] = data4;
-
-    juce::MidiMessage msg = juce::MidiMessage::createSysExMessage(sysExData, 9);
-    return msg;
 }
 
-// Create a SysEx message to send 8-bit color precision
-juce::MidiMessage LumatoneSysEx::createExtendedKeyColourSysEx(juce::uint8 boardIndex, juce::uint8 cmd, juce::uint8 keyIndex, juce::uint8 redUpper, juce::uint8 redLower, juce::uint8 greenUpper, juce::uint8 greenLower, juce::uint8 blueUpper, juce::uint8 blueLower)
+void LumatoneSysEx::fillExtendedKeyColourSysEx(LumatoneSysExFrame& frame, juce::uint8 boardIndex, juce::uint8 cmd, juce::uint8 keyIndex, juce::uint8 redUpper, juce::uint8 redLower, juce::uint8 greenUpper, juce::uint8 greenLower, juce::uint8 blueUpper, juce::uint8 blueLower)
 {
-    unsigned char sysExData[12];
+    auto sysExData = frame.prepare(12);
     fillManufacturerId(sysExData);
     sysExData[3] = boardIndex;
     sysExData[4] = cmd;
@@ -36,18 +73,16 @@ juce::MidiMessage LumatoneSysEx::createExtendedKeyColourSysEx(juce::uint8 boardI
     sysExData[9] = greenLower;
     sysExData[10] = blueUpper;
     sysExData[11] = blueLower;
-
-    juce::MidiMessage msg = juce::MidiMessage::createSysExMessage(sysExData, 12);
-    return msg;
 }
-juce::MidiMessage LumatoneSysEx::createExtendedKeyColourSysEx(juce::uint8 boardIndex, juce::uint8 cmd, juce::uint8 keyIndex, int red, int green, int blue)
+
+void LumatoneSysEx::fillExtendedKeyColourSysEx(LumatoneSysExFrame& frame, juce::uint8 boardIndex, juce::uint8 cmd, juce::uint8 keyIndex, int red, int green, int blue)
 {
-    return createExtendedKeyColourSysEx(boardIndex, cmd, keyIndex, red >> 4, red & 0xf, green >> 4, green & 0xf, blue >> 4, blue & 0xf);
+    fillExtendedKeyColourSysEx(frame, boardIndex, cmd, keyIndex, red >> 4, red & 0xf, green >> 4, green & 0xf, blue >> 4, blue & 0xf);
 }
 
-juce::MidiMessage LumatoneSysEx::createExtendedMacroColourSysEx(juce::uint8 cmd, juce::uint8 redUpper, juce::uint8 redLower, juce::uint8 greenUpper, juce::uint8 greenLower, juce::uint8 blueUpper, juce::uint8 blueLower)
+void LumatoneSysEx::fillExtendedMacroColourSysEx(LumatoneSysExFrame& frame, juce::uint8 cmd, juce::uint8 redUpper, juce::uint8 redLower, juce::uint8 greenUpper, juce::uint8 greenLower, juce::uint8 blueUpper, juce::uint8 blueLower)
 {
-    unsigned char sysExData[11];
+    auto sysExData = frame.prepare(11);
     fillManufacturerId(sysExData);
     sysExData[3] = 0;
     sysExData[4] = cmd;
@@ -57,23 +92,18 @@ juce::MidiMessage LumatoneSysEx::createExtendedMacroColourSysEx(juce::uint8 cmd,
     sysExData[8] = greenLower;
     sysExData[9] = blueUpper;
     sysExData[10] = blueLower;
-
-    juce::MidiMessage msg = juce::MidiMessage::createSysExMessage(sysExData, 11);
-    return msg;
 }
 
-juce::MidiMessage LumatoneSysEx::createExtendedMacroColourSysEx(juce::uint8 cmd, int red, int green, int blue)
+void LumatoneSysEx::fillExtendedMacroColourSysEx(LumatoneSysExFrame& frame, juce::uint8 cmd, int red, int green, int blue)
 {
-    return createExtendedMacroColourSysEx(cmd, red >> 4, red & 0xf, green >> 4, green & 0xf, blue >> 4, blue & 0xf);
+    fillExtendedMacroColourSysEx(frame, cmd, red >> 4, red & 0xf, green >> 4, green & 0xf, blue >> 4, blue & 0xf);
 }
 
-juce::MidiMessage LumatoneSysEx::createTableSysEx(juce::uint8 boardIndex, juce::uint8 cmd, juce::uint8 tableSize, const juce::uint8 table[])
+void LumatoneSysEx::fillTableSysEx(LumatoneSysExFrame& frame, juce::uint8 boardIndex, juce::uint8 cmd, int tableSize, const juce::uint8 table[])
 {
-    size_t msgSize = tableSize + 5;
-    juce::Array<unsigned char> dataArray;
-    dataArray.resize(msgSize);
+    jassert(tableSize <= LumatoneSysExFrame::maxPayloadSize);
 
-    auto sysExData = dataArray.getRawDataPointer();
+    auto sysExData = frame.prepare(LumatoneSysExFrame::headerSize + tableSize);
     fillManufacturerId(sysExData);
 
     sysExData[3] = '\0';
@@ -85,9 +115,6 @@ juce::MidiMessage LumatoneSysEx::createTableSysEx(juce::uint8 boardIndex, juce::
     for (int i = 0; i < tableSize; i++)
         jassert(table[i] <= 0x7f);
 #endif
-
-    auto msg = juce::MidiMessage::createSysExMessage(sysExData, msgSize);
-    return msg;
 }
 
 
@@ -185,28 +212,31 @@ FirmwareSupport::Error LumatoneSysEx::unpack12BitDataFrom4Bit(const juce::MidiMe
 
     return unpackIfValid(msg, numBytes, unpack);
 }
+static bool sysExHeadersMatch(const juce::uint8* answerSysExData, const juce::uint8* originalSysExData)
+{
+    // Manufacturer Id, board index, command coincide?
+    return answerSysExData[0] == originalSysExData[0]
+        && answerSysExData[1] == originalSysExData[1]
+        && answerSysExData[2] == originalSysExData[2]
+        && answerSysExData[3] == originalSysExData[3]
+        && answerSysExData[4] == originalSysExData[4];
+}
+
 bool LumatoneSysEx::messageIsResponseToMessage(const juce::MidiMessage& answer, const juce::MidiMessage& originalMessage)
 {
     // Only for SysEx messages
     if (answer.isSysEx() != originalMessage.isSysEx())
         return false;
 
-    auto answerSysExData = answer.getSysExData();
-    auto originalSysExData = originalMessage.getSysExData();
+    return sysExHeadersMatch(answer.getSysExData(), originalMessage.getSysExData());
+}
 
-    // Manufacturer Id, board index, command coincide?
-    if (answerSysExData[0] != originalSysExData[0] ||
-        answerSysExData[1] != originalSysExData[1] ||
-        answerSysExData[2] != originalSysExData[2] ||
-        answerSysExData[3] != originalSysExData[3] ||
-        answerSysExData[4] != originalSysExData[4])
-    {
+bool LumatoneSysEx::messageIsResponseToMessage(const juce::MidiMessage& answer, const LumatoneSysExFrame& originalFrame)
+{
+    if (!answer.isSysEx())
         return false;
-    }
-    else
-    {
-        return true;
-    }
+
+    return sysExHeadersMatch(answer.getSysExData(), originalFrame.getSysExData());
 }
 
 FirmwareSupport::Error LumatoneSysEx::messageIsValidLumatoneResponse(const juce::MidiMessage& midiMessage)
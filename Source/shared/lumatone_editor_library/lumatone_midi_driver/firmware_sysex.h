@@ -13,6 +13,7 @@
 
 #include <JuceHeader.h>
 #include "firmware_support.h"
+#include "sysex_frame.h"
 
 struct LumatoneSysEx
 {
@@ -34,6 +35,19 @@ static juce::MidiMessage createExtendedMacroColourSysEx(juce::uint8 cmd, int red
 // Create a SysEx message encoding a table with a defined size
 static juce::MidiMessage createTableSysEx(juce::uint8 boardIndex, juce::uint8 cmd, juce::uint8 tableSize, const juce::uint8 table[]);
 
+//============================================================================
+// Frame versions of the above, for pooled sending without juce::MidiMessage allocations
+
+static void fillTerpstraSysEx(LumatoneSysExFrame& frame, juce::uint8 boardIndex, juce::uint8 cmd, juce::uint8 data1, juce::uint8 data2, juce::uint8 data3, juce::uint8 data4);
+
+static void fillExtendedKeyColourSysEx(LumatoneSysExFrame& frame, juce::uint8 boardIndex, juce::uint8 cmd, juce::uint8 keyIndex, juce::uint8 redUpper, juce::uint8 redLower, juce::uint8 greenUpper, juce::uint8 greenLower, juce::uint8 blueUpper, juce::uint8 blueLower);
+static void fillExtendedKeyColourSysEx(LumatoneSysExFrame& frame, juce::uint8 boardIndex, juce::uint8 cmd, juce::uint8 keyIndex, int red, int green, int blue);
+
+static void fillExtendedMacroColourSysEx(LumatoneSysExFrame& frame, juce::uint8 cmd, juce::uint8 redUpper, juce::uint8 redLower, juce::uint8 greenUpper, juce::uint8 greenLower, juce::uint8 blueUpper, juce::uint8 blueLower);
+static void fillExtendedMacroColourSysEx(LumatoneSysExFrame& frame, juce::uint8 cmd, int red, int green, int blue);
+
+static void fillTableSysEx(LumatoneSysExFrame& frame, juce::uint8 boardIndex, juce::uint8 cmd, int tableSize, const juce::uint8 table[]);
+
 
 // Checks if message is a valid Lumatone firmware response and is expected length, then runs supplied unpacking function or returns an error code 
 static FirmwareSupport::Error unpackIfValid(const juce::MidiMessage& response, size_t numBytes, std::function<FirmwareSupport::Error(const juce::uint8*)> unpackFunction);
@@ -159,6 +173,7 @@ static FirmwareSupport::Error unpackGetExpressionPedalSensitivityResponse(const
 
 // Message is an answer to a sent message yes/no
 static bool messageIsResponseToMessage(const juce::MidiMessage& answer, const juce::MidiMessage& originalMessage);
+static bool messageIsResponseToMessage(const juce::MidiMessage& answer, const LumatoneSysExFrame& originalFrame);
 };
 
 #endif
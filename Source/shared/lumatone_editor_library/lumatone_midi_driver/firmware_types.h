@@ -39,6 +39,25 @@ enum class ReleaseVersion
 };
 
 
+// Send queue lanes of LumatoneFirmwareDriver, in order of precedence
+enum class SendPriority
+{
+	Control = 0,    // Pings and read-back requests
+	Interactive,    // Configuration writes and user edits
+	Bulk,           // Animation and other high volume key updates
+	NumLanes
+};
+
+// Snapshot of LumatoneFirmwareDriver send queue activity
+struct SendStatistics
+{
+	int queueSize = 0;                   // Frames waiting to be sent, all lanes
+	juce::int64 messagesRetired = 0;     // Frames that got a final (non-busy) answer or timed out
+	juce::int64 keyUpdatesAcknowledged = 0; // Key function and colour frames acknowledged by the device
+	juce::int64 busyAnswers = 0;         // Answers asking for the frame to be resent later
+	juce::int64 timeouts = 0;            // Frames that got no answer
+};
+
 struct PeripheralChannelSettings
 {
 	int pitchWheel = 1;
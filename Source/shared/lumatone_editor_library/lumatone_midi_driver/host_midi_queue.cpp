@@ -0,0 +1,98 @@
+/*
+  ==============================================================================
+
+    host_midi_queue.cpp
+    Created: 19 Oct 2026
+    Author:  Vincenzo
+
+  ==============================================================================
+*/
+
+#include "host_midi_queue.h"
+
+LumatoneHostMidiQueue::LumatoneHostMidiQueue()
+{
+    queue.ensureSize(queueReserveBytes);
+    scheduledQueue.ensureStorageAllocated(scheduledQueueReserveSize);
+}
+
+void LumatoneHostMidiQueue::addMessage(const juce::MidiMessage& msg)
+{
+    juce::ScopedLock l(lock);
+    queue.addEvent(msg, queueSize++);
+}
+
+void LumatoneHostMidiQueue::addMessage(const juce::uint8* data, int numBytes)
+{
+    juce::ScopedLock l(lock);
+    queue.addEvent(data, numBytes, queueSize++);
+}
+
+void LumatoneHostMidiQueue::addMessageAt(const juce::MidiMessage& msg, double timeMs)
+{
+    juce::ScopedLock l(lock);
+
+    // Usually scheduled in order, so search from the end
+    int index = scheduledQueue.size();
+    while (index > 0 && scheduledQueue.getReference(index - 1).timeMs > timeMs)
+        index--;
+
+    scheduledQueue.insert(index, { timeMs, msg });
+}
+
+void LumatoneHostMidiQueue::readNextBuffer(juce::MidiBuffer& nextBuffer, int numSamples, double sampleRate)
+{
+    juce::ScopedTryLock l(lock);
+    if (!l.isLocked())
+        return;
+
+    if (queueSize > 0)
+    {
+        // Keeps both buffers' storage when there's nothing to merge with
+        if (nextBuffer.isEmpty())
+        {
+            nextBuffer.swapWith(queue);
+        }
+        else
+        {
+            nextBuffer.addEvents(queue, 0, -1, 0);
+        }
+
+        queue.clear();
+        queueSize = 0;
+    }
+
+    if (scheduledQueue.isEmpty())
+        return;
+
+    const double blockStartMs = juce::Time::getMillisecondCounterHiRes();
+    const bool hasBlockLength = numSamples > 0 && sampleRate > 0;
+    const double samplesPerMs = hasBlockLength ? sampleRate / 1000.0 : 0.0;
+    const double blockEndMs = hasBlockLength ? blockStartMs + numSamples / samplesPerMs : blockStartMs;
+
+    int numDue = 0;
+    for (const auto& scheduled : scheduledQueue)
+    {
+        if (hasBlockLength ? scheduled.timeMs >= blockEndMs : scheduled.timeMs > blockEndMs)
+            break;
+
+        // Late messages go at the start of the block
+        const int sampleOffset = hasBlockLength
+                               ? juce::jlimit(0, numSamples - 1, juce::roundToInt((scheduled.timeMs - blockStartMs) * samplesPerMs))
+                               : 0;
+
+        nextBuffer.addEvent(scheduled.message, sampleOffset);
+        numDue++;
+    }
+
+    scheduledQueue.removeRange(0, numDue);
+}
+
+void LumatoneHostMidiQueue::clear()
+{
+    juce::ScopedLock l(lock);
+
+    queue.clear();
+    queueSize = 0;
+    scheduledQueue.clearQuick();
+}
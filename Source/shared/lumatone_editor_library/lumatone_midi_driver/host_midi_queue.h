@@ -0,0 +1,64 @@
+/*
+  ==============================================================================
+
+    host_midi_queue.h
+    Created: 19 Oct 2026
+    Author:  Vincenzo
+
+  ==============================================================================
+*/
+
+#ifndef LUMATONE_HOST_MIDI_QUEUE_H
+#define LUMATONE_HOST_MIDI_QUEUE_H
+
+#include <JuceHeader.h>
+
+/*
+==============================================================================
+Plugin mode MIDI waiting for the host's next audio callback.
+
+Messages are either sent in the next block, in the order they were added,
+or scheduled at a juce::Time::getMillisecondCounterHiRes() time and placed
+in the block that covers it.
+
+Messages can be added from any thread. Reading never blocks, so the audio
+callback skips the queue for a block if another thread holds it.
+==============================================================================
+*/
+class LumatoneHostMidiQueue
+{
+public:
+    LumatoneHostMidiQueue();
+
+    void addMessage(const juce::MidiMessage& msg);
+    void addMessage(const juce::uint8* data, int numBytes);
+    void addMessageAt(const juce::MidiMessage& msg, double timeMs);
+
+    // Adds the messages to send in a block of numSamples that starts now to the buffer.
+    // Scheduled messages are placed at the sample offset of their time, or at 0 if numSamples is 0.
+    void readNextBuffer(juce::MidiBuffer& nextBuffer, int numSamples=0, double sampleRate=0.0);
+
+    void clear();
+
+private:
+    juce::CriticalSection lock;
+
+    juce::MidiBuffer queue;
+    int queueSize = 0;
+
+    struct ScheduledMessage
+    {
+        double timeMs;
+        juce::MidiMessage message;
+    };
+
+    // Sorted by time
+    juce::Array<ScheduledMessage> scheduledQueue;
+
+    static constexpr int queueReserveBytes = 8192;
+    static constexpr int scheduledQueueReserveSize = 512;
+
+    JUCE_DECLARE_NON_COPYABLE(LumatoneHostMidiQueue)
+};
+
+#endif // LUMATONE_HOST_MIDI_QUEUE_H
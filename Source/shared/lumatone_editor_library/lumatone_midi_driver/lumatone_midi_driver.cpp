@@ -15,20 +15,29 @@
 #include "./firmware_sysex.h"
 #include "./firmware_driver_listener.h"
 
+#include "../../debug/LumatoneSandboxLogMacros.h"
+
 // There are different race-condition issues between macOS and Windows. 
 // This Driver may need to be redesigned, but for now this define is
 // used for including a juce::MessageManagerLock on Windows & Linux, but not on macOS.
 
 #define MIDI_DRIVER_USE_LOCK JUCE_WINDOWS //|| JUCE_LINUX
 
+static const LumatoneSandboxLogger driverLog("LumatoneFirmwareDriver");
+
 LumatoneFirmwareDriver::LumatoneFirmwareDriver(HostMode hostModeIn, int numBoardsIn)
     : hostMode(hostModeIn)
+    , framePool(framePoolReserveSize)
+    , sysexQueue(framePool)
     , numBoards(numBoardsIn)
 {
+    incomingData.allocate(incomingFifoSize, true);
+    incomingBuffer.ensureSize(incomingFifoSize);
 }     
 
 LumatoneFirmwareDriver::~LumatoneFirmwareDriver()
 {
+    cancelPendingUpdate();
     listeners.clear();
 }
 
@@ -45,33 +54,85 @@ void LumatoneFirmwareDriver::removeDriverListener(LumatoneFirmwareDriverListener
     listeners.remove(collectorToRemove);
 }
 
-void LumatoneFirmwareDriver::readNextBuffer(juce::MidiBuffer &nextBuffer)
+void LumatoneFirmwareDriver::readNextBuffer(juce::MidiBuffer &nextBuffer, int numSamples, double sampleRate)
 {
-    juce::ScopedTryLock l(hostLock);
-    if (l.isLocked())
-    {
-        nextBuffer.swapWith(hostQueue);
-        hostQueue.clear();
-        hostQueueSize = 0;
-    }
+    nextBuffer.clear();
+    hostQueue.readNextBuffer(nextBuffer, numSamples, sampleRate);
 }
 
 void LumatoneFirmwareDriver::sendMessageNow(const juce::MidiMessage &msg)
 {
+    metrics.messageSent(msg.getRawDataSize());
+
     switch (hostMode)
     {
     case HostMode::Driver:
         HajuMidiDriver::sendMessageNow(msg);
         break;
     case HostMode::Plugin:
+        hostQueue.addMessage(msg);
+        break;
+    }
+}
+
+void LumatoneFirmwareDriver::sendMessageAt(const juce::MidiMessage& msg, double timeMs)
+{
+    metrics.messageSent(msg.getRawDataSize());
+
+    switch (hostMode)
     {
-        juce::ScopedLock l(hostLock);
-        hostQueue.addEvent(msg, hostQueueSize++);
+    case HostMode::Driver:
+        HajuMidiDriver::sendMessageAt(msg, timeMs);
+        break;
+    case HostMode::Plugin:
+        hostQueue.addMessageAt(msg, timeMs);
+        break;
     }
-    break;
+}
+
+void LumatoneFirmwareDriver::sendFrameNow(const LumatoneSysExFrame& frame)
+{
+    metrics.messageSent(frame.getRawDataSize());
+
+    switch (hostMode)
+    {
+    case HostMode::Driver:
+        // juce::MidiOutput only accepts juce::MidiMessage, so this is the one place it gets created
+        HajuMidiDriver::sendMessageNow(frame.toMidiMessage());
+        break;
+    case HostMode::Plugin:
+        hostQueue.addMessage(frame.getRawData(), frame.getRawDataSize());
+        break;
     }
 }
 
+void LumatoneFirmwareDriver::setSendLaneDepthLimit(LumatoneFirmware::SendPriority lane, int maxFrames)
+{
+    juce::ScopedLock l(queueLock);
+    sysexQueue.setDepthLimit(lane, maxFrames);
+}
+
+int LumatoneFirmwareDriver::getSendQueueSize(LumatoneFirmware::SendPriority lane) const
+{
+    juce::ScopedLock l(queueLock);
+    return sysexQueue.size(lane);
+}
+
+LumatoneFirmware::SendStatistics LumatoneFirmwareDriver::getSendStatistics() const
+{
+    LumatoneFirmware::SendStatistics stats;
+    {
+        juce::ScopedLock l(queueLock);
+        stats.queueSize = sysexQueue.size();
+    }
+
+    stats.messagesRetired = numMessagesRetired.load();
+    stats.keyUpdatesAcknowledged = numKeyUpdatesAcknowledged.load();
+    stats.busyAnswers = numBusyAnswers.load();
+    stats.timeouts = numTimeouts.load();
+    return stats;
+}
+
 void LumatoneFirmwareDriver::notifyMessageReceived(juce::MidiInput* source, const juce::MidiMessage& midiMessage)
 {
 // #if MIDI_DRIVER_USE_LOCK
@@ -83,6 +144,11 @@ void LumatoneFirmwareDriver::notifyMessageReceived(juce::MidiInput* source, cons
     listeners.call(&LumatoneFirmwareDriverListener::midiMessageReceived, source, midiMessage);
 }
 
+void LumatoneFirmwareDriver::notifyBufferReceived(juce::MidiInput* source, const juce::MidiBuffer& midiBuffer)
+{
+    listeners.call(&LumatoneFirmwareDriverListener::midiBufferReceived, source, midiBuffer);
+}
+
 void LumatoneFirmwareDriver::notifyMessageSent(juce::MidiOutput* target, const juce::MidiMessage& midiMessage)
 {
     // Currently unused
@@ -97,7 +163,14 @@ void LumatoneFirmwareDriver::notifyMessageSent(juce::MidiOutput* target, const j
 
 void LumatoneFirmwareDriver::notifySendQueueSize()
 {
-    auto size = sysexQueue.size();
+    int size = 0;
+    {
+        juce::ScopedLock l(queueLock);
+        size = sysexQueue.size();
+    }
+
+    metrics.queueSizeChanged(size);
+
     // for (auto collector : listeners) collector->midiSendQueueSize(size);
     listeners.call(&LumatoneFirmwareDriverListener::midiSendQueueSize, size);
 }
@@ -140,9 +213,10 @@ void LumatoneFirmwareDriver::sendKeyLightParameters(juce::uint8 boardIndex, juce
 {
     // DBG("SEND KEY COLOUR REQUESTED " + juce::String(boardIndex) + "," + juce::String(keyIndex));
 
-    juce::MidiMessage msg = LumatoneSysEx::createExtendedKeyColourSysEx(boardIndex, SET_KEY_COLOUR, keyIndex, red, green, blue);
+    auto frame = acquireFrame();
+    LumatoneSysEx::fillExtendedKeyColourSysEx(*frame, boardIndex, SET_KEY_COLOUR, keyIndex, red, green, blue);
 
-    sendMessageWithAcknowledge(msg);
+    sendFrameWithAcknowledge(frame);
 }
 
 // CMD 01h: Send a single key's LED channel intensities, three pairs of 4-bit values for each channel
@@ -158,7 +232,9 @@ void LumatoneFirmwareDriver::sendKeyLightParameters(juce::uint8 boardIndex, juce
     if (blueUpper  > 0xf) blueUpper  &= 0xf;
     if (blueLower  > 0xf) blueLower  &= 0xf;
  
-    juce::MidiMessage msg = LumatoneSysEx::createExtendedKeyColourSysEx(boardIndex, SET_KEY_COLOUR, keyIndex, redUpper, redLower, greenUpper, greenLower, blueUpper, blueLower);
+    auto frame = acquireFrame();
+    LumatoneSysEx::fillExtendedKeyColourSysEx(*frame, boardIndex, SET_KEY_COLOUR, keyIndex, redUpper, redLower, greenUpper, greenLower, blueUpper, blueLower);
+    sendFrameWithAcknowledge(frame);
 }
 
 // CMD 01h: Send a single key's LED channel intensities (pre-version 1.0.11)
@@ -199,15 +275,17 @@ void LumatoneFirmwareDriver::sendInvertFootController(bool value)
 // CMD 05h: Colour for macro button in active state, each value should be in range of 0x0-0xF and represents the upper and lower four bytes of each channel intensity
 void LumatoneFirmwareDriver::sendMacroButtonActiveColour(juce::uint8 red, juce::uint8 green, juce::uint8 blue)
 {
-    juce::MidiMessage msg = LumatoneSysEx::createExtendedMacroColourSysEx(MACROBUTTON_COLOUR_ON, red, green, blue);
-    sendMessageWithAcknowledge(msg);
+    auto frame = acquireFrame();
+    LumatoneSysEx::fillExtendedMacroColourSysEx(*frame, MACROBUTTON_COLOUR_ON, red, green, blue);
+    sendFrameWithAcknowledge(frame);
 }
 
 // CMD 05h: Colour for macro button in active state, 3 pairs for 4-bit values for each LED channel
 void LumatoneFirmwareDriver::sendMacroButtonActiveColour(juce::uint8 redUpper, juce::uint8 redLower, juce::uint8 greenUpper, juce::uint8 greenLower, juce::uint8 blueUpper, juce::uint8 blueLower)
 {
-    juce::MidiMessage msg = LumatoneSysEx::createExtendedMacroColourSysEx(MACROBUTTON_COLOUR_ON, redUpper, redLower, greenUpper, greenLower, blueUpper, blueLower);
-    sendMessageWithAcknowledge(msg);
+    auto frame = acquireFrame();
+    LumatoneSysEx::fillExtendedMacroColourSysEx(*frame, MACROBUTTON_COLOUR_ON, redUpper, redLower, greenUpper, greenLower, blueUpper, blueLower);
+    sendFrameWithAcknowledge(frame);
 }
 
 // CMD 05h: Colour for macro button in active state, each value should be in range of 0x00-0x7F (pre-version 1.0.11)
@@ -223,15 +301,17 @@ void LumatoneFirmwareDriver::sendMacroButtonActiveColour_Version_1_0_0(juce::uin
 // CMD 06h: Colour for macro button in inactive state, each value should be in range of 0x0-0xF and represents the upper and lower four bytes of each channel intensity
 void LumatoneFirmwareDriver::sendMacroButtonInactiveColour(int red, int green, int blue)
 {
-    juce::MidiMessage msg = LumatoneSysEx::createExtendedMacroColourSysEx(MACROBUTTON_COLOUR_OFF, red, green, blue);
-    sendMessageWithAcknowledge(msg);
+    auto frame = acquireFrame();
+    LumatoneSysEx::fillExtendedMacroColourSysEx(*frame, MACROBUTTON_COLOUR_OFF, red, green, blue);
+    sendFrameWithAcknowledge(frame);
 }
 
 // CMD 05h: Colour for macro button in active state, 3 pairs for 4-bit values for each LED channel
 void LumatoneFirmwareDriver::sendMacroButtonInactiveColour(juce::uint8 redUpper, juce::uint8 redLower, juce::uint8 greenUpper, juce::uint8 greenLower, juce::uint8 blueUpper, juce::uint8 blueLower)
 {
-    juce::MidiMessage msg = LumatoneSysEx::createExtendedMacroColourSysEx(MACROBUTTON_COLOUR_OFF, redUpper, redLower, greenUpper, greenLower, blueUpper, blueLower);
-    sendMessageWithAcknowledge(msg);
+    auto frame = acquireFrame();
+    LumatoneSysEx::fillExtendedMacroColourSysEx(*frame, MACROBUTTON_COLOUR_OFF, redUpper, redLower, greenUpper, greenLower, blueUpper, blueLower);
+    sendFrameWithAcknowledge(frame);
 }
 
 // CMD 06h: Colour for macro button in inactive state, each value should be in range of 0x00-0x7F (pre-version 1.0.11)
@@ -260,8 +340,9 @@ void LumatoneFirmwareDriver::sendVelocityConfig(const juce::uint8 velocityTable[
         reversedTable[x] = velocityTable[127 - x] & 0x7f;
     }
 
-    auto msg = LumatoneSysEx::createTableSysEx(0, SET_VELOCITY_CONFIG, 128, reversedTable);
-    sendMessageWithAcknowledge(msg);
+    auto frame = acquireFrame();
+    LumatoneSysEx::fillTableSysEx(*frame, 0, SET_VELOCITY_CONFIG, 128, reversedTable);
+    sendFrameWithAcknowledge(frame);
 }
 
 // CMD 09h: Save velocity config to EEPROM
@@ -279,8 +360,9 @@ void LumatoneFirmwareDriver::resetVelocityConfig()
 // CMD 0Bh: Adjust the internal fader look-up table (128 7-bit values)
 void LumatoneFirmwareDriver::sendFaderConfig(const juce::uint8 faderTable[])
 {
-    juce::MidiMessage msg = LumatoneSysEx::createTableSysEx(0, SET_FADER_CONFIG, 128, faderTable);
-    sendMessageWithAcknowledge(msg);
+    auto frame = acquireFrame();
+    LumatoneSysEx::fillTableSysEx(*frame, 0, SET_FADER_CONFIG, 128, faderTable);
+    sendFrameWithAcknowledge(frame);
 }
 
 // CMD 0Ch: **DEPRECATED** Save the changes made to the fader look-up table
@@ -310,8 +392,9 @@ void LumatoneFirmwareDriver::sendCalibrateAfterTouch()
 // CMD 10h: Adjust the internal aftertouch look-up table (size of 128)
 void LumatoneFirmwareDriver::sendAftertouchConfig(const juce::uint8 aftertouchTable[])
 {
-    juce::MidiMessage msg = LumatoneSysEx::createTableSysEx(0, SET_AFTERTOUCH_CONFIG, 128, aftertouchTable);
-    sendMessageWithAcknowledge(msg);
+    auto frame = acquireFrame();
+    LumatoneSysEx::fillTableSysEx(*frame, 0, SET_AFTERTOUCH_CONFIG, 128, aftertouchTable);
+    sendFrameWithAcknowledge(frame);
 }
 
 // CMD 11h: **DEPRECATED** Save the changes made to the aftertouch look-up table
@@ -417,8 +500,9 @@ void LumatoneFirmwareDriver::sendVelocityIntervalConfig(const int velocityInterv
         formattedTable[1 + 2*i] = velocityIntervalTable[i] & 0x3f;
     }
 
-	juce::MidiMessage msg = LumatoneSysEx::createTableSysEx(0, SET_VELOCITY_INTERVALS, payloadSize, formattedTable);
-	sendMessageWithAcknowledge(msg);
+	auto frame = acquireFrame();
+	LumatoneSysEx::fillTableSysEx(*frame, 0, SET_VELOCITY_INTERVALS, payloadSize, formattedTable);
+	sendFrameWithAcknowledge(frame);
 }
 
 // CMD 21h: Sead back the velocity interval table
@@ -515,8 +599,9 @@ void LumatoneFirmwareDriver::setAftertouchKeySensitivity(juce::uint8 boardIndex,
 // CMD 2Dh: Adjust the Lumatouch table, a 128 byte array with value of 127 being a key fully pressed
 void LumatoneFirmwareDriver::setLumatouchConfig(const juce::uint8 lumatouchTable[])
 {
-    juce::MidiMessage msg = LumatoneSysEx::createTableSysEx(0, SET_LUMATOUCH_CONFIG, 128, lumatouchTable);
-    sendMessageWithAcknowledge(msg);
+    auto frame = acquireFrame();
+    LumatoneSysEx::fillTableSysEx(*frame, 0, SET_LUMATOUCH_CONFIG, 128, lumatouchTable);
+    sendFrameWithAcknowledge(frame);
 }
 
 // CMD 2Eh: **DEPRECATED** Save Lumatouch table changes
@@ -757,37 +842,24 @@ void LumatoneFirmwareDriver::sendSysEx(juce::uint8 boardIndex, juce::uint8 cmd,
     }
 
     jassert(boardIndex < 0x6 && data1 <= 0x7f && data2 <= 0x7f && data3 <= 0x7f && data4 <= 0x7f);
-    juce::MidiMessage msg = LumatoneSysEx::createTerpstraSysEx(boardIndex, cmd, data1, data2, data3, data4);
-    sendMessageWithAcknowledge(msg);
+    auto frame = acquireFrame();
+    LumatoneSysEx::fillTerpstraSysEx(*frame, boardIndex, cmd, data1, data2, data3, data4);
+    sendFrameWithAcknowledge(frame);
 }
 
 // Send a SysEx message without parameters
 void LumatoneFirmwareDriver::sendSysExRequest(juce::uint8 boardIndex, juce::uint8 cmd)
 {
-    unsigned char sysExData[9];
-    LumatoneSysEx::fillManufacturerId(sysExData);
-    sysExData[3] = boardIndex;
-    sysExData[4] = cmd;
-    sysExData[5] = '\0';
-    sysExData[6] = '\0';
-    sysExData[7] = '\0';
-    sysExData[8] = '\0';
-    auto msg = juce::MidiMessage::createSysExMessage(sysExData, 9);
-    sendMessageWithAcknowledge(msg);
+    auto frame = acquireFrame();
+    LumatoneSysEx::fillTerpstraSysEx(*frame, boardIndex, cmd, '\0', '\0', '\0', '\0');
+    sendFrameWithAcknowledge(frame);
 }
 
 void LumatoneFirmwareDriver::sendSysExToggle(juce::uint8 boardIndex, juce::uint8 cmd, bool turnStateOn)
 {
-    unsigned char sysExData[9];
-    LumatoneSysEx::fillManufacturerId(sysExData);
-    sysExData[3] = boardIndex;
-    sysExData[4] = cmd;
-    sysExData[5] = turnStateOn;
-    sysExData[6] = '\0';
-    sysExData[7] = '\0';
-    sysExData[8] = '\0';
-    auto msg = juce::MidiMessage::createSysExMessage(sysExData, 9);
-    sendMessageWithAcknowledge(msg);
+    auto frame = acquireFrame();
+    LumatoneSysEx::fillTerpstraSysEx(*frame, boardIndex, cmd, turnStateOn, '\0', '\0', '\0');
+    sendFrameWithAcknowledge(frame);
 }
 
 void LumatoneFirmwareDriver::sendTestMessageNow(int outputDeviceIndex, const juce::MidiMessage &message)
@@ -795,6 +867,7 @@ void LumatoneFirmwareDriver::sendTestMessageNow(int outputDeviceIndex, const juc
     switch (hostMode)
     {
     case HostMode::Driver:
+        metrics.messageSent(message.getRawDataSize());
         HajuMidiDriver::sendTestMessageNow(outputDeviceIndex, message);
         break;
     case HostMode::Plugin:
@@ -803,12 +876,76 @@ void LumatoneFirmwareDriver::sendTestMessageNow(int outputDeviceIndex, const juc
     }
 }
 
-void LumatoneFirmwareDriver::sendMessageWithAcknowledge(const juce::MidiMessage &message)
+LumatoneSysExFrame* LumatoneFirmwareDriver::acquireFrame()
+{
+    juce::ScopedLock l(queueLock);
+    return framePool.acquire();
+}
+
+void LumatoneFirmwareDriver::releaseFrame(LumatoneSysExFrame* frame)
+{
+    juce::ScopedLock l(queueLock);
+    framePool.release(frame);
+}
+
+void LumatoneFirmwareDriver::releaseCurrentFrame()
+{
+    hasMsgWaitingForAck = false;
+    framePool.release(currentFrameWaitingForAck);
+    currentFrameWaitingForAck = nullptr;
+}
+
+LumatoneFirmware::SendPriority LumatoneFirmwareDriver::getPriorityForFrame(const LumatoneSysExFrame& frame) const
+{
+    switch (frame.getSysExData()[CMD_ID])
+    {
+    case CHANGE_KEY_NOTE:
+    case SET_KEY_COLOUR:
+        return keyUpdatePriority;
+
+    case GET_RED_LED_CONFIG:
+    case GET_GREEN_LED_CONFIG:
+    case GET_BLUE_LED_CONFIG:
+    case GET_CHANNEL_CONFIG:
+    case GET_NOTE_CONFIG:
+    case GET_KEYTYPE_CONFIG:
+    case GET_MAX_THRESHOLD:
+    case GET_MIN_THRESHOLD:
+    case GET_AFTERTOUCH_MAX:
+    case GET_KEY_VALIDITY:
+    case GET_VELOCITY_CONFIG:
+    case GET_FADER_CONFIG:
+    case GET_AFTERTOUCH_CONFIG:
+    case GET_VELOCITY_INTERVALS:
+    case GET_FADER_TYPE_CONFIGURATION:
+    case GET_SERIAL_IDENTITY:
+    case GET_LUMATOUCH_CONFIG:
+    case GET_FIRMWARE_REVISION:
+    case LUMA_PING:
+    case GET_BOARD_THRESHOLD_VALUES:
+    case GET_BOARD_SENSITIVITY_VALUES:
+    case GET_PERIPHERAL_CHANNELS:
+    case GET_AFTERTOUCH_TRIGGER_DELAY:
+    case GET_LUMATOUCH_NOTE_OFF_DELAY:
+    case GET_EXPRESSION_PEDAL_THRESHOLD:
+    case GET_PRESET_FLAGS:
+    case GET_EXPRESSION_PEDAL_SENSITIVIY:
+    case GET_MACRO_LIGHT_INTENSITY:
+    case GET_PITCH_AND_MOD_BOUNDS:
+    case GET_EXPRESSION_PEDAL_BOUNDS:
+        return LumatoneFirmware::SendPriority::Control;
+
+    default:
+        return LumatoneFirmware::SendPriority::Interactive;
+    }
+}
+
+void LumatoneFirmwareDriver::sendFrameWithAcknowledge(LumatoneSysExFrame* frame)
 {
     // Prevent certain messages from being sent
-    if (onlySendRequestMessages && message.isSysEx())
+    if (onlySendRequestMessages)
     {
-        auto sysExData = message.getSysExData();
+        auto sysExData = frame->getSysExData();
         if (   sysExData[CMD_ID] == CHANGE_KEY_NOTE
             || sysExData[CMD_ID] == SET_KEY_COLOUR
             || sysExData[CMD_ID] == SET_VELOCITY_CONFIG
@@ -817,24 +954,27 @@ void LumatoneFirmwareDriver::sendMessageWithAcknowledge(const juce::MidiMessage
             || sysExData[CMD_ID] == SET_VELOCITY_INTERVALS
             || sysExData[CMD_ID] == SET_LUMATOUCH_CONFIG)
         {
+            releaseFrame(frame);
             return;
         }
     }
 
     if (hostMode == HostMode::Driver && getMidiInputIndex() < 0)
     {
-        DBG("No juce::MidiInput open to send message to.");
-        // notifyMessageSent(midiOutput, message);
+        LUMATONE_LOG_RATE_LIMITED(DRIVER, WARNING, driverLog, "sendFrameWithAcknowledge", 1, "No juce::MidiInput open to send message to.");
+        releaseFrame(frame);
     }
     else
     {
         // Add message to queue first. The oldest message in queue will be sent.
         {
-            juce::ScopedLock l(sysexQueue.getLock());
-			sysexQueue.add(message);
-            notifySendQueueSize();
+            juce::ScopedLock l(queueLock);
+            frame->timeQueuedMs = juce::Time::getMillisecondCounterHiRes();
+            sysexQueue.push(frame, getPriorityForFrame(*frame));
         }
 
+        notifySendQueueSize();
+
         // If there is no message waiting for acknowledge: send oldest message of queue
        	if (timerType == TimerType::checkQueue || !hasMsgWaitingForAck)
         {
@@ -846,22 +986,27 @@ void LumatoneFirmwareDriver::sendMessageWithAcknowledge(const juce::MidiMessage
 
 void LumatoneFirmwareDriver::sendOldestMessageInQueue()
 {
-    if (sysexQueue.isEmpty())
-        return;
+    LumatoneSysExFrame* oldestFrame = nullptr;
+    {
+        juce::ScopedLock l(queueLock);
+        if (sysexQueue.isEmpty())
+            return;
 
-    // jassert(timerType == TimerType::checkQueue);
-    jassert(!isTimerRunning());
-    jassert(!hasMsgWaitingForAck);
+        // jassert(timerType == TimerType::checkQueue);
+        jassert(!isTimerRunning());
+        jassert(!hasMsgWaitingForAck);
 
-    currentMsgWaitingForAck = sysexQueue[0];     // oldest element in buffer
-    hasMsgWaitingForAck = true;
-    receivedAnswer = false;
+        oldestFrame = sysexQueue.pop();                 // oldest element in buffer
 
-    {
-        juce::ScopedLock l(sysexQueue.getLock());
-        sysexQueue.remove(0);                        // remove from buffer
+        // Swapped in one section so the MIDI input thread never sees a recycled frame
+        releaseCurrentFrame();
+        currentFrameWaitingForAck = oldestFrame;
+        hasMsgWaitingForAck = true;
+        receivedAnswer = false;
     }
-    
+
+    metrics.messageDequeued(juce::Time::getMillisecondCounterHiRes() - oldestFrame->timeQueuedMs);
+
     notifySendQueueSize();
     sendCurrentMessage();
 }
@@ -871,19 +1016,17 @@ void LumatoneFirmwareDriver::sendCurrentMessage()
     jassert(!isTimerRunning());
     jassert(hasMsgWaitingForAck);
 
-// #if JUCE_DEBUG
-//     if (currentMsgWaitingForAck.isSysEx())
-//     {
-//         auto sysExData = currentMsgWaitingForAck.getSysExData();
-//         for (int i = 0; i < currentMsgWaitingForAck.getSysExDataSize(); i++)
-//             jassert(sysExData[i] <= 0x7f);
-//     }
-// #endif
+    {
+        juce::ScopedLock l(queueLock);
+        if (currentFrameWaitingForAck == nullptr)
+            return;
 
-    sendMessageNow(currentMsgWaitingForAck);        // send it
+        currentFrameSentTimeMs = juce::Time::getMillisecondCounterHiRes();
+        sendFrameNow(*currentFrameWaitingForAck);        // send it
 
-    // Notify listeners
-    DBG("SENT: " + currentMsgWaitingForAck.getDescription());
+        // Notify listeners
+        LUMATONE_LOG_RATE_LIMITED(DRIVER, VERBOSE, driverLog, "sendCurrentMessage", 10, "SENT: " + currentFrameWaitingForAck->toMidiMessage().getDescription());
+    }
     // const juce::MessageManagerLock mmLock;
     // this->listeners.call(&Listener::midiMessageSent, currentMsgWaitingForAck);
     // notifyMessageSent(midiOutput, currentMsgWaitingForAck);
@@ -894,26 +1037,103 @@ void LumatoneFirmwareDriver::sendCurrentMessage()
 
 void LumatoneFirmwareDriver::handleIncomingMidiMessage(juce::MidiInput* source, const juce::MidiMessage& message)
 {
-#if JUCE_DEBUG
     if (message.isSysEx())
     {
-        if (source)
-            DBG("RCVD: " + message.getDescription() + "; from " + source->getName());
-        else
-            DBG("RCVD: " + message.getDescription() + "; called by processor");
+        LUMATONE_LOG_RATE_LIMITED(DRIVER, VERBOSE, driverLog, "handleIncomingMidiMessage", 10,
+                                  "RCVD: " + message.getDescription() + (source != nullptr ? "; from " + source->getName() : juce::String("; called by processor")));
     }
-#endif
 
     juce::MessageManager::callAsync([=]() { notifyMessageReceived(source, message); });
 
+    handleAnswerToMessage(source, message);
+}
+
+void LumatoneFirmwareDriver::handleIncomingMidiBuffer(const juce::MidiBuffer& buffer)
+{
+    if (buffer.isEmpty())
+        return;
+
+    for (const auto metadata : buffer)
+    {
+        const auto message = metadata.getMessage();
+        if (message.isSysEx())
+        {
+            LUMATONE_LOG_RATE_LIMITED(DRIVER, VERBOSE, driverLog, "handleIncomingMidiMessage", 10,
+                                      "RCVD: " + message.getDescription() + "; called by processor");
+        }
+
+        handleAnswerToMessage(nullptr, message);
+    }
+
+    // Only this thread writes, so the free space can't shrink before the write
+    const int blockSize = buffer.data.size();
+    const int recordSize = (int)sizeof(blockSize) + blockSize;
+    if (recordSize > incomingFifo.getFreeSpace())
+    {
+        LUMATONE_LOG_RATE_LIMITED(DRIVER, WARNING, driverLog, "handleIncomingMidiBuffer", 1, "Incoming MIDI FIFO full, dropped a block.");
+        return;
+    }
+
+    const auto* header = reinterpret_cast<const juce::uint8*>(&blockSize);
+    const auto* blockData = buffer.data.begin();
+
+    int position = 0;
+    incomingFifo.write(recordSize).forEach([&](int index)
+    {
+        incomingData[index] = position < (int)sizeof(blockSize) ? header[position] : blockData[position - (int)sizeof(blockSize)];
+        position++;
+    });
+
+    triggerAsyncUpdate();
+}
+
+void LumatoneFirmwareDriver::handleAsyncUpdate()
+{
+    while (incomingFifo.getNumReady() > 0)
+    {
+        int blockSize = 0;
+        readIncomingBytes(&blockSize, (int)sizeof(blockSize));
+
+        incomingBuffer.data.resize(blockSize);
+        readIncomingBytes(incomingBuffer.data.getRawDataPointer(), blockSize);
+
+        notifyBufferReceived(nullptr, incomingBuffer);
+        incomingBuffer.clear();
+    }
+}
+
+void LumatoneFirmwareDriver::readIncomingBytes(void* destData, int numBytes)
+{
+    auto* dest = static_cast<juce::uint8*>(destData);
+
+    int position = 0;
+    incomingFifo.read(numBytes).forEach([&](int index) { dest[position++] = incomingData[index]; });
+}
+
+void LumatoneFirmwareDriver::handleAnswerToMessage(juce::MidiInput* source, const juce::MidiMessage& message)
+{
+    metrics.messageReceived(message.getRawDataSize());
+
     if (!hasMsgWaitingForAck)
         return;
 
-    jassert(timerType == TimerType::waitForAnswer);
- 
-    // Check whether received message is an answer to the previously sent one
-    if (LumatoneSysEx::messageIsResponseToMessage(message, currentMsgWaitingForAck))
+    // Check whether received message is an answer to the previously sent one.
+    // The frame is only read under the lock, so the send thread can't recycle it mid-comparison.
+    bool isAnswer = false;
+    juce::uint8 answeredCmd = 0;
+    {
+        juce::ScopedLock l(queueLock);
+        if (currentFrameWaitingForAck == nullptr)
+            return;
+
+        isAnswer = LumatoneSysEx::messageIsResponseToMessage(message, *currentFrameWaitingForAck);
+        answeredCmd = currentFrameWaitingForAck->getSysExData()[CMD_ID];
+    }
+
+    if (isAnswer)
     {
+        jassert(timerType == TimerType::waitForAnswer);
+
         // Answer has come, we can stop the timer
         stopTimer();
         
@@ -922,19 +1142,34 @@ void LumatoneFirmwareDriver::handleIncomingMidiMessage(juce::MidiInput* source,
         // Check answer state (error yes/no)
         auto answerState = message.getSysExData()[MSG_STATUS];
 
+        metrics.answerReceived(juce::Time::getMillisecondCounterHiRes() - currentFrameSentTimeMs,
+                               answerState == LumatoneFirmware::ReturnCode::BUSY);
+
         // if answer state is "busy": resend message after a little delay
         if (answerState == LumatoneFirmware::ReturnCode::BUSY)
         {
+            numBusyAnswers++;
+
             // Start delay timer, after which message will be sent again
             timerType = TimerType::delayWhileDeviceBusy;
-            DBG("Starting Busy Timer");
+            LUMATONE_LOG_RATE_LIMITED(DRIVER, INFO, driverLog, "handleIncomingMidiMessage", 1, "Device busy, resending in " + juce::String(busyTimeDelayInMilliseconds) + "ms.");
             startTimer(busyTimeDelayInMilliseconds);
         }
         else
         {
             // In case of error, NACK: ?
             // For now: Remove from buffer in any case
-            hasMsgWaitingForAck = false;
+            numMessagesRetired++;
+            if (answerState == LumatoneFirmware::ReturnCode::ACK)
+            {
+                if (answeredCmd == CHANGE_KEY_NOTE || answeredCmd == SET_KEY_COLOUR)
+                    numKeyUpdatesAcknowledged++;
+            }
+
+            {
+                juce::ScopedLock l(queueLock);
+                releaseCurrentFrame();
+            }
 
             // If there are more messages waiting in the queue: send the next one
             // timerType = TimerType::checkQueue;
@@ -965,18 +1200,29 @@ void LumatoneFirmwareDriver::timerCallback()
         }
 
         // For now: Remove from buffer, try to send next one
-        hasMsgWaitingForAck = false;
+        juce::MidiMessage unansweredMessage;
+        {
+            juce::ScopedLock l(queueLock);
+            if (currentFrameWaitingForAck != nullptr)
+                unansweredMessage = currentFrameWaitingForAck->toMidiMessage();
+
+            releaseCurrentFrame();
+        }
 
         // No answer came from MIDI input
 		
-        DBG("DRIVER: NO ANSWER");
-        notifyNoAnswerToMessage(getMidiInputInfo(), currentMsgWaitingForAck);
+        LUMATONE_LOG_RATE_LIMITED(DRIVER, WARNING, driverLog, "timerCallback", 2, "No answer to " + unansweredMessage.getDescription());
+        metrics.answerTimedOut();
+        notifyNoAnswerToMessage(getMidiInputInfo(), unansweredMessage);
+        numMessagesRetired++;
+        numTimeouts++;
 
         sendOldestMessageInQueue();
     }
     else if (timerType == TimerType::delayWhileDeviceBusy)
     {
         // Resend current message and start waiting for answer again
+        metrics.messageRetried();
         sendCurrentMessage();
     }
     else if (timerType == TimerType::checkQueue)
@@ -991,17 +1237,14 @@ void LumatoneFirmwareDriver::timerCallback()
 void LumatoneFirmwareDriver::clearMIDIMessageBuffer()
 {
     stopTimer();
-    hasMsgWaitingForAck = false;
 
     {
-        juce::ScopedLock l(sysexQueue.getLock());
+        juce::ScopedLock l(queueLock);
+        releaseCurrentFrame();
         sysexQueue.clear();
     }
 
-    {
-        juce::ScopedLock l(hostLock);
-        hostQueue.clear();
-    }
+    hostQueue.clear();
 
     notifySendQueueSize();
 }
@@ -31,6 +31,9 @@
 
 #include "./midi_driver.h"
 #include "./firmware_driver_listener.h"
+#include "./send_queue.h"
+#include "./connection_metrics.h"
+#include "./host_midi_queue.h"
 
 #define DEFAULT_NUM_BOARDS 5
 
@@ -41,7 +44,7 @@
 Connection to midi, sending SysEx parameters to keyboard
 ==============================================================================
 */
-class LumatoneFirmwareDriver : public HajuMidiDriver, public juce::Timer
+class LumatoneFirmwareDriver : public HajuMidiDriver, public juce::Timer, private juce::AsyncUpdater
 {
 public:
 	enum class HostMode
@@ -70,6 +73,7 @@ public:
 private:
 	// Helper callbacks for notifying Collectors
 	void notifyMessageReceived(juce::MidiInput* source, const juce::MidiMessage& midiMessage);
+	void notifyBufferReceived(juce::MidiInput* source, const juce::MidiBuffer& midiBuffer);
 	void notifyMessageSent(juce::MidiOutput* target, const juce::MidiMessage& midiMessage);
 	void notifySendQueueSize();
 	// void notifyLogMessage(juce::String textMessage, ErrorLevel errorLevel);
@@ -86,15 +90,43 @@ public:
     void addDriverListener(LumatoneFirmwareDriverListener* collectorToAdd);
     void removeDriverListener(LumatoneFirmwareDriverListener* collectorToRemove);
 
-	void readNextBuffer(juce::MidiBuffer& nextBuffer);
+	// Plugin mode, replaces the buffer with the messages to send in a block of numSamples that starts now.
+	// Scheduled messages are placed at the sample offset of their time, or at 0 if numSamples is 0.
+	void readNextBuffer(juce::MidiBuffer& nextBuffer, int numSamples=0, double sampleRate=0.0);
 
 	void restrictToRequestMessages(bool testMessagesOnly) { onlySendRequestMessages = testMessagesOnly; }
 
 	bool isWaitingForResponse() const { return hasMsgWaitingForAck; }
 
+	//============================================================================
+	// Send queue priorities
+
+	// Lane used for key function and key colour messages. Requests and pings always use the control lane,
+	// other configuration messages use the interactive lane.
+	void setKeyUpdatePriority(LumatoneFirmware::SendPriority priority) { keyUpdatePriority = priority; }
+	LumatoneFirmware::SendPriority getKeyUpdatePriority() const { return keyUpdatePriority; }
+
+	// Maximum number of frames waiting in a lane before the oldest are dropped, 0 for unlimited
+	void setSendLaneDepthLimit(LumatoneFirmware::SendPriority lane, int maxFrames);
+
+	// Number of queued frames in one lane
+	int getSendQueueSize(LumatoneFirmware::SendPriority lane) const;
+
+	// Queue size and running totals of answered messages, for throttling senders
+	LumatoneFirmware::SendStatistics getSendStatistics() const;
+
+	// Rolling ack latency, busy rate, timeouts, throughput and queue wait
+	LumatoneConnectionMetrics& getConnectionMetrics() { return metrics; }
+
 	// Low-level send MIDI message in a host dependent way
 	void sendMessageNow(const juce::MidiMessage& msg);
 
+	// Low-level send MIDI message at a juce::Time::getMillisecondCounterHiRes() time in a host dependent way
+	void sendMessageAt(const juce::MidiMessage& msg, double timeMs);
+
+	// Low-level send SysEx frame in a host dependent way
+	void sendFrameNow(const LumatoneSysExFrame& frame);
+
 	//============================================================================
 	// Single (mid-level) commands, firmware specific
 
@@ -348,6 +380,10 @@ public:
 	// MIDI input callback: handle acknowledge messages
 	void handleIncomingMidiMessage(juce::MidiInput* source, const juce::MidiMessage& message) override;
 
+	// Plugin mode, handles a block of host input and passes it to listeners as one buffer on the message thread.
+	// Called from the host's audio thread, blocks that don't fit in the incoming FIFO are dropped.
+	void handleIncomingMidiBuffer(const juce::MidiBuffer& buffer);
+
 	// Handle timeout
 	void timerCallback() override;
 
@@ -359,11 +395,33 @@ public:
 
 private:
 
+	// Checks for an answer to the message waiting for acknowledgement
+	void handleAnswerToMessage(juce::MidiInput* source, const juce::MidiMessage& message);
+
+	// Passes the blocks in the incoming FIFO to listeners
+	void handleAsyncUpdate() override;
+
+	// Reads the next numBytes of a block from the incoming FIFO
+	void readIncomingBytes(void* destData, int numBytes);
+
 	// Send a message now without confirming it's a Lumatone
 	void sendTestMessageNow(int outputDeviceIndex, const juce::MidiMessage& message);
 
-	// Low-level SysEx message sending
-	void sendMessageWithAcknowledge(const juce::MidiMessage& message);
+	// Get an empty frame from the pool, to be passed to sendFrameWithAcknowledge
+	LumatoneSysExFrame* acquireFrame();
+
+	// Return a frame to the pool
+	void releaseFrame(LumatoneSysExFrame* frame);
+
+	// Return the acknowledged or timed out frame to the pool and stop waiting for an answer.
+	// Must be called with queueLock held.
+	void releaseCurrentFrame();
+
+	// Determine which send queue lane a frame belongs in
+	LumatoneFirmware::SendPriority getPriorityForFrame(const LumatoneSysExFrame& frame) const;
+
+	// Low-level SysEx message sending, takes ownership of the frame
+	void sendFrameWithAcknowledge(LumatoneSysExFrame* frame);
 
 	// Send the oldest message in queue and start waiting for answer
 	void sendOldestMessageInQueue();
@@ -389,20 +447,41 @@ private:
 	HostMode hostMode;
 	juce::PluginHostType host;
 
-	juce::CriticalSection hostLock;
-	juce::MidiBuffer hostQueue;
-	int hostQueueSize = 0;
+	// Plugin mode messages waiting for the host
+	LumatoneHostMidiQueue hostQueue;
+
+	// Plugin mode input blocks waiting for the message thread. Each block is written as its
+	// size in bytes followed by the MidiBuffer's data, by the host's audio thread only.
+	static constexpr int incomingFifoSize = 65536;
+	juce::AbstractFifo incomingFifo { incomingFifoSize };
+	juce::HeapBlock<juce::uint8> incomingData;
+
+	// Message thread only, reused for each block read from the FIFO
+	juce::MidiBuffer incomingBuffer;
 
-    juce::MidiMessage currentMsgWaitingForAck;
-	bool hasMsgWaitingForAck = false;
+	// Guards framePool, sysexQueue, and currentFrameWaitingForAck, which is only
+	// read or swapped while holding it since the MIDI input thread matches answers against it
+	juce::CriticalSection queueLock;
 
-	juce::Array<juce::MidiMessage, juce::CriticalSection> sysexQueue;
+	LumatoneSysExFramePool framePool;
+	LumatoneSendQueue sysexQueue;
+
+	LumatoneFirmware::SendPriority keyUpdatePriority = LumatoneFirmware::SendPriority::Interactive;
+
+	LumatoneSysExFrame* currentFrameWaitingForAck = nullptr;
+	std::atomic<bool> hasMsgWaitingForAck { false };
+
+	// juce::Time::getMillisecondCounterHiRes() when the current frame was last sent
+	double currentFrameSentTimeMs = 0.0;
 
 	// Used for device detection and "Offline" mode (no messages that mutate board data)
 	bool      onlySendRequestMessages = false;
 
 	const int numBoards = 0;
 
+	// Enough for a full layout of key function and colour messages
+	static constexpr int framePoolReserveSize = 640;
+
 	const int receiveTimeoutInMilliseconds = 2000;
 	const int busyTimeDelayInMilliseconds = 500;
 	const int checkQueueTimerDelayInMilliseconds = 10;
@@ -410,7 +489,13 @@ private:
 
 	bool receivedAnswer = false; // Debug helper flag
 
-	int verbose = 0;
+	std::atomic<juce::int64> numMessagesRetired { 0 };
+	std::atomic<juce::int64> numKeyUpdatesAcknowledged { 0 };
+	std::atomic<juce::int64> numBusyAnswers { 0 };
+	std::atomic<juce::int64> numTimeouts { 0 };
+
+	LumatoneConnectionMetrics metrics;
+
 };
 
 #endif
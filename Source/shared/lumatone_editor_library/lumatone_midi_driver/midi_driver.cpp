@@ -162,6 +162,9 @@ void HajuMidiDriver::setMidiOutput(int deviceIndex)
         midiOutput = selectedOutput.get();
         lastOutputIndex = deviceIndex;
         lastOutputDevice = midiOutputs[deviceIndex];
+
+        // Used by sendMessageAt
+        midiOutput->startBackgroundThread();
     }
     else
     {
@@ -181,6 +184,20 @@ void HajuMidiDriver::sendMessageNow(const juce::MidiMessage& message)
     DBG("MidiOutput is null!");
 }
 
+void HajuMidiDriver::sendMessageAt(const juce::MidiMessage& message, double millisecondCounterToSendAt)
+{
+	if (midiOutput != nullptr)
+	{
+		// At 1000 samples per second, sample positions are milliseconds after the start time
+		juce::MidiBuffer block;
+		block.addEvent(message, 0);
+		midiOutput->sendBlockOfMessages(block, millisecondCounterToSendAt, 1000.0);
+		return;
+	}
+
+	DBG("MidiOutput is null!");
+}
+
 void HajuMidiDriver::closeMidiInput()
 {
     if (midiInput != nullptr)
@@ -215,14 +232,9 @@ void HajuMidiDriver::openAvailableDevicesForTesting()
     // May be preferable to only close and open input devices when necessary
     closeTestingDevices();
 
+    // Outputs that fail to open keep their slot, so test output indices match the device list
     for (auto device : midiOutputs)
-    {
-        auto newOutput = juce::MidiOutput::openDevice(device.identifier);
-        if (newOutput == nullptr)
-            continue;
-
-        testOutputs.add(newOutput.release());
-    }
+        testOutputs.add(juce::MidiOutput::openDevice(device.identifier).release());
 
     for (auto device : midiInputs)
     {
@@ -238,11 +250,12 @@ void HajuMidiDriver::openAvailableDevicesForTesting()
 void HajuMidiDriver::sendTestMessageNow(int outputDeviceIndex, const juce::MidiMessage& message)
 {
     // Return some error code?
-    if (outputDeviceIndex >= 0 && outputDeviceIndex < testOutputs.size())
+    auto output = testOutputs[outputDeviceIndex];
+    if (output != nullptr)
     {
         //DBG("Sending this message to " + testOutputs[outputDeviceIndex]->getName() + ":");
         DBG("TEST: " + message.getDescription());
-        testOutputs.getUnchecked(outputDeviceIndex)->sendMessageNow(message);
+        output->sendMessageNow(message);
     }
 }
 
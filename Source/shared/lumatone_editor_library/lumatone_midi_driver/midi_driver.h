@@ -67,6 +67,9 @@ public:
 
 	// Send a MIDI message directly
 	virtual void sendMessageNow(const  juce::MidiMessage& message);
+
+	// Send a MIDI message from the output's own thread at a juce::Time::getMillisecondCounterHiRes() time
+	virtual void sendMessageAt(const juce::MidiMessage& message, double millisecondCounterToSendAt);
     
     // Close current input device
     void closeMidiInput();
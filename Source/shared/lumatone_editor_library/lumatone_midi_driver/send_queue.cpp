@@ -0,0 +1,160 @@
+/*
+  ==============================================================================
+
+    send_queue.cpp
+    Created: 19 Oct 2026
+    Author:  Vincenzo
+
+  ==============================================================================
+*/
+
+#include "send_queue.h"
+
+LumatoneSendQueue::LumatoneSendQueue(LumatoneSysExFramePool& framePool)
+    : pool(framePool)
+{
+    // Coalescing bounds bulk key frames to one of each type per key, so this only limits other bulk commands
+    setDepthLimit(SendPriority::Bulk, numKeyFrameIndices);
+}
+
+int LumatoneSendQueue::getKeyFrameIndex(const LumatoneSysExFrame& frame)
+{
+    if (frame.getSysExDataSize() < PAYLOAD_INIT)
+        return -1;
+
+    auto sysExData = frame.getSysExData();
+
+    int typeOffset = 0;
+    switch (sysExData[CMD_ID])
+    {
+    case CHANGE_KEY_NOTE:
+        typeOffset = 0;
+        break;
+    case SET_KEY_COLOUR:
+        typeOffset = maxBoardIds * maxKeysPerBoard;
+        break;
+    default:
+        return -1;
+    }
+
+    int boardId = sysExData[BOARD_IND];
+    int keyIndex = sysExData[CMD_ID + 1];
+    if (boardId >= maxBoardIds || keyIndex >= maxKeysPerBoard)
+        return -1;
+
+    return typeOffset + boardId * maxKeysPerBoard + keyIndex;
+}
+
+void LumatoneSendQueue::push(LumatoneSysExFrame* frame, SendPriority lane)
+{
+    jassert(frame != nullptr && !frame->isEmpty());
+    const int laneIndex = (int)lane;
+
+    const int keyFrameIndex = getKeyFrameIndex(*frame);
+    if (keyFrameIndex >= 0)
+    {
+        auto& pending = pendingKeyFrames[keyFrameIndex];
+        if (pending.frame != nullptr)
+        {
+            numCoalesced++;
+
+            if (pending.laneIndex <= laneIndex)
+            {
+                // Overwrite the stale update in place so it keeps its position and priority
+                memcpy(pending.frame->bytes, frame->bytes, (size_t)frame->rawSize);
+                pending.frame->rawSize = frame->rawSize;
+                pool.release(frame);
+                return;
+            }
+
+            // The stale update could be sent after this one from its slower lane
+            pending.frame->clear();
+            numCancelled[pending.laneIndex]++;
+        }
+
+        pending.frame = frame;
+        pending.laneIndex = laneIndex;
+    }
+
+    lanes[laneIndex].push(frame);
+
+    const int limit = depthLimit[laneIndex];
+    while (limit > 0 && size(lane) > limit)
+        dropOldest(laneIndex);
+}
+
+LumatoneSysExFrame* LumatoneSendQueue::popLane(int laneIndex)
+{
+    while (auto frame = lanes[laneIndex].pop())
+    {
+        if (frame->isEmpty())
+        {
+            numCancelled[laneIndex]--;
+            pool.release(frame);
+            continue;
+        }
+
+        const int keyFrameIndex = getKeyFrameIndex(*frame);
+        if (keyFrameIndex >= 0 && pendingKeyFrames[keyFrameIndex].frame == frame)
+            pendingKeyFrames[keyFrameIndex].frame = nullptr;
+
+        return frame;
+    }
+
+    return nullptr;
+}
+
+LumatoneSysExFrame* LumatoneSendQueue::pop()
+{
+    if (auto frame = popLane((int)SendPriority::Control))
+        return frame;
+
+    const bool bulkWaiting = size(SendPriority::Bulk) > 0;
+    if (!bulkWaiting || interactiveSentInARow < interactiveWeight)
+    {
+        if (auto frame = popLane((int)SendPriority::Interactive))
+        {
+            interactiveSentInARow++;
+            return frame;
+        }
+    }
+
+    interactiveSentInARow = 0;
+
+    if (auto frame = popLane((int)SendPriority::Bulk))
+        return frame;
+
+    return popLane((int)SendPriority::Interactive);
+}
+
+void LumatoneSendQueue::dropOldest(int laneIndex)
+{
+    auto frame = popLane(laneIndex);
+    if (frame == nullptr)
+        return;
+
+    pool.release(frame);
+    numDropped++;
+}
+
+void LumatoneSendQueue::clear()
+{
+    for (int i = 0; i < numLanes; i++)
+    {
+        lanes[i].clear(pool);
+        numCancelled[i] = 0;
+    }
+
+    for (auto& pending : pendingKeyFrames)
+        pending.frame = nullptr;
+
+    interactiveSentInARow = 0;
+}
+
+int LumatoneSendQueue::size() const
+{
+    int total = 0;
+    for (int i = 0; i < numLanes; i++)
+        total += size((SendPriority)i);
+    return total;
+}
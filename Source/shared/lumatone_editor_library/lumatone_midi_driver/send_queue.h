@@ -0,0 +1,102 @@
+/*
+  ==============================================================================
+
+    send_queue.h
+    Created: 19 Oct 2026
+    Author:  Vincenzo
+
+  ==============================================================================
+*/
+
+#ifndef LUMATONE_SEND_QUEUE_H
+#define LUMATONE_SEND_QUEUE_H
+
+#include "firmware_types.h"
+#include "sysex_frame.h"
+
+/*
+==============================================================================
+Prioritised queue of outgoing SysEx frames.
+
+Control frames are always sent first. Interactive and bulk frames are
+weighted so that bulk traffic keeps moving while edits jump ahead of it.
+
+Key function and key colour frames are coalesced per key across all lanes,
+so at most one update of each type per key is waiting. A newer update is
+merged into a pending one in the same or a higher priority lane, keeping its
+position, and cancels a pending one in a lower priority lane. Lanes are
+drained out of order, so this keeps the newest update from being sent
+before a stale one.
+
+Not thread safe on its own.
+==============================================================================
+*/
+class LumatoneSendQueue
+{
+public:
+    using SendPriority = LumatoneFirmware::SendPriority;
+    static constexpr int numLanes = (int)SendPriority::NumLanes;
+
+    LumatoneSendQueue(LumatoneSysExFramePool& framePool);
+
+    // Takes ownership of the frame
+    void push(LumatoneSysExFrame* frame, SendPriority lane);
+
+    // Returns the next frame to send, or nullptr if empty. Caller takes ownership.
+    LumatoneSysExFrame* pop();
+
+    // Returns all queued frames to the pool
+    void clear();
+
+    bool isEmpty() const { return size() == 0; }
+    int size() const;
+    int size(SendPriority lane) const { return lanes[(int)lane].size() - numCancelled[(int)lane]; }
+
+    // Maximum number of queued frames in a lane, the oldest ones are dropped beyond this. 0 means unlimited.
+    void setDepthLimit(SendPriority lane, int maxFrames) { depthLimit[(int)lane] = maxFrames; }
+    int getDepthLimit(SendPriority lane) const { return depthLimit[(int)lane]; }
+
+    // Number of interactive frames sent before a waiting bulk frame gets a turn
+    void setInteractiveWeight(int numFrames) { interactiveWeight = juce::jmax(1, numFrames); }
+
+    int getNumCoalesced() const { return numCoalesced; }
+    int getNumDropped() const { return numDropped; }
+
+private:
+    // Returns an index for key function or key colour frames, or -1 for other commands
+    static int getKeyFrameIndex(const LumatoneSysExFrame& frame);
+
+    LumatoneSysExFrame* popLane(int laneIndex);
+
+    void dropOldest(int laneIndex);
+
+private:
+    static constexpr int maxBoardIds = BOARD_OCT_5 + 1;
+    static constexpr int maxKeysPerBoard = 56;
+    static constexpr int numKeyFrameIndices = 2 * maxBoardIds * maxKeysPerBoard;
+
+    LumatoneSysExFramePool& pool;
+
+    LumatoneSysExFrameQueue lanes[numLanes];
+    int numCancelled[numLanes] = { 0 };
+    int depthLimit[numLanes] = { 0 };
+
+    struct PendingKeyFrame
+    {
+        LumatoneSysExFrame* frame = nullptr;
+        int laneIndex = 0;
+    };
+
+    // Key frames still waiting in any lane, indexed by getKeyFrameIndex
+    PendingKeyFrame pendingKeyFrames[numKeyFrameIndices];
+
+    int interactiveWeight = 4;
+    int interactiveSentInARow = 0;
+
+    int numCoalesced = 0;
+    int numDropped = 0;
+
+    JUCE_DECLARE_NON_COPYABLE(LumatoneSendQueue)
+};
+
+#endif // LUMATONE_SEND_QUEUE_H
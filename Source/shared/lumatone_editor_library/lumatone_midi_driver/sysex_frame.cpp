@@ -0,0 +1,85 @@
+/*
+  ==============================================================================
+
+    sysex_frame.cpp
+    Created: 19 Oct 2026
+    Author:  Vincenzo
+
+  ==============================================================================
+*/
+
+#include "sysex_frame.h"
+
+LumatoneSysExFramePool::LumatoneSysExFramePool(int numFramesToReserve)
+{
+    while (getNumFramesAllocated() < numFramesToReserve)
+        allocateBlock();
+}
+
+LumatoneSysExFrame* LumatoneSysExFramePool::acquire()
+{
+    if (freeList == nullptr)
+        allocateBlock();
+
+    auto frame = freeList;
+    freeList = frame->next;
+    numFree--;
+
+    frame->next = nullptr;
+    frame->rawSize = 0;
+    return frame;
+}
+
+void LumatoneSysExFramePool::release(LumatoneSysExFrame* frame)
+{
+    if (frame == nullptr)
+        return;
+
+    frame->next = freeList;
+    freeList = frame;
+    numFree++;
+}
+
+void LumatoneSysExFramePool::allocateBlock()
+{
+    auto block = blocks.add(new Block());
+    for (auto& frame : block->frames)
+        release(&frame);
+}
+
+//==============================================================================
+
+void LumatoneSysExFrameQueue::push(LumatoneSysExFrame* frame)
+{
+    jassert(frame != nullptr);
+    frame->next = nullptr;
+
+    if (tail == nullptr)
+        head = frame;
+    else
+        tail->next = frame;
+
+    tail = frame;
+    numFrames++;
+}
+
+LumatoneSysExFrame* LumatoneSysExFrameQueue::pop()
+{
+    auto frame = head;
+    if (frame == nullptr)
+        return nullptr;
+
+    head = frame->next;
+    if (head == nullptr)
+        tail = nullptr;
+
+    frame->next = nullptr;
+    numFrames--;
+    return frame;
+}
+
+void LumatoneSysExFrameQueue::clear(LumatoneSysExFramePool& pool)
+{
+    while (auto frame = pop())
+        pool.release(frame);
+}
@@ -0,0 +1,128 @@
+/*
+  ==============================================================================
+
+    sysex_frame.h
+    Created: 19 Oct 2026
+    Author:  Vincenzo
+
+  ==============================================================================
+*/
+
+#ifndef LUMATONE_SYSEX_FRAME_H
+#define LUMATONE_SYSEX_FRAME_H
+
+#include <JuceHeader.h>
+
+/*
+==============================================================================
+Fixed-size SysEx message storage for outgoing firmware commands.
+
+The raw bytes include the 0xF0 / 0xF7 framing so they can be handed to a
+juce::MidiBuffer or a juce::MidiOutput without reformatting.
+==============================================================================
+*/
+struct LumatoneSysExFrame
+{
+    // Manufacturer ID (3), board index, command byte
+    static constexpr int headerSize = 5;
+
+    // Largest outgoing payload is the velocity interval table (CMD 20h), 127 12-bit values in 254 bytes
+    static constexpr int maxPayloadSize = 254;
+
+    static constexpr int maxSysExDataSize = headerSize + maxPayloadSize;
+    static constexpr int maxRawSize = maxSysExDataSize + 2;
+
+    // Set the SysEx data size and return a pointer to the data to be filled, not including framing bytes
+    juce::uint8* prepare(int sysExDataSize)
+    {
+        jassert(sysExDataSize > 0 && sysExDataSize <= maxSysExDataSize);
+        rawSize = sysExDataSize + 2;
+        bytes[0] = 0xf0;
+        bytes[rawSize - 1] = 0xf7;
+        return bytes + 1;
+    }
+
+    // Marks the frame as having no message, for cancelling a frame that is already queued
+    void clear() { rawSize = 0; }
+    bool isEmpty() const { return rawSize == 0; }
+
+    const juce::uint8* getSysExData() const { return bytes + 1; }
+    int getSysExDataSize() const { return rawSize - 2; }
+
+    const juce::uint8* getRawData() const { return bytes; }
+    int getRawDataSize() const { return rawSize; }
+
+    // Only intended for the juce::MidiOutput boundary and diagnostics; SysEx messages allocate
+    juce::MidiMessage toMidiMessage() const { return juce::MidiMessage(bytes, rawSize); }
+
+    juce::uint8 bytes[maxRawSize];
+    int rawSize = 0;
+
+    // juce::Time::getMillisecondCounterHiRes() when the frame was queued, for queue wait metrics
+    double timeQueuedMs = 0.0;
+
+    // Intrusive link used by LumatoneSysExFramePool and LumatoneSysExFrameQueue
+    LumatoneSysExFrame* next = nullptr;
+};
+
+/*
+==============================================================================
+Recycling allocator for LumatoneSysExFrame.
+
+Frames are allocated in blocks and returned to a free list when released,
+so steady-state sending does not touch the heap. Not thread safe on its own.
+==============================================================================
+*/
+class LumatoneSysExFramePool
+{
+public:
+    static constexpr int framesPerBlock = 128;
+
+    LumatoneSysExFramePool(int numFramesToReserve=framesPerBlock);
+
+    LumatoneSysExFrame* acquire();
+    void release(LumatoneSysExFrame* frame);
+
+    int getNumFramesAllocated() const { return blocks.size() * framesPerBlock; }
+    int getNumFramesFree() const { return numFree; }
+
+private:
+    void allocateBlock();
+
+private:
+    struct Block
+    {
+        LumatoneSysExFrame frames[framesPerBlock];
+    };
+
+    juce::OwnedArray<Block> blocks;
+    LumatoneSysExFrame* freeList = nullptr;
+    int numFree = 0;
+
+    JUCE_DECLARE_NON_COPYABLE(LumatoneSysExFramePool)
+};
+
+/*
+==============================================================================
+Intrusive FIFO of pooled frames, O(1) push and pop. Not thread safe on its own.
+==============================================================================
+*/
+class LumatoneSysExFrameQueue
+{
+public:
+    void push(LumatoneSysExFrame* frame);
+    LumatoneSysExFrame* pop();
+
+    // Returns all queued frames to the pool
+    void clear(LumatoneSysExFramePool& pool);
+
+    bool isEmpty() const { return head == nullptr; }
+    int size() const { return numFrames; }
+
+private:
+    LumatoneSysExFrame* head = nullptr;
+    LumatoneSysExFrame* tail = nullptr;
+    int numFrames = 0;
+};
+
+#endif // LUMATONE_SYSEX_FRAME_H
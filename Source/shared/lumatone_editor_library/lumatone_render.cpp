@@ -32,6 +32,11 @@ juce::Array<juce::Point<float>> LumatoneRender::getKeyCentres()
     return tilingGeometry.getHexagonCentresSkewed(lumatoneGeometry, 0, state.getNumBoards());
 }
 
+juce::Array<juce::Point<int>> LumatoneRender::getKeyCoordinates()
+{
+    return tilingGeometry.getHexagonCoordinatesSkewed(lumatoneGeometry, 0, state.getNumBoards());
+}
+
 void LumatoneRender::render(LumatoneAssets::LumatoneGraphicRenderSize maxRenderSize)
 {
     int width = LumatoneAssets::LumatoneKeyboardRenderWidth(maxRenderSize);
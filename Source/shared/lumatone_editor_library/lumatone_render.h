@@ -18,6 +18,9 @@ public:
 
     juce::Array<juce::Point<float>> getKeyCentres();
 
+    // Tiling coordinates of each key, in the same order as the centres
+    juce::Array<juce::Point<int>> getKeyCoordinates();
+
     void render(LumatoneAssets::LumatoneGraphicRenderSize maxRenderSize=LumatoneAssets::LumatoneGraphicRenderSize::_4x);
     
     juce::Image getResizedRender(int targetWidth, int targetHeight);
@@ -83,6 +83,11 @@ juce::Array<juce::Point<float>> LumatoneTiling::getHexagonCentresSkewed(const Lu
 	return calculateCentresSkewed(boardGeometry, startingOctave, numOctavesIn);
 }
 
+juce::Array<juce::Point<int>> LumatoneTiling::getHexagonCoordinatesSkewed(const LumatoneGeometry& boardGeometry, int startingOctave, int numOctavesIn) const
+{
+	return calculateCoordinatesSkewed(boardGeometry, startingOctave, numOctavesIn);
+}
+
 float LumatoneTiling::getKeySize(bool scaled) const
 {
 	float keySize = (scaled) ? radius * rotationScalar * verticalScalar : (float)radius;
@@ -255,18 +260,35 @@ juce::Array<juce::Point<float>> LumatoneTiling::calculateCentresSkewed(const Lum
 {
 	juce::Array<juce::Point<float>> hexagonCentres;
 
+	const double colX = columnXComponent * horizontalScalar;
+	const double colY = columnYComponent * horizontalScalar;
+	const double rowX = rowXComponent    * verticalScalar;
+	const double rowY = rowYComponent    * verticalScalar;
+
+	for (auto coord : calculateCoordinatesSkewed(boardGeometry, startingOctave, numOctaves))
+	{
+		juce::Point<float> centre = startingCentre.toFloat() + juce::Point<float>(
+			coord.x * colX + coord.y * rowX,
+			coord.x * colY + coord.y * rowY
+		);
+
+		centre.applyTransform(transform);
+		hexagonCentres.add(centre);
+	}
+
+	return hexagonCentres;
+}
+
+juce::Array<juce::Point<int>> LumatoneTiling::calculateCoordinatesSkewed(const LumatoneGeometry& boardGeometry, int startingOctave, int numOctaves) const
+{
+	juce::Array<juce::Point<int>> hexagonCoordinates;
+
 	const int numColumnsInOctave = boardGeometry.getMaxHorizontalLineSize() ;
 	const int numRowsInOctave = boardGeometry.horizontalLineCount();
 
 	const int totalOctaves = abs(numOctaves - startingOctave);
-	const int maxRowLength = totalOctaves * numColumnsInOctave;
 	const int maxColumnLength = numRowsInOctave + BOARDROWOFFSET * (totalOctaves - 1);
 
-	const double colX = columnXComponent * horizontalScalar;
-	const double colY = columnYComponent * horizontalScalar;
-	const double rowX = rowXComponent    * verticalScalar;
-	const double rowY = rowYComponent    * verticalScalar;
-
 	int octaveColumnOffset = startingOctave * numColumnsInOctave;
 	int octaveRowOffset = startingOctave * BOARDROWOFFSET;
 
@@ -281,13 +303,7 @@ juce::Array<juce::Point<float>> LumatoneTiling::calculateCentresSkewed(const Lum
 
 			for (int col = colStart; col < colEnd; col++)
 			{
-				juce::Point<float> centre = startingCentre.toFloat() + juce::Point<float>(
-					col * colX + octaveRow * rowX,
-					col * colY + octaveRow * rowY
-				);
-
-				centre.applyTransform(transform);
-				hexagonCentres.add(centre);
+				hexagonCoordinates.add(juce::Point<int>(col, octaveRow));
 			}
 		}
 
@@ -295,9 +311,48 @@ juce::Array<juce::Point<float>> LumatoneTiling::calculateCentresSkewed(const Lum
 		octaveRowOffset += BOARDROWOFFSET;
 	}
 
-	return hexagonCentres;
+	return hexagonCoordinates;
 }
 
+juce::Point<int> LumatoneTiling::getSkewedHexagonAt(juce::Point<float> point) const
+{
+	const double colX = columnXComponent * horizontalScalar;
+	const double colY = columnYComponent * horizontalScalar;
+	const double rowX = rowXComponent    * verticalScalar;
+	const double rowY = rowYComponent    * verticalScalar;
+
+	const double determinant = colX * rowY - rowX * colY;
+	if (determinant == 0)
+		return juce::Point<int>();
+
+	juce::Point<double> fromStart = point.transformedBy(transform.inverted()).toDouble() - startingCentre;
+
+	const double column = (fromStart.x * rowY - fromStart.y * rowX) / determinant;
+	const double row    = (fromStart.y * colX - fromStart.x * colY) / determinant;
+
+	return roundToHexagon(column, row);
+}
+
+juce::Point<int> LumatoneTiling::roundToHexagon(double column, double row)
+{
+	const double third = -column - row;
+
+	int roundedColumn = juce::roundToInt(column);
+	int roundedRow    = juce::roundToInt(row);
+	int roundedThird  = juce::roundToInt(third);
+
+	const double columnError = std::abs(roundedColumn - column);
+	const double rowError    = std::abs(roundedRow - row);
+	const double thirdError  = std::abs(roundedThird - third);
+
+	// The coordinates have to sum to zero, so the one that rounded furthest is fixed from the others
+	if (columnError > rowError && columnError > thirdError)
+		roundedColumn = -roundedRow - roundedThird;
+	else if (rowError > thirdError)
+		roundedRow = -roundedColumn - roundedThird;
+
+	return juce::Point<int>(roundedColumn, roundedRow);
+}
 
 juce::Rectangle<float> LumatoneTiling::calculateSmallestBounds(int widestRowSize, int longestColumnSize) const
 {
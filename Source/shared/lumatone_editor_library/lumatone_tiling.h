@@ -108,6 +108,16 @@ public:
 
 	juce::Array<juce::Point<float>> getHexagonCentresSkewed(const LumatoneGeometry& boardGeometry, int startingOctave, int numOctavesIn) const;
 
+	/// <summary>
+	/// Returns the (column, row) coordinates of the skewed tiling, in the same order as getHexagonCentresSkewed
+	/// </summary>
+	juce::Array<juce::Point<int>> getHexagonCoordinatesSkewed(const LumatoneGeometry& boardGeometry, int startingOctave, int numOctavesIn) const;
+
+	/// <summary>
+	/// Inverts the skewed tiling to find the (column, row) coordinates of the hexagon containing a point
+	/// </summary>
+	juce::Point<int> getSkewedHexagonAt(juce::Point<float> point) const;
+
 	// I have a new model of this class in the TilingGeometry branch that is based on this function, but it happened to perform worse 
 	// in terms of rounding errors, so this is a quick-fix for implementing HexPalettes before I can officially clean this class up
 	juce::Array<juce::Point<float>> transformPointsFromOrigin(juce::Array<juce::Point<int>> hexagonalCoordinatesIn);
@@ -170,6 +180,11 @@ private:
 
 	juce::Array<juce::Point<float>> calculateCentresSkewed(const LumatoneGeometry& boardGeometry, int startingOctave = 0, int numOctaves = 1) const;
 
+	juce::Array<juce::Point<int>> calculateCoordinatesSkewed(const LumatoneGeometry& boardGeometry, int startingOctave = 0, int numOctaves = 1) const;
+
+	// Rounds fractional axial coordinates to the nearest hexagon, treating -column-row as the third cube axis
+	static juce::Point<int> roundToHexagon(double column, double row);
+
 	static int verticalToSlantOffset(int rowNum, int offsetIn);
 
 public:
@@ -0,0 +1,121 @@
+/*
+  ==============================================================================
+
+    frame_governor_tests.cpp
+    Created: 19 Oct 2026
+    Author:  Vincenzo
+
+  ==============================================================================
+*/
+
+#include "../shared/game/frame_governor.h"
+
+class LumatoneSandboxFrameGovernorTests : public juce::UnitTest
+{
+public:
+    LumatoneSandboxFrameGovernorTests() : juce::UnitTest("LumatoneSandboxFrameGovernor", "Games") {}
+
+    void runTest() override
+    {
+        beginTest("Measures the rate of a device that keeps up");
+        {
+            LumatoneSandboxFrameGovernor governor;
+            Device device;
+
+            run(governor, device, 5.0);
+
+            expectWithinAbsoluteError(governor.getMessageRate(), device.messagesPerSecond, device.messagesPerSecond * 0.1);
+            expectEquals(governor.getNumBackoffs(), 0);
+        }
+
+        beginTest("A timeout cuts the message rate and the update budget");
+        {
+            LumatoneSandboxFrameGovernor governor;
+            Device device;
+
+            run(governor, device, 5.0);
+            const double measuredRate = governor.getMessageRate();
+            const int measuredBudget = governor.getUpdateBudget();
+
+            device.stats.timeouts++;
+            run(governor, device, tickSeconds);
+
+            expectWithinAbsoluteError(governor.getMessageRate(), measuredRate * governor.getOptions().backoffFactor, 1.0e-9);
+            expectLessThan(governor.getUpdateBudget(), measuredBudget);
+            expectEquals(governor.getNumBackoffs(), 1);
+        }
+
+        beginTest("After busy answers the rate only climbs back additively");
+        {
+            LumatoneSandboxFrameGovernor governor;
+            Device device;
+
+            run(governor, device, 5.0);
+
+            device.stats.busyAnswers += 3;
+            run(governor, device, tickSeconds);
+            const double backedOffRate = governor.getMessageRate();
+
+            const double recoverySeconds = 2.0;
+            run(governor, device, recoverySeconds);
+
+            const double maxIncrease = governor.getOptions().maxRateIncreasePerSecond * recoverySeconds;
+            expectGreaterThan(governor.getMessageRate(), backedOffRate);
+            expectLessOrEqual(governor.getMessageRate(), backedOffRate + maxIncrease + 1.0e-6);
+            expectEquals(governor.getNumBackoffs(), 1);
+        }
+
+        beginTest("Repeated timeouts keep backing off");
+        {
+            LumatoneSandboxFrameGovernor governor;
+            Device device;
+
+            run(governor, device, 5.0);
+            const double measuredRate = governor.getMessageRate();
+
+            for (int i = 0; i < 4; i++)
+            {
+                device.stats.timeouts++;
+                run(governor, device, tickSeconds);
+            }
+
+            expectLessOrEqual(governor.getMessageRate(), measuredRate * std::pow(governor.getOptions().backoffFactor, 4) + 1.0e-9);
+            expectEquals(governor.getUpdateBudget(), governor.getOptions().minUpdatesPerFrame);
+            expectEquals(governor.getNumBackoffs(), 4);
+        }
+    }
+
+private:
+    static constexpr double fps = 60.0;
+    static constexpr double tickSeconds = 1.0 / fps;
+
+    // A device retiring messages at a fixed rate, with the queue held at the governor's target depth
+    struct Device
+    {
+        Device() { stats.queueSize = LumatoneSandboxFrameGovernor::Options().targetQueueDepth; }
+
+        LumatoneFirmware::SendStatistics stats;
+        double messagesPerSecond = 600.0;
+
+        double timeMs = 0;
+        double messagesDue = 0;
+    };
+
+    static void run(LumatoneSandboxFrameGovernor& governor, Device& device, double seconds)
+    {
+        const int numTicks = juce::jmax(1, juce::roundToInt(seconds * fps));
+        for (int tick = 0; tick < numTicks; tick++)
+        {
+            device.timeMs += tickSeconds * 1000.0;
+            device.messagesDue += device.messagesPerSecond * tickSeconds;
+
+            const auto numRetired = (juce::int64)device.messagesDue;
+            device.messagesDue -= (double)numRetired;
+            device.stats.messagesRetired += numRetired;
+
+            governor.update(device.stats, fps, device.timeMs);
+        }
+    }
+};
+
+static LumatoneSandboxFrameGovernorTests frameGovernorTests;
@@ -0,0 +1,133 @@
+/*
+  ==============================================================================
+
+    hexagon_automata_tests.cpp
+    Created: 19 Oct 2026
+    Author:  Vincenzo
+
+  ==============================================================================
+*/
+
+#include "../shared/game/hexagon_automata/hexagon_automata.h"
+#include "../shared/game/action_pool.h"
+
+#include "../shared/lumatone_editor_library/LumatoneController.h"
+#include "../shared/lumatone_editor_library/lumatone_midi_driver/lumatone_midi_driver.h"
+
+class HexagonAutomataKernelTests : public juce::UnitTest
+{
+public:
+    HexagonAutomataKernelTests() : juce::UnitTest("HexagonAutomataKernels", "Games") {}
+
+    void runTest() override
+    {
+        LumatoneFirmwareDriver driver(LumatoneFirmwareDriver::HostMode::Plugin);
+        LumatoneController controller(LumatoneApplicationState("HexagonAutomataKernelTests", juce::ValueTree(LumatoneStateProperty::StateTree)),
+                                      driver, nullptr);
+        LumatoneSandboxActionPool actionPool(&controller);
+
+        for (auto mode : { GenerationMode::Synchronous, GenerationMode::Asynchronous })
+        {
+            for (int distance : { 1, 2 })
+            {
+                beginTest(juce::String(mode == GenerationMode::Synchronous ? "Synchronous" : "Asynchronous")
+                          + " B2/S34 at distance " + juce::String(distance) + " steps the same on the kernel and the NeighborFunction");
+
+                HexagonAutomata::Game compiled(&controller);
+                compiled.setActionPool(&actionPool);
+                compiled.setBornSurviveRules({ 2 }, { 3, 4 });
+
+                HexagonAutomata::Game generic(&controller);
+                generic.setActionPool(&actionPool);
+                generic.setRules(new UnmaskedBornSurviveRule({ 2 }, { 3, 4 }));
+
+                for (auto game : { &compiled, &generic })
+                {
+                    game->setNeighborDistance(distance);
+                    game->setGenerationMode(mode);
+                    game->reset(true);
+                    releaseQueuedActions(*game, actionPool);
+                }
+
+                expect(compiled.hasCompiledKernel());
+                expect(!generic.hasCompiledKernel());
+
+                auto seeds = randomSeeds(compiled);
+                compiled.addSeeds(seeds, false);
+                generic.addSeeds(seeds, false);
+
+                for (int tick = 0; tick < numTicks; tick++)
+                {
+                    compiled.nextTick();
+                    generic.nextTick();
+                    releaseQueuedActions(compiled, actionPool);
+                    releaseQueuedActions(generic, actionPool);
+                }
+
+                expectSameCells(compiled, generic);
+            }
+        }
+    }
+
+private:
+    using GenerationMode = HexagonAutomata::GenerationMode;
+
+    static constexpr int numTicks = 200;
+
+    // The same rule without masks, so the game can't find a kernel for it
+    struct UnmaskedBornSurviveRule : public HexagonAutomata::BornSurviveRule
+    {
+        UnmaskedBornSurviveRule(juce::Array<int> bornNums, juce::Array<int> surviveNums)
+            : HexagonAutomata::BornSurviveRule(bornNums, surviveNums) {}
+
+        bool getBornSurviveMasks(HexagonAutomata::BornSurviveMasks&) const override { return false; }
+    };
+
+    juce::Array<Hex::Point> randomSeeds(const HexagonAutomata::Game& game)
+    {
+        auto random = getRandom();
+
+        juce::Array<Hex::Point> seeds;
+        for (int cellNum = 0; cellNum < game.getNumCells(); cellNum++)
+        {
+            if (random.nextInt(3) == 0)
+                seeds.add(game.getCellPoint(cellNum));
+        }
+
+        return seeds;
+    }
+
+    void expectSameCells(const HexagonAutomata::Game& compiled, const HexagonAutomata::Game& generic)
+    {
+        expectEquals(compiled.getNumCells(), generic.getNumCells());
+
+        int numAlive = 0;
+        for (int cellNum = 0; cellNum < compiled.getNumCells(); cellNum++)
+        {
+            const auto& expected = generic.getCellState(cellNum);
+            const auto& actual = compiled.getCellState(cellNum);
+            const juce::String cellName = "Cell " + juce::String(cellNum);
+
+            expectEquals(actual.isAlive(), expected.isAlive(), cellName);
+            if (expected.isAlive())
+            {
+                expectEquals(actual.age, expected.age, cellName);
+                numAlive++;
+            }
+        }
+
+        logMessage(juce::String(numAlive) + " cells alive after " + juce::String(numTicks) + " ticks");
+    }
+
+    static void releaseQueuedActions(LumatoneSandboxGameBase& game, LumatoneSandboxActionPool& actionPool)
+    {
+        LumatoneAction* actions[MAX_QUEUE_SIZE];
+        int numActions = 0;
+        game.readQueue(actions, numActions);
+
+        for (int i = 0; i < numActions; i++)
+            actionPool.release(actions[i]);
+    }
+};
+
+static HexagonAutomataKernelTests hexagonAutomataKernelTests;
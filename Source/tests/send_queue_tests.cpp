@@ -0,0 +1,135 @@
+/*
+  ==============================================================================
+
+    send_queue_tests.cpp
+    Created: 19 Oct 2026
+    Author:  Vincenzo
+
+  ==============================================================================
+*/
+
+#include "../shared/lumatone_editor_library/lumatone_midi_driver/send_queue.h"
+#include "../shared/lumatone_editor_library/lumatone_midi_driver/firmware_sysex.h"
+
+class LumatoneSendQueueTests : public juce::UnitTest
+{
+public:
+    LumatoneSendQueueTests() : juce::UnitTest("LumatoneSendQueue", "Firmware") {}
+
+    void runTest() override
+    {
+        beginTest("A newer bulk update isn't sent before an older interactive one");
+        {
+            LumatoneSysExFramePool pool;
+            LumatoneSendQueue queue(pool);
+            queue.setInteractiveWeight(1);
+
+            pushColour(pool, queue, SendPriority::Interactive, 1, 1);
+            pushColour(pool, queue, SendPriority::Interactive, 0, 2);
+            pushColour(pool, queue, SendPriority::Bulk, 0, 3);
+
+            // The bulk update is merged into the pending interactive one
+            expectEquals(queue.size(), 2);
+
+            Device device;
+            drain(pool, queue, device);
+            expectEquals(device.keyValues[0], 3);
+            expectEquals(device.keyValues[1], 1);
+            expectEquals(device.numFramesSent, 2);
+        }
+
+        beginTest("A newer interactive update cancels an older bulk one");
+        {
+            LumatoneSysExFramePool pool;
+            LumatoneSendQueue queue(pool);
+
+            pushColour(pool, queue, SendPriority::Bulk, 0, 1);
+            pushColour(pool, queue, SendPriority::Interactive, 0, 2);
+
+            expectEquals(queue.size(SendPriority::Bulk), 0);
+            expectEquals(queue.size(SendPriority::Interactive), 1);
+
+            Device device;
+            drain(pool, queue, device);
+            expectEquals(device.keyValues[0], 2);
+            expectEquals(device.numFramesSent, 1);
+        }
+
+        beginTest("Interleaved lanes end on the newest update of each key");
+        {
+            LumatoneSysExFramePool pool;
+            LumatoneSendQueue queue(pool);
+            queue.setInteractiveWeight(1);
+
+            auto random = getRandom();
+            int expected[numKeys];
+            std::fill(std::begin(expected), std::end(expected), -1);
+
+            Device device;
+            for (int step = 0; step < 5000; step++)
+            {
+                if (random.nextInt(10) < 7)
+                {
+                    const int keyIndex = random.nextInt(numKeys);
+                    const int value = step % 256;
+                    const auto lane = random.nextBool() ? SendPriority::Interactive : SendPriority::Bulk;
+                    pushColour(pool, queue, lane, keyIndex, value);
+                    expected[keyIndex] = value;
+                }
+                else if (auto frame = queue.pop())
+                {
+                    device.receive(*frame);
+                    pool.release(frame);
+                }
+            }
+
+            drain(pool, queue, device);
+
+            for (int keyIndex = 0; keyIndex < numKeys; keyIndex++)
+                expectEquals(device.keyValues[keyIndex], expected[keyIndex], "Key " + juce::String(keyIndex));
+        }
+    }
+
+private:
+    using SendPriority = LumatoneFirmware::SendPriority;
+
+    static constexpr int numKeys = 8;
+    static constexpr juce::uint8 boardId = 1;
+
+    // Key colours as the device ends up with them, from the red value of each frame
+    struct Device
+    {
+        Device() { std::fill(std::begin(keyValues), std::end(keyValues), -1); }
+
+        void receive(const LumatoneSysExFrame& frame)
+        {
+            auto sysExData = frame.getSysExData();
+            if (sysExData[CMD_ID] != SET_KEY_COLOUR || sysExData[BOARD_IND] != boardId)
+                return;
+
+            keyValues[sysExData[CMD_ID + 1]] = (sysExData[PAYLOAD_INIT] << 4) | sysExData[PAYLOAD_INIT + 1];
+            numFramesSent++;
+        }
+
+        int keyValues[numKeys];
+        int numFramesSent = 0;
+    };
+
+    static void pushColour(LumatoneSysExFramePool& pool, LumatoneSendQueue& queue, SendPriority lane, int keyIndex, int value)
+    {
+        auto frame = pool.acquire();
+        LumatoneSysEx::fillExtendedKeyColourSysEx(*frame, boardId, SET_KEY_COLOUR, (juce::uint8)keyIndex, value, 0, 0);
+        queue.push(frame, lane);
+    }
+
+    static void drain(LumatoneSysExFramePool& pool, LumatoneSendQueue& queue, Device& device)
+    {
+        while (auto frame = queue.pop())
+        {
+            device.receive(*frame);
+            pool.release(frame);
+        }
+    }
+};
+
+static LumatoneSendQueueTests sendQueueTests;